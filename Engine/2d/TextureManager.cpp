@@ -235,6 +235,11 @@ D3D12_GPU_DESCRIPTOR_HANDLE TextureManager::GetSrvHandleGPU(const std::string fi
 	return it->second.srvHandleGPU;
 }
 
+D3D12_GPU_DESCRIPTOR_HANDLE TextureManager::LoadTextureHandle(const std::string& filePath) {
+	LoadTexture(filePath);
+	return GetSrvHandleGPU(filePath);
+}
+
 const DirectX::TexMetadata& TextureManager::GetMetaData(const std::string filePath) {
 	assert(srvManager->Max());
 
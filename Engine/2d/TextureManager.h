@@ -33,6 +33,9 @@ public:
 
 	D3D12_GPU_DESCRIPTOR_HANDLE GetSrvHandleGPU(const std::string filePath);
 
+	// 読み込んでGPUハンドルを返す(描画中に文字列で引かないよう、初期化時に取っておく)
+	D3D12_GPU_DESCRIPTOR_HANDLE LoadTextureHandle(const std::string& filePath);
+
 	// 存在チェック用
 	bool CheckTextureExist(const std::string& filePath);
 
@@ -0,0 +1,255 @@
+#include "MeshUtility.h"
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+	// 頂点をビット列として比較する
+	struct VertexHash {
+		size_t operator()(const VertexData& vertex) const {
+			// FNV-1a
+			const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&vertex);
+			uint64_t hash = 14695981039346656037ull;
+			for (size_t i = 0; i < sizeof(VertexData); ++i) {
+				hash ^= bytes[i];
+				hash *= 1099511628211ull;
+			}
+			return static_cast<size_t>(hash);
+		}
+	};
+
+	struct VertexEqual {
+		bool operator()(const VertexData& a, const VertexData& b) const {
+			return std::memcmp(&a, &b, sizeof(VertexData)) == 0;
+		}
+	};
+
+	// Forsythの頂点キャッシュ最適化のパラメータ
+	const int32_t kCacheSize = 32;
+	const float kCacheDecayPower = 1.5f;
+	const float kLastTriangleScore = 0.75f;
+	const float kValenceBoostScale = 2.0f;
+	const float kValenceBoostPower = 0.5f;
+
+	float ComputeVertexScore(int32_t cachePosition, uint32_t remainingTriangles) {
+		// もう使われない頂点
+		if (remainingTriangles == 0) {
+			return -1.0f;
+		}
+
+		float score = 0.0f;
+		if (cachePosition >= 0) {
+			if (cachePosition < 3) {
+				// 直前の三角形の頂点は少し下げる
+				score = kLastTriangleScore;
+			}
+			else {
+				float scale = 1.0f / static_cast<float>(kCacheSize - 3);
+				score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scale, kCacheDecayPower);
+			}
+		}
+
+		// 残りの三角形が少ない頂点を優先して使い切る
+		score += kValenceBoostScale * std::pow(static_cast<float>(remainingTriangles), -kValenceBoostPower);
+		return score;
+	}
+}
+
+namespace MeshUtility {
+	void WeldVertices(ModelData& modelData) {
+		if (!modelData.indices.empty()) {
+			return;
+		}
+
+		std::vector<VertexData> vertices;
+		std::vector<uint32_t> indices;
+		vertices.reserve(modelData.vertices.size());
+		indices.reserve(modelData.vertices.size());
+
+		std::unordered_map<VertexData, uint32_t, VertexHash, VertexEqual> lookup;
+		lookup.reserve(modelData.vertices.size());
+		for (const VertexData& vertex : modelData.vertices) {
+			auto result = lookup.try_emplace(vertex, static_cast<uint32_t>(vertices.size()));
+			if (result.second) {
+				vertices.push_back(vertex);
+			}
+			indices.push_back(result.first->second);
+		}
+
+		vertices.shrink_to_fit();
+		modelData.vertices.swap(vertices);
+		modelData.indices.swap(indices);
+	}
+
+	void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) {
+		const size_t triangleCount = indices.size() / 3;
+		if (triangleCount == 0) {
+			return;
+		}
+
+		// 頂点ごとに使っている三角形の一覧(adjacencyStart[v]から残りremaining[v]個が未出力)
+		std::vector<uint32_t> remaining(vertexCount, 0);
+		for (size_t i = 0; i < triangleCount * 3; ++i) {
+			remaining[indices[i]]++;
+		}
+		std::vector<uint32_t> adjacencyStart(vertexCount + 1, 0);
+		for (size_t v = 0; v < vertexCount; ++v) {
+			adjacencyStart[v + 1] = adjacencyStart[v] + remaining[v];
+		}
+		std::vector<uint32_t> adjacency(adjacencyStart.back());
+		{
+			std::vector<uint32_t> cursor(adjacencyStart.begin(), adjacencyStart.end() - 1);
+			for (size_t i = 0; i < triangleCount * 3; ++i) {
+				adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+			}
+		}
+
+		std::vector<int32_t> cachePosition(vertexCount, -1);
+		std::vector<float> vertexScore(vertexCount);
+		for (size_t v = 0; v < vertexCount; ++v) {
+			vertexScore[v] = ComputeVertexScore(-1, remaining[v]);
+		}
+
+		std::vector<float> triangleScore(triangleCount);
+		std::vector<bool> emitted(triangleCount, false);
+		int64_t best = -1;
+		float bestScore = -1.0f;
+		for (size_t t = 0; t < triangleCount; ++t) {
+			const uint32_t* v = &indices[t * 3];
+			triangleScore[t] = vertexScore[v[0]] + vertexScore[v[1]] + vertexScore[v[2]];
+			if (triangleScore[t] > bestScore) {
+				bestScore = triangleScore[t];
+				best = static_cast<int64_t>(t);
+			}
+		}
+
+		std::vector<uint32_t> output;
+		output.reserve(triangleCount * 3);
+		uint32_t cache[kCacheSize + 3];
+		int32_t cacheCount = 0;
+		size_t scanCursor = 0;
+
+		for (size_t n = 0; n < triangleCount; ++n) {
+			// キャッシュ周辺に候補がなければ未出力の三角形から続ける
+			if (best < 0) {
+				while (emitted[scanCursor]) {
+					scanCursor++;
+				}
+				best = static_cast<int64_t>(scanCursor);
+			}
+
+			const uint32_t triangle = static_cast<uint32_t>(best);
+			const uint32_t* v = &indices[triangle * 3];
+			emitted[triangle] = true;
+			output.push_back(v[0]);
+			output.push_back(v[1]);
+			output.push_back(v[2]);
+
+			// 出力した三角形を頂点の一覧から外す
+			for (int32_t k = 0; k < 3; ++k) {
+				uint32_t vertex = v[k];
+				uint32_t* list = &adjacency[adjacencyStart[vertex]];
+				for (uint32_t i = 0; i < remaining[vertex]; ++i) {
+					if (list[i] == triangle) {
+						list[i] = list[remaining[vertex] - 1];
+						remaining[vertex]--;
+						break;
+					}
+				}
+			}
+
+			// 三角形の頂点をキャッシュの先頭に入れる
+			uint32_t newCache[kCacheSize + 3];
+			int32_t newCount = 0;
+			for (int32_t k = 0; k < 3; ++k) {
+				bool found = false;
+				for (int32_t i = 0; i < newCount; ++i) {
+					found |= (newCache[i] == v[k]);
+				}
+				if (!found) {
+					newCache[newCount++] = v[k];
+				}
+			}
+			for (int32_t i = 0; i < cacheCount; ++i) {
+				uint32_t vertex = cache[i];
+				if (vertex != v[0] && vertex != v[1] && vertex != v[2]) {
+					newCache[newCount++] = vertex;
+				}
+			}
+
+			// キャッシュから押し出された頂点も含めてスコアを更新
+			for (int32_t i = 0; i < newCount; ++i) {
+				uint32_t vertex = newCache[i];
+				cachePosition[vertex] = (i < kCacheSize) ? i : -1;
+				vertexScore[vertex] = ComputeVertexScore(cachePosition[vertex], remaining[vertex]);
+			}
+
+			best = -1;
+			bestScore = -1.0f;
+			for (int32_t i = 0; i < newCount; ++i) {
+				uint32_t vertex = newCache[i];
+				const uint32_t* list = &adjacency[adjacencyStart[vertex]];
+				for (uint32_t j = 0; j < remaining[vertex]; ++j) {
+					uint32_t t = list[j];
+					const uint32_t* tv = &indices[t * 3];
+					triangleScore[t] = vertexScore[tv[0]] + vertexScore[tv[1]] + vertexScore[tv[2]];
+					if (triangleScore[t] > bestScore) {
+						bestScore = triangleScore[t];
+						best = static_cast<int64_t>(t);
+					}
+				}
+			}
+
+			cacheCount = (newCount < kCacheSize) ? newCount : kCacheSize;
+			std::memcpy(cache, newCache, sizeof(uint32_t) * cacheCount);
+		}
+
+		indices.swap(output);
+	}
+
+	void OptimizeVertexFetch(ModelData& modelData) {
+		const uint32_t kUnused = 0xffffffffu;
+		std::vector<uint32_t> remap(modelData.vertices.size(), kUnused);
+		std::vector<VertexData> vertices;
+		vertices.reserve(modelData.vertices.size());
+
+		for (uint32_t& index : modelData.indices) {
+			if (remap[index] == kUnused) {
+				remap[index] = static_cast<uint32_t>(vertices.size());
+				vertices.push_back(modelData.vertices[index]);
+			}
+			index = remap[index];
+		}
+
+		modelData.vertices.swap(vertices);
+	}
+
+	void BuildIndexedMesh(ModelData& modelData) {
+		WeldVertices(modelData);
+		OptimizeVertexCache(modelData.indices, modelData.vertices.size());
+		OptimizeVertexFetch(modelData);
+	}
+
+	size_t GetMeshBytes(const ModelData& modelData) {
+		return sizeof(VertexData) * modelData.vertices.size() + sizeof(uint32_t) * modelData.indices.size();
+	}
+
+	float ComputeACMR(const std::vector<uint32_t>& indices, size_t vertexCount) {
+		if (indices.size() < 3) {
+			return 0.0f;
+		}
+
+		// FIFOキャッシュで頂点シェーダーが走る回数を数える
+		const size_t kFifoSize = 32;
+		std::vector<size_t> cachedAt(vertexCount, 0);
+		size_t timestamp = kFifoSize + 1;
+		size_t misses = 0;
+		for (uint32_t index : indices) {
+			if (timestamp - cachedAt[index] > kFifoSize) {
+				cachedAt[index] = timestamp++;
+				misses++;
+			}
+		}
+		return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+	}
+}
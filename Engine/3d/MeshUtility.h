@@ -0,0 +1,26 @@
+#pragma once
+#include "MyMath.h"
+#include <cstdint>
+#include <vector>
+
+// メッシュの頂点・インデックスの加工
+namespace MeshUtility {
+	// 位置・UV・法線がすべて同じ頂点をまとめてインデックスを作る
+	// すでにインデックスがあるときは何もしない
+	void WeldVertices(ModelData& modelData);
+
+	// 頂点キャッシュに乗りやすいように三角形の順番を並べ替える(Forsyth)
+	void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+
+	// 頂点をインデックスで最初に使われる順に並べ替える
+	void OptimizeVertexFetch(ModelData& modelData);
+
+	// 上の3つをまとめて行う
+	void BuildIndexedMesh(ModelData& modelData);
+
+	// GPUに置く頂点・インデックスのバイト数
+	size_t GetMeshBytes(const ModelData& modelData);
+
+	// 三角形1つあたりの頂点シェーダー実行回数(キャッシュ32で計算)
+	float ComputeACMR(const std::vector<uint32_t>& indices, size_t vertexCount);
+}
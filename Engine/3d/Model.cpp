@@ -1,16 +1,29 @@
 #include "Model.h"
 #include "TextureManager.h"
-#include <fstream>
-#include <sstream>
+#include "ObjLoader.h"
+#include "MeshUtility.h"
+#include "ModelBinary.h"
+#include "Logger.h"
 
 using namespace MyMath;
 
 void Model::Initialize(ModelCommon* modelCommon, const std::string& directorypath, const std::string& fileName) {
 	this->modelCommon = modelCommon;
 
-	modelData = LoadObjFile(directorypath, fileName);
+	//変換済みのモデルがあればOBJを読まない
+	if (!ModelBinary::Load(directorypath, fileName, modelData)) {
+		modelData = LoadObjFile(directorypath, fileName);
 
-	InitialData = modelData;
+		//同じ頂点をまとめてインデックス化
+		size_t rawBytes = MeshUtility::GetMeshBytes(modelData);
+		MeshUtility::BuildIndexedMesh(modelData);
+		Logger::log("Model: " + fileName + " " + std::to_string(rawBytes) + " -> " +
+			std::to_string(MeshUtility::GetMeshBytes(modelData)) + " bytes (" + std::to_string(modelData.vertices.size()) + " vertices, " +
+			std::to_string(modelData.indices.size()) + " indices)\n");
+
+		//次回用に保存
+		ModelBinary::Save(directorypath, fileName, modelData);
+	}
 
 	vertexResource = modelCommon->GetDxCommon()->CreateBufferResource(sizeof(VertexData) * modelData.vertices.size());
 
@@ -21,6 +34,19 @@ void Model::Initialize(ModelCommon* modelCommon, const std::string& directorypat
 	vertexResource->Map(0, nullptr, reinterpret_cast<void**>(&vertexData));
 	std::memcpy(vertexData, modelData.vertices.data(), sizeof(VertexData) * modelData.vertices.size());
 
+	//インデックス
+	if (!modelData.indices.empty()) {
+		indexResource = modelCommon->GetDxCommon()->CreateBufferResource(sizeof(uint32_t) * modelData.indices.size());
+
+		indexBufferView.BufferLocation = indexResource->GetGPUVirtualAddress();
+		indexBufferView.SizeInBytes = UINT(sizeof(uint32_t) * modelData.indices.size());
+		indexBufferView.Format = DXGI_FORMAT_R32_UINT;
+
+		uint32_t* indexData = nullptr;
+		indexResource->Map(0, nullptr, reinterpret_cast<void**>(&indexData));
+		std::memcpy(indexData, modelData.indices.data(), sizeof(uint32_t) * modelData.indices.size());
+	}
+
 
 	//Model用マテリアル
 	//マテリアル用のリソース
@@ -35,141 +61,47 @@ void Model::Initialize(ModelCommon* modelCommon, const std::string& directorypat
 	//テクスチャ読み込み
 	TextureManager::GetInstance()->LoadTexture(modelData.material.textureFilePath);
 	modelData.material.textureIndex = TextureManager::GetInstance()->GetSrvIndex(modelData.material.textureFilePath);
+	textureHandle = TextureManager::GetInstance()->GetSrvHandleGPU(modelData.material.textureFilePath);
 }
 
 void Model::Draw() {
 	//objファイルに元々あったテクスチャ
-	modelData = InitialData;
+	Draw(textureHandle);
+}
 
+void Model::Draw(D3D12_GPU_DESCRIPTOR_HANDLE srvHandle) {
 	modelCommon->GetDxCommon()->GetCommandList()->IASetVertexBuffers(0, 1, &vertexBufferView);
 	modelCommon->GetDxCommon()->GetCommandList()->SetGraphicsRootConstantBufferView(0, materialResource->GetGPUVirtualAddress()); //rootParameterの配列の0番目 [0]
-	modelCommon->GetDxCommon()->GetCommandList()->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetSrvHandleGPU(modelData.material.textureFilePath));
-	modelCommon->GetDxCommon()->GetCommandList()->DrawInstanced(UINT(modelData.vertices.size()), 1, 0, 0);
+	modelCommon->GetDxCommon()->GetCommandList()->SetGraphicsRootDescriptorTable(2, srvHandle);
+	DrawMesh();
 
 }
 
-void Model::Draw(const std::string& textureFilePath) {
-
-	TextureManager::GetInstance()->LoadTexture(textureFilePath);
-	modelData.material.textureFilePath = textureFilePath;
-	modelData.material.textureIndex = TextureManager::GetInstance()->GetSrvIndex(textureFilePath);
-	
-
-	modelCommon->GetDxCommon()->GetCommandList()->IASetVertexBuffers(0, 1, &vertexBufferView);
-	modelCommon->GetDxCommon()->GetCommandList()->SetGraphicsRootConstantBufferView(0, materialResource->GetGPUVirtualAddress()); //rootParameterの配列の0番目 [0]
-	modelCommon->GetDxCommon()->GetCommandList()->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetSrvHandleGPU(modelData.material.textureFilePath));
-	modelCommon->GetDxCommon()->GetCommandList()->DrawInstanced(UINT(modelData.vertices.size()), 1, 0, 0);
 
+void Model::DrawMesh() {
+	ID3D12GraphicsCommandList* commandList = modelCommon->GetDxCommon()->GetCommandList();
+	if (modelData.indices.empty()) {
+		commandList->DrawInstanced(UINT(modelData.vertices.size()), 1, 0, 0);
+	}
+	else {
+		commandList->IASetIndexBuffer(&indexBufferView);
+		commandList->DrawIndexedInstanced(UINT(modelData.indices.size()), 1, 0, 0, 0);
+	}
 }
 
-
 MaterialData Model::LoadMaterialTemplateFile(const std::string& directoryPath, const std::string& filename) {
 	MaterialData materialData;
-	std::string line;
-	std::ifstream file(directoryPath + "/Object/" + filename);
-	assert(file.is_open());
-
-	//ファイルを開く
-	while (std::getline(file, line)) {
-		std::string identifier;
-		std::istringstream s(line);
-		s >> identifier;
-
-		if (identifier == "map_Kd") {
-			std::string textureFilename;
-			s >> textureFilename;
-
-			materialData.textureFilePath = directoryPath + "/Sprite/" + textureFilename;
-		}
-	}
+	bool isLoaded = ObjLoader::LoadMaterialFile(directoryPath, filename, materialData);
+	assert(isLoaded);
+	(void)isLoaded;
 	return materialData;
-};
+}
 
 
 ModelData Model::LoadObjFile(const std::string& directoryPath, const std::string& filename) {
 	ModelData modelData;
-
-	//VertexData
-	std::vector<Vector4> positions;
-	std::vector<Vector3> normals;
-	std::vector<Vector2> texcoords;
-	//ファイルから読んだ1行を格納する
-	std::string line;
-	//ファイルを読み取る
-	std::ifstream file(directoryPath + "/Object/" + filename + "/" + filename + ".obj");
-	assert(file.is_open());
-
-	//構築
-	while (std::getline(file, line)) {
-		std::string identifier;
-		std::istringstream s(line);
-		s >> identifier; //先頭の義別子 (v ,vt, vn, f) を読み取る
-
-		//modeldataの建築
-		if (identifier == "v") {
-			Vector4 position;
-			s >> position.x >> position.y >> position.z;//左から順に消費 = 飛ばしたり、もう一度使うことはできない	
-			position.s = 1.0f;
-
-			//反転
-			position.x *= -1.0f;
-			positions.push_back(position);
-		}
-		else if (identifier == "vt") {
-			Vector2 texcoord;
-			s >> texcoord.x >> texcoord.y;
-
-			//原点変更
-			texcoord.y = 1.0f - texcoord.y;
-
-			texcoords.push_back(texcoord);
-		}
-		else if (identifier == "vn") {
-			Vector3 normal;
-			s >> normal.x >> normal.y >> normal.z;
-
-			//反転
-			normal.x *= -1.0f;
-			normals.push_back(normal);
-		}
-		else if (identifier == "f") {
-			VertexData triangle[3];
-
-			for (int32_t faceVertex = 0; faceVertex < 3; ++faceVertex) {
-				std::string vertexDefinition;
-				s >> vertexDefinition;
-
-				std::istringstream v(vertexDefinition);
-				uint32_t elementIndices[3];
-				for (int32_t element = 0; element < 3; ++element) {
-					std::string index;
-					std::getline(v, index, '/'); //  "/"でインデックスを区切る
-					elementIndices[element] = std::stoi(index);
-
-				}
-
-
-				Vector4 position = positions[elementIndices[0] - 1];
-				Vector2 texcoord = texcoords[elementIndices[1] - 1];
-				Vector3 normal = normals[elementIndices[2] - 1];
-				//VertexData vertex = { position,texcoord,normal };
-				//modelData.vertices.push_back(vertex);
-
-				triangle[faceVertex] = { position,texcoord,normal };
-
-			}
-			modelData.vertices.push_back(triangle[2]);
-			modelData.vertices.push_back(triangle[1]);
-			modelData.vertices.push_back(triangle[0]);
-		}
-		else if (identifier == "mtllib") {
-			std::string materialFilename;
-
-			s >> materialFilename;
-			modelData.material = LoadMaterialTemplateFile(directoryPath,filename + "/" + materialFilename );
-
-		}
-	}
-
+	bool isLoaded = ObjLoader::LoadFile(directoryPath, filename, modelData);
+	assert(isLoaded);
+	(void)isLoaded;
 	return modelData;
 }
\ No newline at end of file
@@ -8,16 +8,24 @@ public:
 	void Initialize(ModelCommon* modelCommon,const std::string& directorypath,const std::string& fileName);
 
 	void Draw();
-	void Draw(const std::string& textureFilePath);
+	// テクスチャだけ差し替えて描画する(ハンドルはTextureManager::LoadTextureHandleで取っておく)
+	void Draw(D3D12_GPU_DESCRIPTOR_HANDLE srvHandle);
 
 	static MaterialData LoadMaterialTemplateFile(const std::string& directoryPath, const std::string& filename);
 	static ModelData LoadObjFile(const std::string& directoryPath, const std::string& filename);
 	
 	void LightOn(bool Light) { materialData->enableLighting = Light; }
 
+	// objファイルに元々あったテクスチャ
+	D3D12_GPU_DESCRIPTOR_HANDLE GetTextureHandle() const { return textureHandle; }
+
 private:
+	// 頂点(とインデックス)を積んで描画する
+	void DrawMesh();
+
 	ModelCommon* modelCommon = nullptr;
 
+	// 読み込み後は変更しない
 	ModelData modelData;
 
 	Microsoft::WRL::ComPtr<ID3D12Resource> vertexResource;
@@ -29,5 +37,8 @@ private:
 
 	D3D12_VERTEX_BUFFER_VIEW vertexBufferView;
 
-	ModelData InitialData;
+	Microsoft::WRL::ComPtr<ID3D12Resource> indexResource;
+	D3D12_INDEX_BUFFER_VIEW indexBufferView{};
+
+	D3D12_GPU_DESCRIPTOR_HANDLE textureHandle{};
 };
\ No newline at end of file
@@ -0,0 +1,197 @@
+#include "ModelBinary.h"
+#include "ObjLoader.h"
+#include "MeshUtility.h"
+#include "MappedFile.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+#include <vector>
+
+static_assert(std::is_trivially_copyable_v<VertexData>, "VertexDataはそのままファイルに書き出す");
+static_assert(sizeof(ModelBinary::Header) == 40, "ヘッダーのサイズが変わると.mdlが読めなくなる");
+
+namespace {
+	// モデルフォルダ内の.obj/.mtlの合計サイズとハッシュ
+	bool GetSourceStamp(const std::string& directoryPath, const std::string& filename, uint64_t& size, uint64_t& hash) {
+		namespace fs = std::filesystem;
+		std::error_code ec;
+		std::vector<fs::path> sourcePaths;
+		for (const fs::directory_entry& entry : fs::directory_iterator(directoryPath + "/Object/" + filename, ec)) {
+			const fs::path& path = entry.path();
+			if (entry.is_regular_file() && (path.extension() == ".obj" || path.extension() == ".mtl")) {
+				sourcePaths.push_back(path);
+			}
+		}
+		if (ec) {
+			return false;
+		}
+		// 列挙の順番は決まっていないのでファイル名順にする
+		std::sort(sourcePaths.begin(), sourcePaths.end());
+
+		size = 0;
+		hash = 14695981039346656037ull;
+		bool foundObj = false;
+		for (const fs::path& path : sourcePaths) {
+			MappedFile file;
+			if (!file.Open(path.string())) {
+				return false;
+			}
+			foundObj |= (path.extension() == ".obj");
+			size += file.GetSize();
+
+			// FNV-1a 64bit
+			const uint8_t* bytes = file.GetData();
+			for (size_t i = 0; i < file.GetSize(); ++i) {
+				hash ^= bytes[i];
+				hash *= 1099511628211ull;
+			}
+		}
+		return foundObj;
+	}
+}
+
+namespace ModelBinary {
+	std::string GetBinaryPath(const std::string& directoryPath, const std::string& filename) {
+		return directoryPath + "/Object/" + filename + "/" + filename + ".mdl";
+	}
+
+	bool Load(const std::string& directoryPath, const std::string& filename, ModelData& modelData) {
+		uint64_t sourceSize;
+		uint64_t sourceHash;
+		if (!GetSourceStamp(directoryPath, filename, sourceSize, sourceHash)) {
+			return false;
+		}
+
+		MappedFile file;
+		if (!file.Open(GetBinaryPath(directoryPath, filename)) || file.GetSize() < sizeof(Header)) {
+			return false;
+		}
+
+		Header header;
+		std::memcpy(&header, file.GetData(), sizeof(Header));
+		if (header.magic != kMagic || header.version != kVersion) {
+			return false;
+		}
+		// OBJかMTLの中身が変わっていたら作り直す
+		if (header.sourceSize != sourceSize || header.sourceHash != sourceHash) {
+			return false;
+		}
+
+		size_t vertexBytes = sizeof(VertexData) * header.vertexCount;
+		size_t indexBytes = sizeof(uint32_t) * header.indexCount;
+		if (file.GetSize() != sizeof(Header) + vertexBytes + indexBytes + header.pathBytes) {
+			return false;
+		}
+
+		const uint8_t* p = file.GetData() + sizeof(Header);
+		modelData.vertices.resize(header.vertexCount);
+		std::memcpy(modelData.vertices.data(), p, vertexBytes);
+		p += vertexBytes;
+
+		modelData.indices.resize(header.indexCount);
+		std::memcpy(modelData.indices.data(), p, indexBytes);
+		p += indexBytes;
+
+		// パス表(今はテクスチャ1枚だけ)
+		const uint8_t* pathEnd = p + header.pathBytes;
+		modelData.material = {};
+		for (uint32_t i = 0; i < header.pathCount; ++i) {
+			uint32_t length;
+			if (pathEnd - p < static_cast<ptrdiff_t>(sizeof(uint32_t))) {
+				return false;
+			}
+			std::memcpy(&length, p, sizeof(uint32_t));
+			p += sizeof(uint32_t);
+			if (static_cast<size_t>(pathEnd - p) < length) {
+				return false;
+			}
+			if (i == 0) {
+				modelData.material.textureFilePath.assign(reinterpret_cast<const char*>(p), length);
+			}
+			p += length;
+		}
+
+		// 頂点の範囲外を指すインデックスがあれば読み直す
+		for (uint32_t index : modelData.indices) {
+			if (index >= header.vertexCount) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool Save(const std::string& directoryPath, const std::string& filename, const ModelData& modelData) {
+		Header header{};
+		header.magic = kMagic;
+		header.version = kVersion;
+		if (!GetSourceStamp(directoryPath, filename, header.sourceSize, header.sourceHash)) {
+			return false;
+		}
+
+		const std::string& texturePath = modelData.material.textureFilePath;
+		uint32_t textureLength = static_cast<uint32_t>(texturePath.size());
+		header.vertexCount = static_cast<uint32_t>(modelData.vertices.size());
+		header.indexCount = static_cast<uint32_t>(modelData.indices.size());
+		header.pathCount = 1;
+		header.pathBytes = static_cast<uint32_t>(sizeof(uint32_t) + textureLength);
+
+		std::string binaryPath = GetBinaryPath(directoryPath, filename);
+		std::ofstream file(binaryPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			return false;
+		}
+		file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+		file.write(reinterpret_cast<const char*>(modelData.vertices.data()), sizeof(VertexData) * modelData.vertices.size());
+		file.write(reinterpret_cast<const char*>(modelData.indices.data()), sizeof(uint32_t) * modelData.indices.size());
+		file.write(reinterpret_cast<const char*>(&textureLength), sizeof(uint32_t));
+		file.write(texturePath.data(), textureLength);
+		file.close();
+
+		// 書き込みに失敗した半端なファイルは残さない
+		if (file.fail()) {
+			std::error_code ec;
+			std::filesystem::remove(binaryPath, ec);
+			return false;
+		}
+		return true;
+	}
+
+	bool Bake(const std::string& directoryPath, const std::string& filename) {
+		ModelData modelData;
+		if (!ObjLoader::LoadFile(directoryPath, filename, modelData)) {
+			return false;
+		}
+		MeshUtility::BuildIndexedMesh(modelData);
+		return Save(directoryPath, filename, modelData);
+	}
+
+	bool BakeDirectory(const std::string& directoryPath, int& bakedCount) {
+		namespace fs = std::filesystem;
+		bakedCount = 0;
+		bool isSucceeded = true;
+
+		std::error_code ec;
+		for (const fs::directory_entry& entry : fs::directory_iterator(directoryPath + "/Object", ec)) {
+			if (!entry.is_directory()) {
+				continue;
+			}
+			// name/name.objの形のフォルダだけ
+			std::string filename = entry.path().filename().string();
+			if (!fs::exists(entry.path() / (filename + ".obj"))) {
+				continue;
+			}
+
+			if (Bake(directoryPath, filename)) {
+				bakedCount++;
+			}
+			else {
+				Logger::log("ModelBinary: failed to bake " + filename + "\n");
+				isSucceeded = false;
+			}
+		}
+		return isSucceeded && !ec;
+	}
+}
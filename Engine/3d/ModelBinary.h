@@ -0,0 +1,44 @@
+#pragma once
+#include "MyMath.h"
+#include <cstdint>
+#include <string>
+
+// 変換済みモデル(.mdl)の読み書き
+// resource/Object/name/name.objの隣にname.mdlを置く。中身はそのままGPUに積める形
+// (更新時刻はチェックアウトやコピーで変わらないことがあるので、.obj/.mtlのバイト列のハッシュで比べる)
+//   Header
+//   VertexData × vertexCount
+//   uint32_t × indexCount
+//   マテリアルのパス表(uint32_t 長さ + 文字列) × pathCount
+namespace ModelBinary {
+	struct Header {
+		uint32_t magic;          // 'MDLB'
+		uint32_t version;
+		uint64_t sourceSize;     // フォルダ内の.obj/.mtlの合計サイズ
+		uint64_t sourceHash;     // フォルダ内の.obj/.mtlのハッシュ(ファイル名順につなげてFNV-1a 64bit)
+		uint32_t vertexCount;
+		uint32_t indexCount;
+		uint32_t pathCount;
+		uint32_t pathBytes;      // パス表のバイト数
+	};
+
+	const uint32_t kMagic = 0x424C444D; // "MDLB"
+	// 形式か頂点の作り方(反転・インデックス化)を変えたら上げる
+	const uint32_t kVersion = 2;
+
+	// directoryPath/Object/filename/filename.mdl
+	std::string GetBinaryPath(const std::string& directoryPath, const std::string& filename);
+
+	// 変換済みモデルを読み込む(無いか元のOBJ/MTLと中身が違えばfalse)
+	bool Load(const std::string& directoryPath, const std::string& filename, ModelData& modelData);
+
+	// 変換済みモデルを書き出す
+	bool Save(const std::string& directoryPath, const std::string& filename, const ModelData& modelData);
+
+	// OBJを読み込んでインデックス化し、.mdlを書き出す
+	bool Bake(const std::string& directoryPath, const std::string& filename);
+
+	// directoryPath/Object以下の全モデルを変換する
+	// 変換した数をbakedCountに返す。フォルダが読めないか1つでも失敗したらfalse
+	bool BakeDirectory(const std::string& directoryPath, int& bakedCount);
+}
@@ -0,0 +1,172 @@
+#include "ObjLoader.h"
+#include "MappedFile.h"
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace {
+	bool IsSpace(char c) {
+		return c == ' ' || c == '\t' || c == '\r';
+	}
+
+	const char* SkipSpace(const char* p, const char* end) {
+		while (p < end && IsSpace(*p)) {
+			++p;
+		}
+		return p;
+	}
+
+	const char* SkipToken(const char* p, const char* end) {
+		while (p < end && !IsSpace(*p)) {
+			++p;
+		}
+		return p;
+	}
+
+	// 空白に続く実数を読む(読めなければ0のまま)
+	const char* ReadFloat(const char* p, const char* end, float& value) {
+		p = SkipSpace(p, end);
+		value = 0.0f;
+		auto result = std::from_chars(p, end, value);
+		return result.ptr;
+	}
+
+	// "v/vt/vn"を読む。省略された要素は0
+	const char* ReadFaceVertex(const char* p, const char* end, uint32_t indices[3]) {
+		p = SkipSpace(p, end);
+		for (int32_t element = 0; element < 3; ++element) {
+			indices[element] = 0;
+			auto result = std::from_chars(p, end, indices[element]);
+			p = result.ptr;
+			if (p >= end || *p != '/') {
+				break;
+			}
+			++p; // "/"でインデックスを区切る
+		}
+		return SkipToken(p, end);
+	}
+
+	template<typename T>
+	T GetElement(const std::vector<T>& elements, uint32_t index) {
+		// OBJのインデックスは1始まり
+		if (index == 0 || index > elements.size()) {
+			return T{};
+		}
+		return elements[index - 1];
+	}
+}
+
+namespace ObjLoader {
+	void Parse(const char* begin, const char* end, ModelData& modelData, std::string& materialFilename) {
+		std::vector<Vector4> positions;
+		std::vector<Vector3> normals;
+		std::vector<Vector2> texcoords;
+
+		const char* p = begin;
+		while (p < end) {
+			// 1行の範囲
+			const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', end - p));
+			if (lineEnd == nullptr) {
+				lineEnd = end;
+			}
+
+			//先頭の義別子 (v ,vt, vn, f) を読み取る
+			const char* q = SkipSpace(p, lineEnd);
+			const char* idEnd = SkipToken(q, lineEnd);
+			size_t idLength = idEnd - q;
+
+			if (idLength == 1 && q[0] == 'v') {
+				Vector4 position;
+				const char* s = ReadFloat(idEnd, lineEnd, position.x);
+				s = ReadFloat(s, lineEnd, position.y);
+				ReadFloat(s, lineEnd, position.z);
+				position.s = 1.0f;
+
+				//反転
+				position.x *= -1.0f;
+				positions.push_back(position);
+			}
+			else if (idLength == 2 && q[0] == 'v' && q[1] == 't') {
+				Vector2 texcoord;
+				const char* s = ReadFloat(idEnd, lineEnd, texcoord.x);
+				ReadFloat(s, lineEnd, texcoord.y);
+
+				//原点変更
+				texcoord.y = 1.0f - texcoord.y;
+				texcoords.push_back(texcoord);
+			}
+			else if (idLength == 2 && q[0] == 'v' && q[1] == 'n') {
+				Vector3 normal;
+				const char* s = ReadFloat(idEnd, lineEnd, normal.x);
+				s = ReadFloat(s, lineEnd, normal.y);
+				ReadFloat(s, lineEnd, normal.z);
+
+				//反転
+				normal.x *= -1.0f;
+				normals.push_back(normal);
+			}
+			else if (idLength == 1 && q[0] == 'f') {
+				VertexData triangle[3];
+				const char* s = idEnd;
+				for (int32_t faceVertex = 0; faceVertex < 3; ++faceVertex) {
+					uint32_t elementIndices[3];
+					s = ReadFaceVertex(s, lineEnd, elementIndices);
+					triangle[faceVertex] = {
+						GetElement(positions, elementIndices[0]),
+						GetElement(texcoords, elementIndices[1]),
+						GetElement(normals, elementIndices[2]) };
+				}
+				// 巻き順を反転
+				modelData.vertices.push_back(triangle[2]);
+				modelData.vertices.push_back(triangle[1]);
+				modelData.vertices.push_back(triangle[0]);
+			}
+			else if (idLength == 6 && std::memcmp(q, "mtllib", 6) == 0) {
+				const char* nameBegin = SkipSpace(idEnd, lineEnd);
+				materialFilename.assign(nameBegin, SkipToken(nameBegin, lineEnd));
+			}
+
+			p = lineEnd + 1;
+		}
+	}
+
+	bool LoadMaterialFile(const std::string& directoryPath, const std::string& filename, MaterialData& materialData) {
+		std::ifstream file(directoryPath + "/Object/" + filename);
+		if (!file.is_open()) {
+			return false;
+		}
+
+		std::string line;
+		while (std::getline(file, line)) {
+			std::string identifier;
+			std::istringstream s(line);
+			s >> identifier;
+
+			if (identifier == "map_Kd") {
+				std::string textureFilename;
+				s >> textureFilename;
+
+				materialData.textureFilePath = directoryPath + "/Sprite/" + textureFilename;
+			}
+		}
+		return true;
+	}
+
+	bool LoadFile(const std::string& directoryPath, const std::string& filename, ModelData& modelData) {
+		// ファイルをそのままメモリに載せて読み取る
+		MappedFile file;
+		if (!file.Open(directoryPath + "/Object/" + filename + "/" + filename + ".obj")) {
+			return false;
+		}
+
+		const char* begin = reinterpret_cast<const char*>(file.GetData());
+		std::string materialFilename;
+		Parse(begin, begin + file.GetSize(), modelData, materialFilename);
+
+		if (!materialFilename.empty()) {
+			return LoadMaterialFile(directoryPath, filename + "/" + materialFilename, modelData.material);
+		}
+		return true;
+	}
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include "MyMath.h"
+#include <string>
+
+// OBJテキストの解析
+// Model::LoadObjFileとModelBinary::Bakeから使う。対応しているのは v / vt / vn / f / mtllib だけ
+namespace ObjLoader {
+	// [begin, end)のOBJを1回の走査で解析する
+	// X反転・V反転・巻き順の反転はModelの描画に合わせて行う
+	// mtllibがあればそのファイル名をmaterialFilenameに返す
+	void Parse(const char* begin, const char* end, ModelData& modelData, std::string& materialFilename);
+
+	// directoryPath/Object/filenameのMTLを読み込む(map_Kdだけ。開けなければfalse)
+	bool LoadMaterialFile(const std::string& directoryPath, const std::string& filename, MaterialData& materialData);
+
+	// directoryPath/Object/filename/filename.objとそのMTLを読み込む(開けなければfalse)
+	bool LoadFile(const std::string& directoryPath, const std::string& filename, ModelData& modelData);
+}
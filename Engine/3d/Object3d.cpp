@@ -83,7 +83,7 @@ void Object3d::Draw(const WorldTransform& worldTransform) {
 	}
 }
 
-void Object3d::Draw(const WorldTransform& worldTransform, const std::string& textureData) {
+void Object3d::Draw(const WorldTransform& worldTransform, D3D12_GPU_DESCRIPTOR_HANDLE textureHandle) {
 
 	Matrix4x4 WorldViewProjectionMatrix;
 	if (camera) {
@@ -105,7 +105,7 @@ void Object3d::Draw(const WorldTransform& worldTransform, const std::string& tex
 	object3dCommon->GetDirectXCommon()->GetCommandList()->SetGraphicsRootConstantBufferView(1, wvpResource->GetGPUVirtualAddress());
 	object3dCommon->GetDirectXCommon()->GetCommandList()->SetGraphicsRootConstantBufferView(3, directionalLightSphereResource->GetGPUVirtualAddress());
 	if (model) {
-		model->Draw(textureData);
+		model->Draw(textureHandle);
 	}
 }
 
@@ -17,7 +17,8 @@ public:
 	void Initialize();
 	void Update();
 	void Draw(const WorldTransform& worldTransform);
-	void Draw(const WorldTransform& worldTransform, const std::string& textureData);
+	// テクスチャを差し替えて描画(ハンドルはTextureManager::LoadTextureHandleで取っておく)
+	void Draw(const WorldTransform& worldTransform, D3D12_GPU_DESCRIPTOR_HANDLE textureHandle);
 
 
 	//static MaterialData LoadMaterialTemplateFile(const std::string& directoryPath, const std::string& filename);
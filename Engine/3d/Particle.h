@@ -1,23 +1,11 @@
 #pragma once
 #include "MyMath.h"
 #include "ParticleCommon.h"
-#include <random>
+#include "ParticleStore.h"
+#include "ParticleBillboard.h"
+#include "FastRandom.h"
 
 
-struct ParticleForGPU {
-	Matrix4x4 WVP;
-	Matrix4x4 World;
-	Vector4 color;
-};
-
-struct Particles {
-	Transform transform;
-	Vector3 velocity;
-	Vector4 color;
-	float lifeTime;
-	float currentTime;
-};
-
 struct Emitter {
 	Transform transform;
 	uint32_t count; //発生数
@@ -25,11 +13,6 @@ struct Emitter {
 	float frequencyTime; //頻度時刻
 };
 
-struct AccelerationField {
-	Vector3 acceleration;
-	AABB area;
-};
-
 enum class BornParticle {
 	TimerMode, //タイマーで出てくる
 	MomentMode,//瞬間的に出てくる
@@ -44,7 +27,6 @@ enum class ParticleType {
 
 class Particle{
 public:
-	~Particle(); // デストラクタを追加
 	void Initialize(std::string textureFile);
 	void Update();
 	void Draw();
@@ -80,53 +62,37 @@ public:
 
 	void SetParticleCount(uint32_t countnum) { emitter.count = countnum; }
 
+	// 生きている粒子があるか、次のUpdateで発生する
+	bool IsPlaying() const { return particles.GetCount() > 0 || bornP == BornParticle::MomentMode; }
+
 
 	void Emit(ParticleType type);
 
+	// このエミッターの乱数を決める(InitializeでParticleEmitterから割り当てたものを上書きする)
+	void SetSeed(uint64_t seed) { random.Seed(seed); }
+
 private:
 	ParticleCommon* particleCommon = nullptr;
 
-	
-	std::string fileName;
 	std::string textureFile;
+	// ParticleManagerのテクスチャごとのグループ
+	uint32_t groupIndex = 0;
 
-	Microsoft::WRL::ComPtr<ID3D12Resource> vertexResource;
-	Microsoft::WRL::ComPtr<ID3D12Resource> materialResource;
-
-
-	VertexData* vertexData = nullptr;
-	Material* materialData = nullptr;
-
-	D3D12_VERTEX_BUFFER_VIEW vertexBufferView;
-
-
-
-
-	Microsoft::WRL::ComPtr<ID3D12Resource> wvpResource;
-	ParticleForGPU* wvpData = nullptr;
-
-	//ライト用のリソース
-	Microsoft::WRL::ComPtr<ID3D12Resource> directionalLightSphereResource;
-
-
-	//マテリアルにデータを書き込む
-	DirectionalLight* directionalLightSphereData = nullptr;
-
-
-	static const uint32_t kNumMaxInstance = 100;
-
-	//Transform transform[kNumMaxInstance];
+	// エミッター1つが持てる数(描画はテクスチャごとにまとめる)
+	static const uint32_t kNumMaxInstance = 512;
 
-	//Particles particles[kNumMaxInstance];
-	std::list<Particles> particles;
-	uint32_t numInstance = 0;
+	// 生きているパーティクル(kNumMaxInstance個まで)
+	ParticleStore particles;
+	// フレームごとのビルボード基底
+	ParticleBillboard billboard;
 
 	Transform transformL;
 
 	Camera* camera = nullptr;
 
-	ModelData modelData;
 	Emitter emitter{};
+	// エミッターごとの乱数(他のエミッターの発生順に左右されない)
+	FastRandom random;
 
 	//std::list<Particles> MakeEmit(const Emitter& emitter, std::mt19937& randomEngine);
 
@@ -135,8 +101,6 @@ private:
 	BornParticle bornP = BornParticle::TimerMode;
 	ParticleType particleType = ParticleType::Normal;
 
-	uint32_t number = 0;
-	
 	// 初期化状態を追跡するフラグ
 	bool isInitialized = false;
 };
\ No newline at end of file
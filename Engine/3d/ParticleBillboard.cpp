@@ -0,0 +1,90 @@
+#include "ParticleBillboard.h"
+#include <cmath>
+#include <numbers>
+
+using namespace MyMath;
+
+namespace {
+	Vector3 GetRow(const Matrix4x4& m, int row) {
+		return { m.m[row][0], m.m[row][1], m.m[row][2] };
+	}
+
+	// (v, 0) × m
+	Vector4 TransformDirection(const Vector3& v, const Matrix4x4& m) {
+		return {
+			v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0],
+			v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1],
+			v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2],
+			v.x * m.m[0][3] + v.y * m.m[1][3] + v.z * m.m[2][3],
+		};
+	}
+
+	Vector3 Combine(const Vector3& a, float ka, const Vector3& b, float kb) {
+		return { a.x * ka + b.x * kb, a.y * ka + b.y * kb, a.z * ka + b.z * kb };
+	}
+}
+
+void ParticleBillboard::Begin(const Matrix4x4& cameraWorld, const Matrix4x4& viewProjection) {
+	// 板ポリの裏表を合わせる回転
+	Matrix4x4 backToFrontMatrix = MakeRotateYMatrix(std::numbers::pi_v<float>);
+	Vector3 camera[3] = { GetRow(cameraWorld, 0), GetRow(cameraWorld, 1), GetRow(cameraWorld, 2) };
+
+	// backToFront × RotateZ(r) × camera のi行目を cos(r)とsin(r)の係数に分けておく
+	for (int i = 0; i < 3; ++i) {
+		float q0 = backToFrontMatrix.m[i][0];
+		float q1 = backToFrontMatrix.m[i][1];
+		float q2 = backToFrontMatrix.m[i][2];
+		axisX_[i] = Combine(camera[0], q0, camera[1], q1);
+		axisY_[i] = Combine(camera[1], q0, camera[0], -q1);
+		axisW_[i] = { camera[2].x * q2, camera[2].y * q2, camera[2].z * q2 };
+
+		clipX_[i] = TransformDirection(axisX_[i], viewProjection);
+		clipY_[i] = TransformDirection(axisY_[i], viewProjection);
+		clipW_[i] = TransformDirection(axisW_[i], viewProjection);
+	}
+
+	for (int i = 0; i < 4; ++i) {
+		viewProjection_[i] = { viewProjection.m[i][0], viewProjection.m[i][1], viewProjection.m[i][2], viewProjection.m[i][3] };
+	}
+}
+
+void ParticleBillboard::Write(const ParticleStore& store, uint32_t index, ParticleForGPU& out) const {
+	// 回転していないものは三角関数を省く
+	float c = 1.0f;
+	float s = 0.0f;
+	if (store.rotateZ[index] != 0.0f) {
+		c = std::cos(store.rotateZ[index]);
+		s = std::sin(store.rotateZ[index]);
+	}
+	const float scale[3] = { store.scaleX[index], store.scaleY[index], store.scaleZ[index] };
+
+	for (int i = 0; i < 3; ++i) {
+		const float k = scale[i];
+		out.World.m[i][0] = (c * axisX_[i].x + s * axisY_[i].x + axisW_[i].x) * k;
+		out.World.m[i][1] = (c * axisX_[i].y + s * axisY_[i].y + axisW_[i].y) * k;
+		out.World.m[i][2] = (c * axisX_[i].z + s * axisY_[i].z + axisW_[i].z) * k;
+		out.World.m[i][3] = 0.0f;
+
+		out.WVP.m[i][0] = (c * clipX_[i].x + s * clipY_[i].x + clipW_[i].x) * k;
+		out.WVP.m[i][1] = (c * clipX_[i].y + s * clipY_[i].y + clipW_[i].y) * k;
+		out.WVP.m[i][2] = (c * clipX_[i].z + s * clipY_[i].z + clipW_[i].z) * k;
+		out.WVP.m[i][3] = (c * clipX_[i].s + s * clipY_[i].s + clipW_[i].s) * k;
+	}
+
+	const float tx = store.translateX[index];
+	const float ty = store.translateY[index];
+	const float tz = store.translateZ[index];
+	out.World.m[3][0] = tx;
+	out.World.m[3][1] = ty;
+	out.World.m[3][2] = tz;
+	out.World.m[3][3] = 1.0f;
+
+	const Vector4* vp = viewProjection_;
+	out.WVP.m[3][0] = tx * vp[0].x + ty * vp[1].x + tz * vp[2].x + vp[3].x;
+	out.WVP.m[3][1] = tx * vp[0].y + ty * vp[1].y + tz * vp[2].y + vp[3].y;
+	out.WVP.m[3][2] = tx * vp[0].z + ty * vp[1].z + tz * vp[2].z + vp[3].z;
+	out.WVP.m[3][3] = tx * vp[0].s + ty * vp[1].s + tz * vp[2].s + vp[3].s;
+
+	out.color = store.color[index];
+	out.color.s = store.alpha[index];
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include "MyMath.h"
+#include "ParticleStore.h"
+#include <cstdint>
+
+struct ParticleForGPU {
+	Matrix4x4 WVP;
+	Matrix4x4 World;
+	Vector4 color;
+};
+
+// パーティクルのビルボード行列をまとめて作る
+// カメラの回転とVPはフレームで共通なので、Beginで1回だけ基底を作り
+// Writeでは 拡縮 × 基底 + 移動 を直接インスタンスデータに書く
+class ParticleBillboard {
+public:
+	// フレームの最初に呼ぶ(cameraWorldの移動成分は使わない)
+	void Begin(const Matrix4x4& cameraWorld, const Matrix4x4& viewProjection);
+
+	// store[index]の行列と色を書き込む
+	void Write(const ParticleStore& store, uint32_t index, ParticleForGPU& out) const;
+
+private:
+	// ビルボードのi行目 = cos(rotateZ) * axisX_[i] + sin(rotateZ) * axisY_[i] + axisW_[i]
+	Vector3 axisX_[3];
+	Vector3 axisY_[3];
+	Vector3 axisW_[3];
+	// 上の各行にVPを掛けたもの(WVPの1～3行目用)
+	Vector4 clipX_[3];
+	Vector4 clipY_[3];
+	Vector4 clipW_[3];
+	// VPの各行(WVPの4行目 = 移動 × VP)
+	Vector4 viewProjection_[4];
+};
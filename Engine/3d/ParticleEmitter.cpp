@@ -14,36 +14,29 @@ ParticleEmitter* ParticleEmitter::GetInstance() {
 	return instance;
 }
 
-Particles ParticleEmitter::MakeNewParticle(std::mt19937& randomEngine, const Emitter& emitter) {
-	//random
-	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);//position用
-	//std::uniform_real_distribution<float> distColor(0.0f, 1.0f);//color用
-	std::uniform_real_distribution<float> distTime(1.0f, 3.0f);
-
+Particles ParticleEmitter::MakeNewParticle(const float* random, const Emitter& emitter) {
 	Particles particle;
 	particle.transform.scale = emitter.transform.scale;
 	particle.transform.rotate = { 0.0f,0.0f,0.0f };
 
-	Vector3 randomTranslate{ distribution(randomEngine),distribution(randomEngine),distribution(randomEngine) };
 	particle.transform.translate = emitter.transform.translate;
 
-	particle.velocity = { distribution(randomEngine),distribution(randomEngine),distribution(randomEngine) };
+	//速度は-1～1
+	particle.velocity = { random[0] * 2.0f - 1.0f,random[1] * 2.0f - 1.0f,random[2] * 2.0f - 1.0f };
 	//particle.color = { distColor(randomEngine),distColor(randomEngine),distColor(randomEngine),1.0f };
 	particle.color = { 1,1,1,1 };
 
-	particle.lifeTime = distTime(randomEngine);
+	//寿命は1～3秒
+	particle.lifeTime = 1.0f + random[3] * 2.0f;
 	particle.currentTime = 0;
 
 	return particle;
 }
-Particles ParticleEmitter::MakeNewParticlePlane(std::mt19937& randomEngine, const Vector3& translate) {
-	//random
-	std::uniform_real_distribution<float> distRotate(-std::numbers::pi_v<float>, std::numbers::pi_v<float>);
-	std::uniform_real_distribution<float> distScale(4.5f, 6.5f);
-
+Particles ParticleEmitter::MakeNewParticlePlane(const float* random, const Vector3& translate) {
 	Particles particle;
-	particle.transform.scale = { 0.1f,distScale(randomEngine),1.0f };
-	particle.transform.rotate = { 0.0f,0.0f,distRotate(randomEngine) };
+	//縦の長さは4.5～6.5、向きは-π～π
+	particle.transform.scale = { 0.1f,4.5f + random[0] * 2.0f,1.0f };
+	particle.transform.rotate = { 0.0f,0.0f,(random[1] * 2.0f - 1.0f) * std::numbers::pi_v<float> };
 
 	particle.transform.translate = translate;
 
@@ -56,25 +49,30 @@ Particles ParticleEmitter::MakeNewParticlePlane(std::mt19937& randomEngine, cons
 	return particle;
 }
 
-std::list<Particles> ParticleEmitter::MakeEmit(const Emitter& emitter, std::mt19937& randomEngine, ParticleType Type) {
-	std::list<Particles> particles;
+void ParticleEmitter::MakeEmit(const Emitter& emitter, ParticleType Type, ParticleStore& particles, FastRandom& random) {
+	uint32_t perParticle = (Type == ParticleType::Plane) ? kPlaneRandomCount : kNormalRandomCount;
+	uint32_t space = particles.GetCapacity() - particles.GetCount();
+	uint32_t count = (emitter.count < space) ? emitter.count : space;
+
+	if (randomValues.size() < static_cast<size_t>(count) * perParticle) {
+		randomValues.resize(static_cast<size_t>(count) * perParticle);
+	}
+	random.FillUniform(randomValues.data(), static_cast<size_t>(count) * perParticle, 0.0f, 1.0f);
+	const float* values = randomValues.data();
 
 	switch (Type)
 	{
 	case ParticleType::Normal:
-		for (uint32_t count = 0; count < emitter.count; ++count) {
-			particles.push_back(MakeNewParticle(randomEngine, emitter));
+		for (uint32_t index = 0; index < count; ++index) {
+			particles.Add(MakeNewParticle(values + index * perParticle, emitter));
 		}
 		break;
 	case ParticleType::Plane:
-		for (uint32_t count = 0; count < emitter.count; ++count) {
-			particles.push_back(MakeNewParticlePlane(randomEngine, emitter.transform.translate));
+		for (uint32_t index = 0; index < count; ++index) {
+			particles.Add(MakeNewParticlePlane(values + index * perParticle, emitter.transform.translate));
 		}
 		break;
 	default:
 		break;
 	}
-
-
-	return particles;
 }
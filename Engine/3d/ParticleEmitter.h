@@ -1,6 +1,7 @@
 #pragma once
 #include "MyMath.h"
 #include "Particle.h"
+#include "FastRandom.h"
 
 
 class ParticleEmitter{
@@ -17,10 +18,26 @@ public:
 		emitter.frequencyTime = 0.0f;
 	}
 
-	Particles MakeNewParticle(std::mt19937& randomEngine, const Emitter& emitter);
-	Particles MakeNewParticlePlane(std::mt19937& randomEngine, const Vector3& translate);
+	// randomは[0, 1)の乱数(Normalはk*RandomCount個、順に使う)
+	Particles MakeNewParticle(const float* random, const Emitter& emitter);
+	Particles MakeNewParticlePlane(const float* random, const Vector3& translate);
 
-	std::list<Particles> MakeEmit(const Emitter& emitter, std::mt19937& randomEngine, ParticleType Type);
+	// emitter.count個をparticlesに追加する(満杯になったらそこまで)
+	// 乱数はエミッターごとのrandomから1回分をまとめて作ってから割り振る
+	void MakeEmit(const Emitter& emitter, ParticleType Type, ParticleStore& particles, FastRandom& random);
+
+	// 次に作るエミッターのシード(SetSeedからの作った順で決まる)
+	uint64_t MakeEmitterSeed() { return seed + 0x9E3779B97F4A7C15ull * ++emitterCount; }
+
+	// 同じシードで同じ順にエミッターを作れば同じ結果になる
+	void SetSeed(uint64_t seed) {
+		this->seed = seed;
+		emitterCount = 0;
+	}
+
+	// 1粒子あたりに使う乱数の数
+	static const uint32_t kNormalRandomCount = 4;
+	static const uint32_t kPlaneRandomCount = 2;
 
 private:
 	static ParticleEmitter* instance;
@@ -34,4 +51,9 @@ private:
 
 
 	Emitter emitter{};
+
+	uint64_t seed = FastRandom::kDefaultSeed;
+	uint64_t emitterCount = 0;
+	// MakeEmitで使う乱数の置き場(一番多かったときの分を使い回す)
+	std::vector<float> randomValues;
 };
\ No newline at end of file
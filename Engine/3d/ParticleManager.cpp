@@ -1,6 +1,8 @@
 #include "ParticleManager.h"
 #include "ModelManager.h"
+#include "TextureManager.h"
 #include <cassert>
+#include <cstring>
 
 using namespace MyMath;
 
@@ -8,8 +10,6 @@ using namespace StringUtility;
 
 ParticleManager* ParticleManager::instance = nullptr;
 
-uint32_t ParticleManager::kSRVIndexTop = 1;
-
 ParticleManager* ParticleManager::GetInstance() {
 	if (instance == nullptr) {
 		instance = new ParticleManager();
@@ -17,8 +17,17 @@ ParticleManager* ParticleManager::GetInstance() {
 	return instance;
 }
 
+ParticleManager::~ParticleManager() {
+	for (ParticleGroup& particleG : particleGroups) {
+		if (particleG.resource && particleG.instanceData) {
+			particleG.resource->Unmap(0, nullptr);
+			particleG.instanceData = nullptr;
+		}
+	}
+}
+
 void ParticleManager::Initialize(DirectXCommon* dxCommon, SrvManager* srvManager) {
-	particleCommon = ParticleCommon::GetInstance(); 
+	particleCommon = ParticleCommon::GetInstance();
 	this->srvManager = srvManager;
 	//particleCommon->Initialize(dxCommon);
 }
@@ -29,51 +38,78 @@ void ParticleManager::Finalize() {
 	instance = nullptr;
 }
 
+void ParticleManager::CreateSharedResources() {
+	//仮のモデル
+	modelData.vertices.push_back({ {1.0f,1.0f,0.0f,1.0f},{0.0f,0.0f},{0.0f,0.0f,1.0f} });
+	modelData.vertices.push_back({ {-1.0f,1.0f,0.0f,1.0f},{1.0f,0.0f},{0.0f,0.0f,1.0f} });
+	modelData.vertices.push_back({ {1.0f,-1.0f,0.0f,1.0f},{0.0f,1.0f},{0.0f,0.0f,1.0f} });
+	modelData.vertices.push_back({ {1.0f,-1.0f,0.0f,1.0f},{0.0f,1.0f},{0.0f,0.0f,1.0f} });
+	modelData.vertices.push_back({ {-1.0f,1.0f,0.0f,1.0f},{1.0f,0.0f},{0.0f,0.0f,1.0f} });
+	modelData.vertices.push_back({ {-1.0f,-1.0f,0.0f,1.0f},{1.0f,1.0f},{0.0f,0.0f,1.0f} });
+
+	DirectXCommon* dxCommon = particleCommon->GetDxCommon();
+
+	vertexResource = dxCommon->CreateBufferResource(sizeof(VertexData) * modelData.vertices.size());
+	vertexBufferView.BufferLocation = vertexResource->GetGPUVirtualAddress();
+	vertexBufferView.SizeInBytes = UINT(sizeof(VertexData) * modelData.vertices.size());
+	vertexBufferView.StrideInBytes = sizeof(VertexData);
+	VertexData* vertexData = nullptr;
+	vertexResource->Map(0, nullptr, reinterpret_cast<void**>(&vertexData));
+	std::memcpy(vertexData, modelData.vertices.data(), sizeof(VertexData) * modelData.vertices.size());
+	vertexResource->Unmap(0, nullptr);
+
+	//マテリアル
+	materialResource = dxCommon->CreateBufferResource(sizeof(Material));
+	Material* materialData = nullptr;
+	materialResource->Map(0, nullptr, reinterpret_cast<void**>(&materialData));
+	materialData->color = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+	materialData->enableLighting = true;
+	materialData->uvTransform = MakeIdentity4x4();
+	materialResource->Unmap(0, nullptr);
+
+	//ライト
+	directionalLightResource = dxCommon->CreateBufferResource(sizeof(DirectionalLight));
+	DirectionalLight* directionalLightData = nullptr;
+	directionalLightResource->Map(0, nullptr, reinterpret_cast<void**>(&directionalLightData));
+	directionalLightData->color = { 1.0f,1.0f,1.0f,1.0f };
+	directionalLightData->direction = { 0.0f,-1.0f,0.0f };
+	directionalLightData->intensity = 1.0f;
+	directionalLightResource->Unmap(0, nullptr);
+}
 
-void ParticleManager::CreateParticleGroup(const std::string name, const std::string textureFilePath) {
+uint32_t ParticleManager::GetGroupIndex(const std::string& textureFilePath) {
 	//読み込み済み
-	if (particleGroups.contains(name)) {
-		char debugMsg[256];
-		sprintf_s(debugMsg, "ParticleManager::CreateParticleGroup - Group '%s' already exists, skipping\n", name.c_str());
-		OutputDebugStringA(debugMsg);
-		return;
+	auto it = groupIndices.find(textureFilePath);
+	if (it != groupIndices.end()) {
+		return it->second;
 	}
 
 	assert(srvManager->Max());
 
-	ParticleGroup& particleG = particleGroups[name];
-
+	if (!vertexResource) {
+		CreateSharedResources();
+	}
 
+	ParticleGroup particleG;
 	particleG.textureFile = textureFilePath;
+	particleG.textureHandle = TextureManager::GetInstance()->LoadTextureHandle(textureFilePath);
 
-	//仮のモデル
-	particleG.modelData.vertices.push_back({ {1.0f,1.0f,0.0f,1.0f},{0.0f,0.0f},{0.0f,0.0f,1.0f} });
-	particleG.modelData.vertices.push_back({ {-1.0f,1.0f,0.0f,1.0f},{1.0f,0.0f},{0.0f,0.0f,1.0f} });
-	particleG.modelData.vertices.push_back({ {1.0f,-1.0f,0.0f,1.0f},{0.0f,1.0f},{0.0f,0.0f,1.0f} });
-	particleG.modelData.vertices.push_back({ {1.0f,-1.0f,0.0f,1.0f},{0.0f,1.0f},{0.0f,0.0f,1.0f} });
-	particleG.modelData.vertices.push_back({ {-1.0f,1.0f,0.0f,1.0f},{1.0f,0.0f},{0.0f,0.0f,1.0f} });
-	particleG.modelData.vertices.push_back({ {-1.0f,-1.0f,0.0f,1.0f},{1.0f,1.0f},{0.0f,0.0f,1.0f} });
-
-	particleG.modelData.material.textureFilePath = textureFilePath;
-	
 	// デバッグ情報を追加
 	char debugMsg[256];
-	sprintf_s(debugMsg, "ParticleManager::CreateParticleGroup - Creating group '%s' with texture: %s\n", name.c_str(), textureFilePath.c_str());
+	sprintf_s(debugMsg, "ParticleManager::GetGroupIndex - Creating group %d with texture: %s\n", static_cast<int>(particleGroups.size()), textureFilePath.c_str());
 	OutputDebugStringA(debugMsg);
 
+	particleG.resource = particleCommon->GetDxCommon()->CreateBufferResource(sizeof(ParticleForGPU) * kNumInstance);
 
-	particleG.resource = particleCommon->GetDxCommon()->CreateBufferResource(sizeof(ParticleForGPU) * particleG.kNumInstance);
-	
 	// リソース作成のエラーチェック
 	if (!particleG.resource) {
 		char errorMsg[256];
-		sprintf_s(errorMsg, "ParticleManager::CreateParticleGroup - Failed to create buffer resource for particle group '%s'\n", name.c_str());
+		sprintf_s(errorMsg, "ParticleManager::GetGroupIndex - Failed to create buffer resource for texture '%s'\n", textureFilePath.c_str());
 		OutputDebugStringA(errorMsg);
-		// エラー時はパーティクルグループを削除
-		particleGroups.erase(name);
-		return;
+		return kInvalidGroup;
 	}
-
+	// 毎フレーム書き直すので開きっぱなしにする
+	particleG.resource->Map(0, nullptr, reinterpret_cast<void**>(&particleG.instanceData));
 
 	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
 	srvDesc.Format = DXGI_FORMAT_UNKNOWN;
@@ -81,101 +117,79 @@ void ParticleManager::CreateParticleGroup(const std::string name, const std::str
 	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
 	srvDesc.Buffer.FirstElement = 0;
 	srvDesc.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_NONE;
-	srvDesc.Buffer.NumElements = particleG.kNumInstance;
+	srvDesc.Buffer.NumElements = kNumInstance;
 	srvDesc.Buffer.StructureByteStride = sizeof(ParticleForGPU);
 
 	particleG.srvIndex = srvManager->Allocate();
 	particleG.srvHandleCPU = srvManager->GetCPUDescriptorHandle(particleG.srvIndex);
 	particleG.srvHandleGPU = srvManager->GetGPUDescriptorHandle(particleG.srvIndex);
-	
 
 	//SRVの生成
 	particleCommon->GetDxCommon()->GetDevice()->CreateShaderResourceView(particleG.resource.Get(), &srvDesc, particleG.srvHandleCPU);
 
-
-	//particleEmit->Emit();
-
-	emitter.transform.rotate = { 0.0f,0.0f,0.0f };
-	emitter.transform.scale = { 1.0f,1.0f,1.0f };
-	emitter.frequency = 0.5f;
-	emitter.frequencyTime = 0.0f;
+	uint32_t index = static_cast<uint32_t>(particleGroups.size());
+	particleGroups.push_back(std::move(particleG));
+	groupIndices[textureFilePath] = index;
+	return index;
 }
 
-D3D12_GPU_DESCRIPTOR_HANDLE  ParticleManager::GetSrvHandleGPU(const std::string filePath) {
-	assert(srvManager->Max());
+ParticleForGPU* ParticleManager::AllocateInstances(uint32_t groupIndex, uint32_t& count) {
+	if (groupIndex >= particleGroups.size()) {
+		count = 0;
+		return nullptr;
+	}
 
-	// パーティクルグループが存在するか確認
-	if (particleGroups.find(filePath) == particleGroups.end()) {
-		char errorMsg[256];
-		sprintf_s(errorMsg, "ParticleManager::GetSrvHandleGPU - Particle group '%s' not found\n", filePath.c_str());
-		OutputDebugStringA(errorMsg);
-		// 空のハンドルを返す
-		D3D12_GPU_DESCRIPTOR_HANDLE emptyHandle = {};
-		return emptyHandle;
+	ParticleGroup& particleG = particleGroups[groupIndex];
+	uint32_t space = kNumInstance - particleG.numInstance;
+	if (count > space) {
+		pendingDroppedCount += count - space;
+		count = space;
+	}
+	if (count == 0) {
+		return nullptr;
 	}
 
-	ParticleGroup& particleG = particleGroups[filePath];
-	return particleG.srvHandleGPU;
+	ParticleForGPU* instances = particleG.instanceData + particleG.numInstance;
+	particleG.numInstance += count;
+	return instances;
 }
 
-ModelData ParticleManager::GetModelData(const std::string filePath) {
-	assert(srvManager->Max());
-
-	// パーティクルグループが存在するか確認
-	if (particleGroups.find(filePath) == particleGroups.end()) {
+void ParticleManager::Draw() {
+	// 溢れた分は描かれない(最初の1回だけ知らせる)
+	droppedInstanceCount = pendingDroppedCount;
+	pendingDroppedCount = 0;
+	if (droppedInstanceCount > 0 && !droppedLogged) {
 		char errorMsg[256];
-		sprintf_s(errorMsg, "ParticleManager::GetModelData - Particle group '%s' not found\n", filePath.c_str());
+		sprintf_s(errorMsg, "ParticleManager::Draw - %d instances dropped (limit %d per texture)\n", droppedInstanceCount, kNumInstance);
 		OutputDebugStringA(errorMsg);
-		// 空のモデルデータを返す
-		ModelData emptyData = {};
-		return emptyData;
+		droppedLogged = true;
 	}
 
-	ParticleGroup& particleG = particleGroups[filePath];
-	return particleG.modelData;
-}
+	drawnInstanceCount = 0;
 
-std::string ParticleManager::GetTextureHandle(const std::string filePath) {
-	assert(srvManager->Max());
+	ID3D12GraphicsCommandList* commandList = particleCommon->GetDxCommon()->GetCommandList();
+	bool isCommonSet = false;
 
-	ParticleGroup& particleG = particleGroups[filePath];
-	return particleG.textureFile;
-}
+	for (ParticleGroup& particleG : particleGroups) {
+		if (particleG.numInstance == 0) {
+			continue;
+		}
 
-Microsoft::WRL::ComPtr<ID3D12Resource> ParticleManager::GetResource(const std::string filePath) {
-	assert(srvManager->Max());
+		if (!isCommonSet) {
+			commandList->IASetVertexBuffers(0, 1, &vertexBufferView);
+			commandList->SetGraphicsRootConstantBufferView(0, materialResource->GetGPUVirtualAddress()); //rootParameterの配列の0番目 [0]
+			commandList->SetGraphicsRootConstantBufferView(3, directionalLightResource->GetGPUVirtualAddress());
+			isCommonSet = true;
+		}
 
-	// パーティクルグループが存在するか確認
-	if (particleGroups.find(filePath) == particleGroups.end()) {
-		char errorMsg[256];
-		sprintf_s(errorMsg, "ParticleManager::GetResource - Particle group '%s' not found\n", filePath.c_str());
-		OutputDebugStringA(errorMsg);
-		return nullptr;
-	}
-
-	ParticleGroup& particleG = particleGroups[filePath];
-	return particleG.resource;
-}
+		commandList->SetGraphicsRootConstantBufferView(1, particleG.resource->GetGPUVirtualAddress());
+		commandList->SetGraphicsRootDescriptorTable(2, particleG.textureHandle);
+		//4のやつ particle専用
+		commandList->SetGraphicsRootDescriptorTable(4, particleG.srvHandleGPU);
 
-std::list<Particles> ParticleManager::GetParticle(const std::string filePath) {
-	assert(srvManager->Max());
+		commandList->DrawInstanced(UINT(modelData.vertices.size()), particleG.numInstance, 0, 0);
 
-	ParticleGroup& particleG = particleGroups[filePath];
-	return particleG.particles;
+		drawnInstanceCount += particleG.numInstance;
+		particleG.numInstance = 0;
+	}
 }
-
-//void ParticleManager::Emit(const std::string name, const Vector3& position, uint32_t count, ParticleType type) {
-//	ParticleGroup& particleG = particleGroups[name];
-//
-//
-//	emitter.transform.translate = position;
-//	emitter.count = count;
-//
-//	//
-//	std::random_device seedGenerator;
-//	std::mt19937 randomEngine(seedGenerator());
-//
-//	particleG.particles = ParticleEmitter::GetInstance()->MakeEmit(emitter, randomEngine, type);
-//	//emitter.frequencyTime -= emitter.frequency;
-//	
-//}
@@ -2,61 +2,81 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <list>
+#include <unordered_map>
+#include <vector>
 #include "Particle.h"
 #include "SrvManager.h"
 #include "ParticleEmitter.h"
 
+// パーティクルの描画をテクスチャごとにまとめる
+// 各エミッターはGPUリソースを持たず、Drawで生きている分をテクスチャごとの
+// 共有インスタンスバッファに前から詰めて書く。フレームの最後にDrawで1回ずつ描く
 class ParticleManager {
 public:
 	static ParticleManager* GetInstance();
 	void Finalize();
 	void Initialize(DirectXCommon* dxCommon, SrvManager* srvManager);
 
-	void CreateParticleGroup(const std::string name, const std::string textureFilePath);
+	// テクスチャのグループ番号(無ければ作る)。作れなかったらkInvalidGroup
+	uint32_t GetGroupIndex(const std::string& textureFilePath);
 
-	D3D12_GPU_DESCRIPTOR_HANDLE  GetSrvHandleGPU(const std::string filePath);
-	ModelData GetModelData(const std::string filePath);
-	std::string GetTextureHandle(const std::string filePath);
-	Microsoft::WRL::ComPtr<ID3D12Resource> GetResource(const std::string filePath);
-	std::list<Particles> GetParticle(const std::string filePath);
+	// グループの今フレームの書き込み先をcount個分取る
+	// 空きが足りなければcountを減らす(0ならnullptr)
+	ParticleForGPU* AllocateInstances(uint32_t groupIndex, uint32_t& count);
 
-	//void Emit(const std::string name, const Vector3& position, uint32_t count, ParticleType type);
+	// 溜まったインスタンスをグループごとに描画して空にする(ParticleCommon::Commandの後に呼ぶ)
+	void Draw();
+
+	// 直前のDrawで描いた数
+	uint32_t GetDrawnInstanceCount() const { return drawnInstanceCount; }
+	uint32_t GetDroppedInstanceCount() const { return droppedInstanceCount; }
+	uint32_t GetGroupCount() const { return static_cast<uint32_t>(particleGroups.size()); }
+
+	static const uint32_t kInvalidGroup = UINT32_MAX;
+	// テクスチャ1枚で1フレームに描ける数
+	static const uint32_t kNumInstance = 16384;
 
 private:
 	static ParticleManager* instance;
 
 	ParticleManager() = default;
-	~ParticleManager() = default;
+	~ParticleManager();
 	ParticleManager(ParticleManager&) = delete;
 	ParticleManager& operator=(ParticleManager&) = delete;
 
+	// 全グループで共有する板ポリ・マテリアル・ライト
+	void CreateSharedResources();
+
 	ParticleCommon* particleCommon = nullptr;
 
 	SrvManager* srvManager = nullptr;
-	static uint32_t kSRVIndexTop;
 
 	struct ParticleGroup {
 		std::string textureFile;
-		ModelData modelData;
+		D3D12_GPU_DESCRIPTOR_HANDLE textureHandle{};
 
-		std::list<Particles> particles;
-		uint32_t srvIndex;
 		Microsoft::WRL::ComPtr<ID3D12Resource> resource;
-		uint32_t kNumInstance = 100;
-		DirectX::TexMetadata metadata; //width,height
-
+		ParticleForGPU* instanceData = nullptr;
+		uint32_t numInstance = 0; //今フレームに詰めた数
 
+		uint32_t srvIndex;
 		D3D12_CPU_DESCRIPTOR_HANDLE srvHandleCPU;
 		D3D12_GPU_DESCRIPTOR_HANDLE srvHandleGPU;
 	};
 
-	Emitter emitter{};
-	const float kDeltaTime = 1.0f / 60.0f;
-
-
-	//uint32_t kNumInstance = 10;
-	//Microsoft::WRL::ComPtr<ID3D12Resource> instancingResource;
-
-	std::unordered_map<std::string, ParticleGroup> particleGroups;
-
-};
\ No newline at end of file
+	std::vector<ParticleGroup> particleGroups;
+	std::unordered_map<std::string, uint32_t> groupIndices;
+
+	//共有リソース
+	ModelData modelData;
+	Microsoft::WRL::ComPtr<ID3D12Resource> vertexResource;
+	D3D12_VERTEX_BUFFER_VIEW vertexBufferView{};
+	Microsoft::WRL::ComPtr<ID3D12Resource> materialResource;
+	Microsoft::WRL::ComPtr<ID3D12Resource> directionalLightResource;
+
+	uint32_t drawnInstanceCount = 0;
+	uint32_t droppedInstanceCount = 0;
+	uint32_t pendingDroppedCount = 0; //今フレームに溢れた数
+	bool droppedLogged = false;
+};
@@ -0,0 +1,177 @@
+#include "ParticleStore.h"
+
+// x86/x64ではSSEで4個ずつ進める
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define PARTICLE_USE_SSE
+#include <immintrin.h>
+#endif
+
+namespace {
+	// [begin, end)を1個ずつ進める(スカラー版とSIMD版の端数処理で共有)
+	void IntegrateRange(ParticleStore& store, uint32_t begin, uint32_t end, float deltaTime, const AccelerationField& field, float shrinkSpeed) {
+		const AABB& area = field.area;
+		const float shrink = shrinkSpeed * deltaTime;
+
+		for (uint32_t i = begin; i < end; ++i) {
+			store.alpha[i] = 1.0f - (store.currentTime[i] / store.lifeTime[i]);
+
+			// 場の中にいれば加速
+			if ((area.min.x < store.translateX[i] && area.max.x > store.translateX[i]) &&
+				(area.min.y < store.translateY[i] && area.max.y > store.translateY[i]) &&
+				(area.min.z < store.translateZ[i] && area.max.z > store.translateZ[i])) {
+				store.velocityX[i] += field.acceleration.x * deltaTime;
+				store.velocityY[i] += field.acceleration.y * deltaTime;
+				store.velocityZ[i] += field.acceleration.z * deltaTime;
+			}
+
+			store.translateX[i] += store.velocityX[i] * deltaTime;
+			store.translateY[i] += store.velocityY[i] * deltaTime;
+			store.translateZ[i] += store.velocityZ[i] * deltaTime;
+
+			if (shrink > 0.0f) {
+				if (store.scaleX[i] > 0.0f) {
+					store.scaleX[i] -= shrink;
+				}
+				if (store.scaleY[i] > 0.0f) {
+					store.scaleY[i] -= shrink;
+				}
+				if (store.scaleZ[i] > 0.0f) {
+					store.scaleZ[i] -= shrink;
+				}
+			}
+
+			store.currentTime[i] += deltaTime;
+		}
+	}
+}
+
+
+void ParticleStore::Initialize(uint32_t capacity) {
+	capacity_ = capacity;
+	count_ = 0;
+
+	for (std::vector<float>* array : { &translateX, &translateY, &translateZ, &velocityX, &velocityY, &velocityZ,
+		&scaleX, &scaleY, &scaleZ, &rotateZ, &lifeTime, &currentTime, &alpha }) {
+		array->assign(capacity, 0.0f);
+	}
+	color.assign(capacity, Vector4(1.0f, 1.0f, 1.0f, 1.0f));
+}
+
+bool ParticleStore::Add(const Particles& particle) {
+	if (IsFull()) {
+		return false;
+	}
+
+	uint32_t i = count_++;
+	translateX[i] = particle.transform.translate.x;
+	translateY[i] = particle.transform.translate.y;
+	translateZ[i] = particle.transform.translate.z;
+	velocityX[i] = particle.velocity.x;
+	velocityY[i] = particle.velocity.y;
+	velocityZ[i] = particle.velocity.z;
+	scaleX[i] = particle.transform.scale.x;
+	scaleY[i] = particle.transform.scale.y;
+	scaleZ[i] = particle.transform.scale.z;
+	rotateZ[i] = particle.transform.rotate.z;
+	color[i] = particle.color;
+	lifeTime[i] = particle.lifeTime;
+	currentTime[i] = particle.currentTime;
+	alpha[i] = 1.0f;
+	return true;
+}
+
+void ParticleStore::Remove(uint32_t index) {
+	uint32_t last = --count_;
+	if (index == last) {
+		return;
+	}
+
+	translateX[index] = translateX[last];
+	translateY[index] = translateY[last];
+	translateZ[index] = translateZ[last];
+	velocityX[index] = velocityX[last];
+	velocityY[index] = velocityY[last];
+	velocityZ[index] = velocityZ[last];
+	scaleX[index] = scaleX[last];
+	scaleY[index] = scaleY[last];
+	scaleZ[index] = scaleZ[last];
+	rotateZ[index] = rotateZ[last];
+	color[index] = color[last];
+	lifeTime[index] = lifeTime[last];
+	currentTime[index] = currentTime[last];
+	alpha[index] = alpha[last];
+}
+
+void ParticleStore::RemoveDead() {
+	for (uint32_t i = 0; i < count_;) {
+		if (lifeTime[i] <= currentTime[i]) {
+			// 末尾が入ってくるので同じiをもう一度調べる
+			Remove(i);
+			continue;
+		}
+		++i;
+	}
+}
+
+void ParticleStore::Integrate(float deltaTime, const AccelerationField& field, float shrinkSpeed) {
+#ifdef PARTICLE_USE_SSE
+	const AABB& area = field.area;
+	const __m128 areaMinX = _mm_set1_ps(area.min.x), areaMaxX = _mm_set1_ps(area.max.x);
+	const __m128 areaMinY = _mm_set1_ps(area.min.y), areaMaxY = _mm_set1_ps(area.max.y);
+	const __m128 areaMinZ = _mm_set1_ps(area.min.z), areaMaxZ = _mm_set1_ps(area.max.z);
+	const __m128 accelX = _mm_set1_ps(field.acceleration.x * deltaTime);
+	const __m128 accelY = _mm_set1_ps(field.acceleration.y * deltaTime);
+	const __m128 accelZ = _mm_set1_ps(field.acceleration.z * deltaTime);
+	const __m128 dt = _mm_set1_ps(deltaTime);
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 shrink = _mm_set1_ps(shrinkSpeed * deltaTime);
+	const bool useShrink = shrinkSpeed * deltaTime > 0.0f;
+
+	uint32_t i = 0;
+	for (; i + 4 <= count_; i += 4) {
+		__m128 time = _mm_loadu_ps(&currentTime[i]);
+		_mm_storeu_ps(&alpha[i], _mm_sub_ps(one, _mm_div_ps(time, _mm_loadu_ps(&lifeTime[i]))));
+
+		__m128 x = _mm_loadu_ps(&translateX[i]);
+		__m128 y = _mm_loadu_ps(&translateY[i]);
+		__m128 z = _mm_loadu_ps(&translateZ[i]);
+
+		// 場の中にいるものだけ加速(範囲外は0を足す)
+		__m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(areaMinX, x), _mm_cmpgt_ps(areaMaxX, x)),
+			_mm_and_ps(_mm_and_ps(_mm_cmplt_ps(areaMinY, y), _mm_cmpgt_ps(areaMaxY, y)),
+				_mm_and_ps(_mm_cmplt_ps(areaMinZ, z), _mm_cmpgt_ps(areaMaxZ, z))));
+		__m128 vx = _mm_add_ps(_mm_loadu_ps(&velocityX[i]), _mm_and_ps(inside, accelX));
+		__m128 vy = _mm_add_ps(_mm_loadu_ps(&velocityY[i]), _mm_and_ps(inside, accelY));
+		__m128 vz = _mm_add_ps(_mm_loadu_ps(&velocityZ[i]), _mm_and_ps(inside, accelZ));
+		_mm_storeu_ps(&velocityX[i], vx);
+		_mm_storeu_ps(&velocityY[i], vy);
+		_mm_storeu_ps(&velocityZ[i], vz);
+
+		_mm_storeu_ps(&translateX[i], _mm_add_ps(x, _mm_mul_ps(vx, dt)));
+		_mm_storeu_ps(&translateY[i], _mm_add_ps(y, _mm_mul_ps(vy, dt)));
+		_mm_storeu_ps(&translateZ[i], _mm_add_ps(z, _mm_mul_ps(vz, dt)));
+
+		// 正の成分だけ縮める
+		if (useShrink) {
+			__m128 sx = _mm_loadu_ps(&scaleX[i]);
+			__m128 sy = _mm_loadu_ps(&scaleY[i]);
+			__m128 sz = _mm_loadu_ps(&scaleZ[i]);
+			_mm_storeu_ps(&scaleX[i], _mm_sub_ps(sx, _mm_and_ps(_mm_cmpgt_ps(sx, zero), shrink)));
+			_mm_storeu_ps(&scaleY[i], _mm_sub_ps(sy, _mm_and_ps(_mm_cmpgt_ps(sy, zero), shrink)));
+			_mm_storeu_ps(&scaleZ[i], _mm_sub_ps(sz, _mm_and_ps(_mm_cmpgt_ps(sz, zero), shrink)));
+		}
+
+		_mm_storeu_ps(&currentTime[i], _mm_add_ps(time, dt));
+	}
+
+	// 4個に満たない残り
+	IntegrateRange(*this, i, count_, deltaTime, field, shrinkSpeed);
+#else
+	IntegrateScalar(deltaTime, field, shrinkSpeed);
+#endif
+}
+
+void ParticleStore::IntegrateScalar(float deltaTime, const AccelerationField& field, float shrinkSpeed) {
+	IntegrateRange(*this, 0, count_, deltaTime, field, shrinkSpeed);
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "MyMath.h"
+#include <cstdint>
+#include <vector>
+
+// パーティクル1つ分(発生時の受け渡し用)
+struct Particles {
+	Transform transform;
+	Vector3 velocity;
+	Vector4 color;
+	float lifeTime;
+	float currentTime;
+};
+
+struct AccelerationField {
+	Vector3 acceleration;
+	AABB area;
+};
+
+// 生きているパーティクルを要素ごとの配列(SoA)で持つ
+// 容量はInitializeで確保したまま変えない。消すときは末尾と入れ替えるので順番は保たれない
+// 回転はビルボードのZ回転だけを持つ(X・Yは常に0)
+class ParticleStore {
+public:
+	// capacity個分の配列を確保する(これ以降は確保しない)
+	void Initialize(uint32_t capacity);
+	void Clear() { count_ = 0; }
+
+	// 末尾に追加する(満杯ならfalse)
+	bool Add(const Particles& particle);
+	// indexを末尾と入れ替えて消す
+	void Remove(uint32_t index);
+	// 寿命が尽きたものを消す
+	void RemoveDead();
+
+	// 場の加速・移動・縮小・経過時間を進め、透明度をalphaに書く
+	// shrinkSpeedが0なら縮小しない。x86/x64ではSSEで4個ずつ処理する
+	void Integrate(float deltaTime, const AccelerationField& field, float shrinkSpeed);
+	// SIMDを使わない版(比較・フォールバック用)
+	void IntegrateScalar(float deltaTime, const AccelerationField& field, float shrinkSpeed);
+
+	uint32_t GetCount() const { return count_; }
+	uint32_t GetCapacity() const { return capacity_; }
+	bool IsFull() const { return count_ >= capacity_; }
+
+	std::vector<float> translateX, translateY, translateZ;
+	std::vector<float> velocityX, velocityY, velocityZ;
+	std::vector<float> scaleX, scaleY, scaleZ;
+	std::vector<float> rotateZ;
+	std::vector<Vector4> color;
+	std::vector<float> lifeTime;
+	std::vector<float> currentTime;
+	// Integrateで計算した透明度
+	std::vector<float> alpha;
+
+private:
+	uint32_t count_ = 0;
+	uint32_t capacity_ = 0;
+};
@@ -1,14 +1,30 @@
 #include "PerformanceMonitor.h"
-#include <Windows.h>
-#include <Psapi.h>
+#include "Logger.h"
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
-#include <numeric>
+#include <thread>
 
+#ifdef _WIN32
+#include <Windows.h>
+#include <Psapi.h>
 #pragma comment(lib, "psapi.lib")
+#else
+#include <cstdio>
+#include <unistd.h>
+#endif
+
+#ifdef USE_IMGUI
+#include "externals/imgui/imgui.h"
+#endif
 
 PerformanceMonitor* PerformanceMonitor::instance = nullptr;
 
+namespace {
+    const uint32_t kSampleMask = PerformanceMonitor::kSampleCount - 1;
+    static_assert((PerformanceMonitor::kSampleCount & kSampleMask) == 0, "kSampleCount must be a power of two");
+}
+
 PerformanceMonitor* PerformanceMonitor::GetInstance() {
     if (instance == nullptr) {
         instance = new PerformanceMonitor();
@@ -24,10 +40,10 @@ void PerformanceMonitor::Finalize() {
 PerformanceMonitor::PerformanceMonitor() {
     frameStartTime = std::chrono::steady_clock::now();
     lastFrameTime = frameStartTime;
-    
-    // フレームタイムバッファを初期化
-    frameTimes.clear();
-    frameTimes.resize(maxFrameSamples, 16.67f);  // 60FPS想定で初期化
+
+    // 計測中にメモリを確保しないように先に取っておく
+    samples.resize(kSampleCount);
+    sectionNames.reserve(kMaxSections);
 }
 
 void PerformanceMonitor::BeginFrame() {
@@ -36,20 +52,30 @@ void PerformanceMonitor::BeginFrame() {
 
 void PerformanceMonitor::EndFrame() {
     frameEndTime = std::chrono::steady_clock::now();
-    
+
     // フレーム時間を計算（ミリ秒）
     auto frameDuration = std::chrono::duration_cast<std::chrono::microseconds>(frameEndTime - lastFrameTime);
     float frameTimeMs = frameDuration.count() / 1000.0f;
-    
-    // フレームタイムをバッファに追加
-    frameTimes.push_back(frameTimeMs);
-    if (frameTimes.size() > maxFrameSamples) {
-        frameTimes.pop_front();
+
+    // リングバッファに書いてから番号を進める(読む側は進んだ番号の手前までしか読まない)
+    currentSample.frameTime = frameTimeMs;
+    uint32_t index = writeIndex.load(std::memory_order_relaxed);
+    samples[index & kSampleMask] = currentSample;
+    writeIndex.store(index + 1, std::memory_order_release);
+    currentSample.sectionTimes.fill(0.0f);
+
+    // 現在値と直近1秒の平均
+    currentFrameTime = frameTimeMs;
+    currentFPS = (frameTimeMs > 0.0f) ? 1000.0f / frameTimeMs : 0.0f;
+    std::array<float, kAverageFrames> recent;
+    uint32_t count = CollectSamples(kAverageFrames, recent.data(), [](const FrameSample& sample) { return sample.frameTime; });
+    float sum = 0.0f;
+    for (uint32_t i = 0; i < count; ++i) {
+        sum += recent[i];
     }
-    
-    // 統計情報を更新
-    UpdateStatistics();
-    
+    averageFrameTime = sum / count;
+    averageFPS = (averageFrameTime > 0.0f) ? 1000.0f / averageFrameTime : 0.0f;
+
     // フレームドロップ検出
     float targetFrameTime = 1000.0f / targetFPS;
     if (frameTimeMs > targetFrameTime * 1.5f) {  // 目標の1.5倍以上なら
@@ -58,48 +84,111 @@ void PerformanceMonitor::EndFrame() {
     } else {
         isFrameDropped = false;
     }
-    
+
     lastFrameTime = frameEndTime;
 }
 
-void PerformanceMonitor::BeginSection(const std::string& sectionName) {
-    sections[sectionName].startTime = std::chrono::steady_clock::now();
+PerformanceMonitor::SectionId PerformanceMonitor::RegisterSection(const std::string& sectionName) {
+    for (uint32_t i = 0; i < sectionNames.size(); ++i) {
+        if (sectionNames[i] == sectionName) {
+            return i;
+        }
+    }
+    if (sectionNames.size() >= kMaxSections) {
+        Logger::log("PerformanceMonitor: too many sections (" + sectionName + ")\n");
+        return kInvalidSection;
+    }
+    sectionNames.push_back(sectionName);
+    return static_cast<SectionId>(sectionNames.size() - 1);
 }
 
-void PerformanceMonitor::EndSection(const std::string& sectionName) {
-    auto endTime = std::chrono::steady_clock::now();
-    auto& section = sections[sectionName];
-    
-    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - section.startTime);
-    float timeMs = duration.count() / 1000.0f;
-    
-    section.totalTime += timeMs;
-    section.callCount++;
+void PerformanceMonitor::BeginSection(SectionId id) {
+    if (id >= kMaxSections) {
+        return;
+    }
+    sectionStartTimes[id] = std::chrono::steady_clock::now();
 }
 
-void PerformanceMonitor::UpdateStatistics() {
-    // 現在のフレーム時間とFPS
-    if (!frameTimes.empty()) {
-        currentFrameTime = frameTimes.back();
-        currentFPS = (currentFrameTime > 0.0f) ? 1000.0f / currentFrameTime : 0.0f;
-        
-        // 平均値を計算
-        float sumFrameTime = std::accumulate(frameTimes.begin(), frameTimes.end(), 0.0f);
-        averageFrameTime = sumFrameTime / frameTimes.size();
-        averageFPS = (averageFrameTime > 0.0f) ? 1000.0f / averageFrameTime : 0.0f;
+void PerformanceMonitor::EndSection(SectionId id) {
+    if (id >= kMaxSections) {
+        return;
     }
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - sectionStartTimes[id]);
+    currentSample.sectionTimes[id] += duration.count() / 1000.0f;
+}
+
+template<typename Getter>
+uint32_t PerformanceMonitor::CollectSamples(uint32_t count, float* out, Getter getter) const {
+    uint32_t end = writeIndex.load(std::memory_order_acquire);
+    count = (std::min)({ count, end, kMaxStatsSamples });
+    for (uint32_t i = 0; i < count; ++i) {
+        out[i] = getter(samples[(end - 1 - i) & kSampleMask]);
+    }
+    return count;
+}
+
+PerformanceMonitor::TimingStats PerformanceMonitor::GetFrameStats(uint32_t sampleCount) const {
+    std::array<float, kSampleCount> values;
+    uint32_t count = CollectSamples(sampleCount, values.data(), [](const FrameSample& sample) { return sample.frameTime; });
+    return ComputeStats(values.data(), count);
+}
+
+PerformanceMonitor::TimingStats PerformanceMonitor::GetSectionStats(SectionId id, uint32_t sampleCount) const {
+    if (id >= kMaxSections) {
+        return {};
+    }
+    std::array<float, kSampleCount> values;
+    uint32_t count = CollectSamples(sampleCount, values.data(), [id](const FrameSample& sample) { return sample.sectionTimes[id]; });
+    return ComputeStats(values.data(), count);
+}
+
+PerformanceMonitor::TimingStats PerformanceMonitor::ComputeStats(float* values, uint32_t count) {
+    TimingStats stats;
+    stats.sampleCount = count;
+    if (count == 0) {
+        return stats;
+    }
+    std::sort(values, values + count);
+
+    // 最近順位法(p%以上が収まる最小の値)
+    auto percentile = [values, count](uint32_t percent) {
+        uint32_t rank = (percent * count + 99) / 100;
+        return values[(std::max)(rank, 1u) - 1];
+    };
+    float sum = 0.0f;
+    for (uint32_t i = 0; i < count; ++i) {
+        sum += values[i];
+    }
+    stats.average = sum / count;
+    stats.p50 = percentile(50);
+    stats.p95 = percentile(95);
+    stats.p99 = percentile(99);
+    stats.max = values[count - 1];
+    return stats;
 }
 
 float PerformanceMonitor::GetMemoryUsageMB() const {
+#ifdef _WIN32
     PROCESS_MEMORY_COUNTERS_EX pmc;
     GetProcessMemoryInfo(GetCurrentProcess(), (PROCESS_MEMORY_COUNTERS*)&pmc, sizeof(pmc));
     return static_cast<float>(pmc.WorkingSetSize) / (1024.0f * 1024.0f);
+#else
+    // /proc/self/statmの2つ目が常駐ページ数
+    long pages = 0;
+    FILE* file = std::fopen("/proc/self/statm", "r");
+    if (file) {
+        long size = 0;
+        if (std::fscanf(file, "%ld %ld", &size, &pages) != 2) {
+            pages = 0;
+        }
+        std::fclose(file);
+    }
+    return static_cast<float>(pages) * static_cast<float>(sysconf(_SC_PAGESIZE)) / (1024.0f * 1024.0f);
+#endif
 }
 
 int PerformanceMonitor::GetCPUCoreCount() const {
-    SYSTEM_INFO sysInfo;
-    GetSystemInfo(&sysInfo);
-    return sysInfo.dwNumberOfProcessors;
+    return static_cast<int>(std::thread::hardware_concurrency());
 }
 
 std::string PerformanceMonitor::GetPerformanceStats() const {
@@ -107,40 +196,50 @@ std::string PerformanceMonitor::GetPerformanceStats() const {
     ss << std::fixed << std::setprecision(2);
     ss << "FPS: " << currentFPS << " (avg: " << averageFPS << ")\n";
     ss << "Frame Time: " << currentFrameTime << "ms (avg: " << averageFrameTime << "ms)\n";
+
+    TimingStats frame = GetFrameStats();
+    ss << "Frame p50/p95/p99/max: " << frame.p50 << " / " << frame.p95 << " / " << frame.p99 << " / " << frame.max
+        << "ms (" << frame.sampleCount << " frames)\n";
     ss << "Memory: " << GetMemoryUsageMB() << " MB\n";
     ss << "CPU Cores: " << GetCPUCoreCount() << "\n";
     ss << "Dropped Frames: " << droppedFrameCount << "\n";
-    
+
     // セクション別の計測結果
-    if (!sections.empty()) {
-        ss << "\n--- Section Timings ---\n";
-        for (const auto& section : sections) {
-            const std::string& name = section.first;
-            const SectionData& data = section.second;
-            if (data.callCount > 0) {
-                float avgTime = data.totalTime / data.callCount;
-                ss << name << ": " << avgTime << "ms (avg)\n";
-            }
+    if (!sectionNames.empty()) {
+        ss << "\n--- Section Timings (avg p50/p95/p99/max ms) ---\n";
+        for (SectionId id = 0; id < sectionNames.size(); ++id) {
+            TimingStats section = GetSectionStats(id);
+            ss << sectionNames[id] << ": " << section.average << " " << section.p50 << "/" << section.p95 << "/"
+                << section.p99 << "/" << section.max << "\n";
         }
     }
-    
+
     return ss.str();
 }
 
 void PerformanceMonitor::DrawDebugInfo() {
-    // ImGuiを使用する場合はここに実装
-    // 現在は未実装
+#ifdef USE_IMGUI
+    TimingStats frame = GetFrameStats();
+    ImGui::Text("FPS: %.1f (avg %.1f)  Dropped: %d", GetFPS(), GetAverageFPS(), GetDroppedFrameCount());
+    ImGui::Text("Frame p50 %.2f  p95 %.2f  p99 %.2f  max %.2f ms", frame.p50, frame.p95, frame.p99, frame.max);
+    for (SectionId id = 0; id < sectionNames.size(); ++id) {
+        TimingStats section = GetSectionStats(id);
+        ImGui::Text("%s: p50 %.2f  p95 %.2f  p99 %.2f  max %.2f ms", sectionNames[id].c_str(),
+            section.p50, section.p95, section.p99, section.max);
+    }
+    ImGui::Text("Memory: %.1f MB", GetMemoryUsageMB());
+#endif
 }
 
 void PerformanceMonitor::LogPerformance() const {
     static int logCounter = 0;
     logCounter++;
-    
+
     // 60フレームごとに（約1秒ごとに）ログ出力
     if (logCounter % 60 == 0) {
         std::string stats = GetPerformanceStats();
-        OutputDebugStringA("\n=== Performance Report ===\n");
-        OutputDebugStringA(stats.c_str());
-        OutputDebugStringA("========================\n");
+        Logger::log("\n=== Performance Report ===\n");
+        Logger::log(stats);
+        Logger::log("========================\n");
     }
 }
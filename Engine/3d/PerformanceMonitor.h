@@ -1,92 +1,132 @@
 #pragma once
+#include <array>
 #include <chrono>
-#include <deque>
+#include <cstdint>
 #include <string>
 #include <atomic>
-#include <unordered_map>
+#include <vector>
 
+// フレーム時間とセクション時間の計測
+// セクションは起動時にRegisterSectionで番号を取っておき、Begin/Endは番号で呼ぶ(文字列を毎回ハッシュしない)
+// 1フレーム分の結果はリングバッファに溜め、p50/p95/p99/maxで引っかかりを見る
+// Begin/End/BeginFrame/EndFrameはメインスレッドから、統計の取得はどのスレッドからでもよい
 class PerformanceMonitor {
 public:
+    using SectionId = uint32_t;
+
     static PerformanceMonitor* GetInstance();
     void Finalize();
-    
+
     // フレーム計測開始
     void BeginFrame();
-    
-    // フレーム計測終了
+
+    // フレーム計測終了(1フレーム分をリングバッファに書く)
     void EndFrame();
-    
-    // 特定セクションの計測開始
-    void BeginSection(const std::string& sectionName);
-    
-    // 特定セクションの計測終了
-    void EndSection(const std::string& sectionName);
-    
+
+    // セクションを登録して番号を返す(同じ名前なら同じ番号)。一杯ならkInvalidSection
+    SectionId RegisterSection(const std::string& sectionName);
+    const std::string& GetSectionName(SectionId id) const { return sectionNames[id]; }
+    uint32_t GetSectionCount() const { return static_cast<uint32_t>(sectionNames.size()); }
+
+    // 特定セクションの計測開始・終了(1フレームに何回呼んでもよい。合計を記録する)
+    void BeginSection(SectionId id);
+    void EndSection(SectionId id);
+
+    // 直近sampleCountフレーム分の統計(ミリ秒)
+    struct TimingStats {
+        float average = 0.0f;
+        float p50 = 0.0f;
+        float p95 = 0.0f;
+        float p99 = 0.0f;
+        float max = 0.0f;
+        uint32_t sampleCount = 0;
+    };
+    TimingStats GetFrameStats(uint32_t sampleCount = kMaxStatsSamples) const;
+    TimingStats GetSectionStats(SectionId id, uint32_t sampleCount = kMaxStatsSamples) const;
+
+    // valuesからパーセンタイル統計を出す(valuesは並べ替える)
+    static TimingStats ComputeStats(float* values, uint32_t count);
+
     // パフォーマンス情報取得
     float GetFPS() const { return currentFPS; }
     float GetFrameTime() const { return currentFrameTime; }
     float GetAverageFPS() const { return averageFPS; }
     float GetAverageFrameTime() const { return averageFrameTime; }
-    
+
     // メモリ使用量取得（MB）
     float GetMemoryUsageMB() const;
-    
+
     // CPUコア数取得
     int GetCPUCoreCount() const;
-    
+
     // パフォーマンス統計を文字列で取得
     std::string GetPerformanceStats() const;
-    
+
     // デバッグ表示用
     void DrawDebugInfo();
-    
+
     // パフォーマンスログ出力
     void LogPerformance() const;
-    
+
     // フレームドロップ検出
     bool IsFrameDropped() const { return isFrameDropped; }
     int GetDroppedFrameCount() const { return droppedFrameCount; }
-    
+
     // 目標FPS設定（デフォルト60）
     void SetTargetFPS(float fps) { targetFPS = fps; }
     float GetTargetFPS() const { return targetFPS; }
-    
+
+    static const uint32_t kMaxSections = 32;
+    static const SectionId kInvalidSection = UINT32_MAX;
+    // リングバッファのフレーム数(2のべき乗)
+    static const uint32_t kSampleCount = 1024;
+    // 統計に使う最大フレーム数(書き込み中の1つを除く)
+    static const uint32_t kMaxStatsSamples = kSampleCount - 1;
+
 private:
     PerformanceMonitor();
     ~PerformanceMonitor() = default;
     PerformanceMonitor(const PerformanceMonitor&) = delete;
     PerformanceMonitor& operator=(const PerformanceMonitor&) = delete;
-    
+
     static PerformanceMonitor* instance;
-    
+
+    // 1フレーム分の記録
+    struct FrameSample {
+        float frameTime = 0.0f;
+        std::array<float, kMaxSections> sectionTimes{};
+    };
+
+    // 直近count個の値をoutに集める(新しい方から)。集めた数を返す
+    template<typename Getter>
+    uint32_t CollectSamples(uint32_t count, float* out, Getter getter) const;
+
     // タイミング関連
     std::chrono::steady_clock::time_point frameStartTime;
     std::chrono::steady_clock::time_point frameEndTime;
     std::chrono::steady_clock::time_point lastFrameTime;
-    
-    // FPS計算用
-    std::deque<float> frameTimes;
-    const size_t maxFrameSamples = 60;  // 1秒分のサンプル
-    
+
+    // フレームの記録(EndFrameだけが書き、writeIndexを進めてから読める)
+    std::vector<FrameSample> samples;
+    std::atomic<uint32_t> writeIndex{0};
+    // 今フレームのセクション時間
+    FrameSample currentSample;
+
+    // 平均は直近60フレーム(1秒分)
+    static const uint32_t kAverageFrames = 60;
+
     // 現在のパフォーマンス値
     std::atomic<float> currentFPS{60.0f};
     std::atomic<float> currentFrameTime{16.67f};
     std::atomic<float> averageFPS{60.0f};
     std::atomic<float> averageFrameTime{16.67f};
-    
+
     // フレームドロップ検出
     std::atomic<bool> isFrameDropped{false};
     std::atomic<int> droppedFrameCount{0};
     float targetFPS = 60.0f;
-    
+
     // セクション計測用
-    struct SectionData {
-        std::chrono::steady_clock::time_point startTime;
-        float totalTime = 0.0f;
-        int callCount = 0;
-    };
-    std::unordered_map<std::string, SectionData> sections;
-    
-    // 統計更新
-    void UpdateStatistics();
+    std::vector<std::string> sectionNames;
+    std::array<std::chrono::steady_clock::time_point, kMaxSections> sectionStartTimes;
 };
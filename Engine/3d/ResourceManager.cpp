@@ -2,6 +2,7 @@
 #include "Engine/2d/TextureManager.h"
 #include "Engine/3d/ModelManager.h"
 #include "Engine/audio/Audio.h"
+#include "TraceRecorder.h"
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
@@ -86,7 +87,10 @@ void ResourceManager::StartBatchLoading() {
 }
 
 void ResourceManager::LoadingWorker() {
+    TraceRecorder::GetInstance()->SetThreadName("ResourceLoader");
+
     while (!shouldStopLoading) {
+        TRACE_SCOPE("ResourceManager::LoadResource");
         ResourceInfo info;
         
         // キューから次のリソースを取得
@@ -175,8 +179,8 @@ void ResourceManager::LoadModel(const std::string& path) {
 }
 
 void ResourceManager::LoadSound(const std::string& path) {
-    // Audioクラスを使用してロード
-    Audio::GetInstance()->LoadWave(path.c_str());
+    // 波形だけSoundBankに読み込んでおく(ボイスは使う側がLoadWaveで作る)
+    Audio::GetInstance()->PreloadWave(path.c_str());
     
     // メモリ使用量を推定
     size_t estimatedSize = EstimateResourceSize(path, ResourceType::Sound);
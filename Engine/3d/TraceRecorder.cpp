@@ -0,0 +1,118 @@
+#include "TraceRecorder.h"
+#include "Logger.h"
+#include <cstdio>
+
+TraceRecorder* TraceRecorder::instance = nullptr;
+std::atomic<bool> TraceRecorder::isEnabled_{ true };
+thread_local TraceRecorder::ThreadBuffer* TraceRecorder::threadBuffer_ = nullptr;
+thread_local const TraceRecorder* TraceRecorder::threadOwner_ = nullptr;
+
+namespace {
+	const uint64_t kEventMask = TraceRecorder::kEventsPerThread - 1;
+	static_assert((TraceRecorder::kEventsPerThread & kEventMask) == 0, "kEventsPerThread must be a power of two");
+
+	// JSONの文字列として書く
+	void WriteJsonString(FILE* file, const char* text) {
+		std::fputc('"', file);
+		for (const char* p = text; *p; ++p) {
+			if (*p == '"' || *p == '\\') {
+				std::fputc('\\', file);
+			}
+			std::fputc(static_cast<unsigned char>(*p) < 0x20 ? ' ' : *p, file);
+		}
+		std::fputc('"', file);
+	}
+}
+
+TraceRecorder* TraceRecorder::GetInstance() {
+	if (instance == nullptr) {
+		instance = new TraceRecorder();
+	}
+	return instance;
+}
+
+void TraceRecorder::Finalize() {
+	if (!exitDumpPath_.empty()) {
+		WriteChromeTrace(exitDumpPath_);
+	}
+	// 他のスレッドが残したバッファも一緒に消える(以後の記録は新しいインスタンスに入る)
+	delete instance;
+	instance = nullptr;
+}
+
+TraceRecorder::TraceRecorder() {
+	epoch_ = Now();
+}
+
+void TraceRecorder::SetThreadName(const std::string& name) {
+	ThreadBuffer* buffer = GetThreadBuffer();
+	std::lock_guard<std::mutex> lock(mutex_);
+	buffer->threadName = name;
+}
+
+TraceRecorder::ThreadBuffer* TraceRecorder::GetThreadBuffer() {
+	if (threadOwner_ == this) {
+		return threadBuffer_;
+	}
+
+	// スレッドで最初の1回だけ作る
+	std::unique_ptr<ThreadBuffer> buffer = std::make_unique<ThreadBuffer>();
+	buffer->events.resize(kEventsPerThread);
+	ThreadBuffer* result = buffer.get();
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		buffer->threadId = static_cast<uint32_t>(buffers_.size() + 1);
+		buffer->threadName = "Thread " + std::to_string(buffer->threadId);
+		buffers_.push_back(std::move(buffer));
+	}
+	threadBuffer_ = result;
+	threadOwner_ = this;
+	return result;
+}
+
+void TraceRecorder::Record(const char* name, int64_t startNanoseconds, int64_t endNanoseconds) {
+	ThreadBuffer* buffer = GetThreadBuffer();
+	// 書いてから数を進める(書き出し側は進んだ数の手前までしか読まない)
+	uint64_t index = buffer->writeCount.load(std::memory_order_relaxed);
+	buffer->events[index & kEventMask] = { name, startNanoseconds, endNanoseconds - startNanoseconds };
+	buffer->writeCount.store(index + 1, std::memory_order_release);
+}
+
+bool TraceRecorder::WriteChromeTrace(const std::string& filePath) const {
+	FILE* file = std::fopen(filePath.c_str(), "w");
+	if (!file) {
+		Logger::log("TraceRecorder: failed to open " + filePath + "\n");
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	size_t eventCount = 0;
+	bool isFirst = true;
+	std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+	for (const std::unique_ptr<ThreadBuffer>& buffer : buffers_) {
+		// スレッド名
+		std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+			isFirst ? "" : ",\n", buffer->threadId);
+		WriteJsonString(file, buffer->threadName.c_str());
+		std::fputs("}}", file);
+		isFirst = false;
+
+		// 今書かれているかもしれない一番古い1つは飛ばす
+		uint64_t end = buffer->writeCount.load(std::memory_order_acquire);
+		uint64_t begin = end > kEventsPerThread - 1 ? end - (kEventsPerThread - 1) : 0;
+		for (uint64_t i = begin; i < end; ++i) {
+			const TraceEvent& event = buffer->events[i & kEventMask];
+			std::fputs(",\n{\"name\":", file);
+			WriteJsonString(file, event.name);
+			std::fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", buffer->threadId,
+				static_cast<double>(event.start - epoch_) / 1000.0, static_cast<double>(event.duration) / 1000.0);
+			eventCount++;
+		}
+	}
+	std::fputs("\n]}\n", file);
+	bool isOk = std::ferror(file) == 0;
+	std::fclose(file);
+
+	Logger::log("TraceRecorder: wrote " + std::to_string(eventCount) + " events to " + filePath + "\n");
+	return isOk;
+}
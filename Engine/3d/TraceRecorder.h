@@ -0,0 +1,97 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// 区間の開始・終了をスレッドごとのリングバッファに記録し、Chrome Trace Event形式(JSON)で書き出す
+// chrome://tracing や ui.perfetto.dev で開ける。引っかかったフレームの中で何が起きていたかを見る用
+// 記録はTRACE_SCOPEで行う。名前は文字列リテラル(ポインタをそのまま持つ)
+class TraceRecorder {
+public:
+	static TraceRecorder* GetInstance();
+	// exitDumpPathが設定されていれば書き出してから破棄する
+	void Finalize();
+
+	// 記録のオン・オフ(オフの間のTRACE_SCOPEは時刻も取らない)
+	static void SetEnabled(bool enabled) { isEnabled_.store(enabled, std::memory_order_relaxed); }
+	static bool IsEnabled() { return isEnabled_.load(std::memory_order_relaxed); }
+
+	// 今のスレッドの表示名
+	void SetThreadName(const std::string& name);
+	// 終了時に書き出すファイル(空なら書き出さない)
+	void SetExitDumpPath(const std::string& filePath) { exitDumpPath_ = filePath; }
+
+	// 今のスレッドのバッファに1区間書く
+	void Record(const char* name, int64_t startNanoseconds, int64_t endNanoseconds);
+
+	// 全スレッドの残っている区間を書き出す(記録中に呼んでもよい)
+	bool WriteChromeTrace(const std::string& filePath) const;
+
+	static int64_t Now() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	// 1スレッドが覚えておく区間の数(2のべき乗)。溢れたら古いものから上書き
+	static const uint32_t kEventsPerThread = 16384;
+
+private:
+	TraceRecorder();
+	~TraceRecorder() = default;
+	TraceRecorder(const TraceRecorder&) = delete;
+	TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+	static TraceRecorder* instance;
+	static std::atomic<bool> isEnabled_;
+
+	struct TraceEvent {
+		const char* name;
+		int64_t start;
+		int64_t duration;
+	};
+
+	// 1スレッド分。書くのはそのスレッドだけ。スレッドが終わっても書き出しまで残す
+	struct ThreadBuffer {
+		uint32_t threadId = 0;
+		std::string threadName;
+		std::vector<TraceEvent> events;
+		std::atomic<uint64_t> writeCount{ 0 };
+	};
+
+	// 今のスレッドのバッファ(無ければ作る)
+	ThreadBuffer* GetThreadBuffer();
+
+	// スレッドごとのバッファと、それを作ったインスタンス(Finalize後に作り直されたら別物として扱う)
+	static thread_local ThreadBuffer* threadBuffer_;
+	static thread_local const TraceRecorder* threadOwner_;
+
+	mutable std::mutex mutex_;
+	std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+	int64_t epoch_ = 0;
+	std::string exitDumpPath_;
+};
+
+// 生きている間を1区間として記録する
+class TraceScope {
+public:
+	explicit TraceScope(const char* name) : name_(name), start_(TraceRecorder::IsEnabled() ? TraceRecorder::Now() : -1) {}
+	~TraceScope() {
+		if (start_ >= 0) {
+			TraceRecorder::GetInstance()->Record(name_, start_, TraceRecorder::Now());
+		}
+	}
+	TraceScope(const TraceScope&) = delete;
+	TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+	const char* name_;
+	int64_t start_;
+};
+
+#define TRACE_SCOPE_CONCAT_INNER(a, b) a##b
+#define TRACE_SCOPE_CONCAT(a, b) TRACE_SCOPE_CONCAT_INNER(a, b)
+// このスコープの終わりまでをnameとして記録する
+#define TRACE_SCOPE(name) TraceScope TRACE_SCOPE_CONCAT(traceScope_, __LINE__)(name)
@@ -1,9 +1,19 @@
 #include "Framework.h"
 #include "ResourceManager.h"
 #include "PerformanceMonitor.h"
+#include "TraceRecorder.h"
+#include "GameTimer.h"
+#include "GameRandom.h"
+#include <chrono>
 
 void Framework::Initialize() {
 
+	TraceRecorder::GetInstance()->SetThreadName("Main");
+#ifdef _DEBUG
+	// デバッグ時は終了時に直近の区間をtrace.jsonに書き出す(chrome://tracingで開く)
+	TraceRecorder::GetInstance()->SetExitDumpPath("trace.json");
+#endif
+
 	winApp_ = new WinApp();
 	winApp_->Initialize();
 
@@ -58,22 +68,14 @@ void Framework::Initialize() {
 }
 
 void Framework::Update() {
-	// パフォーマンス計測開始
-	PerformanceMonitor::GetInstance()->BeginFrame();
-	
-	if (winApp_->ProcessMessage()) {
-		isRequst = true;
-	}
-	else {
-		//ゲームの処理
-		input_->Update();
-		
-		// フェードマネージャーの更新
-		FadeManager::GetInstance()->Update();
-	}
-	
-	// パフォーマンス計測終了
-	PerformanceMonitor::GetInstance()->EndFrame();
+	TRACE_SCOPE("Framework::Update");
+
+	//ゲームの処理(1tick分)
+	input_->Update();
+	audio_->Update();
+
+	// フェードマネージャーの更新
+	FadeManager::GetInstance()->Update();
 }
 
 void Framework::Finalize() {
@@ -113,6 +115,12 @@ void Framework::Finalize() {
 	
 	// パフォーマンスモニターの終了処理
 	PerformanceMonitor::GetInstance()->Finalize();
+
+	GameTimer::GetInstance()->Finalize();
+	GameRandom::GetInstance()->Finalize();
+
+	// 区間の書き出し(ResourceManagerのスレッドが終わった後)
+	TraceRecorder::GetInstance()->Finalize();
 }
 
 
@@ -121,17 +129,45 @@ void Framework::Run() {
 	//ゲーム初期化
 	Initialize();
 
+	// 最初のフレームは必ず1回更新してから描く
+	GameTimer* gameTimer = GameTimer::GetInstance();
+	gameTimer->Advance(gameTimer->GetDeltaTime());
+	std::chrono::steady_clock::time_point previousTime = std::chrono::steady_clock::now();
+
 	//ウィンドウの×ボタンが押されるまでループ
 	while (true) {
-		//毎フレーム更新
-		Update();
+		// パフォーマンス計測開始
+		PerformanceMonitor::GetInstance()->BeginFrame();
+
+		if (winApp_->ProcessMessage()) {
+			isRequst = true;
+		}
+
+		// 前の描画からの時間分だけ固定間隔で更新する(描画が速くても遅くてもゲームは同じ速さで進む)
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		gameTimer->Advance(std::chrono::duration<double>(now - previousTime).count());
+		previousTime = now;
+		while (!IsEndRequst() && gameTimer->Step()) {
+			Update();
+		}
 
 		//終了リクエスト
 		if (IsEndRequst()) {
 			break;
 		}
+
+#ifdef  USE_IMGUI
+		// ImGuiはtickの回数によらず描画1回につき1回だけ組み立てる
+		ImGuiManager::GetInstance()->Begin();
+		UpdateImGui();
+		ImGuiManager::GetInstance()->End();
+#endif //  USE_IMGUI
+
 		//描画処理
 		Draw();
+
+		// パフォーマンス計測終了
+		PerformanceMonitor::GetInstance()->EndFrame();
 	}
 
 	//ゲーム処理
@@ -21,6 +21,8 @@ class Framework{
 public:
 	virtual void Initialize();
 	virtual void Update();
+	// デバッグ表示(描画1回につき1回、Drawの前に呼ばれる)
+	virtual void UpdateImGui() {}
 	virtual void Draw() = 0;
 	virtual void Finalize();
 	virtual bool IsEndRequst() { return isRequst; }
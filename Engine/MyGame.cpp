@@ -1,4 +1,6 @@
 #include "MyGame.h"
+#include "PerformanceMonitor.h"
+#include "TraceRecorder.h"
 
 void MyGame::Initialize() {
 
@@ -6,29 +8,33 @@ void MyGame::Initialize() {
 
 	gameScene = new GameManager();
 	gameScene->Initialize();
+
+	updateSection_ = PerformanceMonitor::GetInstance()->RegisterSection("SceneUpdate");
+	drawSection_ = PerformanceMonitor::GetInstance()->RegisterSection("SceneDraw");
 }
 
 void MyGame::Update() {
 
 	Framework::Update();
 
-#ifdef  USE_IMGUI
-	ImGuiManager::GetInstance()->Begin();
-#endif //  USE_IMGUI
-
+	PerformanceMonitor::GetInstance()->BeginSection(updateSection_);
 	gameScene->Update();
+	PerformanceMonitor::GetInstance()->EndSection(updateSection_);
+}
 
-#ifdef  USE_IMGUI
-	ImGuiManager::GetInstance()->End();
-#endif //  USE_IMGUI
-
+void MyGame::UpdateImGui() {
+	gameScene->UpdateImGui();
 }
 
 void MyGame::Draw() {
+	TRACE_SCOPE("MyGame::Draw");
+
 	//描画開始
 	DirectXCommon::GetInstance()->PreDraw();
 
+	PerformanceMonitor::GetInstance()->BeginSection(drawSection_);
 	gameScene->Draw();
+	PerformanceMonitor::GetInstance()->EndSection(drawSection_);
 
 	// フェードの描画（全ての描画の一番上から）
 	SpriteCommon::GetInstance()->Command(); //Sprite描画にする
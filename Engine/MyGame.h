@@ -7,8 +7,13 @@ public:
 	void Initialize() override;
 	void Finalize() override;
 	void Update() override;
+	void UpdateImGui() override;
 	void Draw() override;
 
 private:
 	GameManager* gameScene = nullptr;
+
+	// 計測セクション
+	uint32_t updateSection_ = 0;
+	uint32_t drawSection_ = 0;
 };
\ No newline at end of file
@@ -1,4 +0,0 @@
-
-namespace ParticleNum {
-	inline uint32_t number = 0;
-}
@@ -1,7 +1,40 @@
 #include "Audio.h"
+#include <cstring>
+#include <string>
 
 Audio* Audio::instance = nullptr;
 
+// BGM用のボイス。鳴らし終わったチャンクをコールバックでMusicStreamに返す
+class MusicVoice : public MusicSink, public IXAudio2VoiceCallback {
+public:
+	IXAudio2SourceVoice* voice = nullptr;
+
+	void Submit(MusicStream& stream, const uint8_t* data, uint32_t size, uint32_t chunkIndex, bool isLast) override {
+		stream_ = &stream;
+		XAUDIO2_BUFFER buf{};
+		buf.pAudioData = data;
+		buf.AudioBytes = size;
+		buf.pContext = reinterpret_cast<void*>(static_cast<uintptr_t>(chunkIndex));
+		if (isLast) {
+			buf.Flags = XAUDIO2_END_OF_STREAM;
+		}
+		voice->SubmitSourceBuffer(&buf);
+	}
+
+	void STDMETHODCALLTYPE OnBufferEnd(void* context) override {
+		stream_->ReleaseChunk(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(context)));
+	}
+	void STDMETHODCALLTYPE OnVoiceProcessingPassStart(UINT32) override {}
+	void STDMETHODCALLTYPE OnVoiceProcessingPassEnd() override {}
+	void STDMETHODCALLTYPE OnStreamEnd() override {}
+	void STDMETHODCALLTYPE OnBufferStart(void*) override {}
+	void STDMETHODCALLTYPE OnLoopEnd(void*) override {}
+	void STDMETHODCALLTYPE OnVoiceError(void*, HRESULT) override {}
+
+private:
+	MusicStream* stream_ = nullptr;
+};
+
 Audio* Audio::GetInstance() {
 	if (instance == nullptr) {
 		instance = new Audio();
@@ -9,105 +42,180 @@ Audio* Audio::GetInstance() {
 	return instance;
 }
 
-void Audio::Finalize() {
-	xAudio2.Reset();
-	SoundUnload(&soundData_);
-}
+namespace {
 
-void Audio::Initialize() {
-
-	result = XAudio2Create(&xAudio2, 0, XAUDIO2_DEFAULT_PROCESSOR);
-	result = xAudio2->CreateMasteringVoice(&masterVoice);
-
-}
-
-SoundData Audio::LoadWave(const char* filename) {
-	soundData_ = SoundLoadWave(filename);
-	return soundData_;
-}
+// SoundMixerのボイス。鳴らす音のフォーマットが変わったときだけ作り直す
+class XAudio2MixerBackend : public MixerBackend {
+public:
+	explicit XAudio2MixerBackend(IXAudio2* xAudio2) : xAudio2_(xAudio2) {}
 
-SoundData Audio::SoundLoadWave(const char* filename)//string?
-{
-	//ファイルオープン
-	//file入力ストリームのインスタンス
-	std::ifstream file;
-	//wavファイルをバイナリモードで開く
-	file.open(filename, std::ios_base::binary);
-
-	assert(file.is_open());
+	~XAudio2MixerBackend() {
+		for (Slot& slot : slots_) {
+			if (slot.voice) {
+				slot.voice->DestroyVoice();
+			}
+		}
+	}
 
-	//wavデータ読み込み
-	//RIFFヘッダー読み込み
-	RiffHeader riff;
-	file.read((char*)&riff, sizeof(riff));
+	void StartVoice(uint32_t voiceIndex, const SoundBuffer& sound, float volume) override {
+		Slot& slot = slots_[voiceIndex];
+		if (slot.voice && slot.format == sound.format) {
+			slot.voice->Stop();
+			slot.voice->FlushSourceBuffers();
+		}
+		else {
+			if (slot.voice) {
+				slot.voice->DestroyVoice();
+			}
+			HRESULT hr = xAudio2_->CreateSourceVoice(&slot.voice, reinterpret_cast<const WAVEFORMATEX*>(sound.format.data()));
+			assert(SUCCEEDED(hr));
+			slot.format = sound.format;
+		}
+
+		XAUDIO2_BUFFER buf{};
+		buf.pAudioData = sound.data;
+		buf.AudioBytes = sound.dataSize;
+		buf.Flags = XAUDIO2_END_OF_STREAM;
+		slot.voice->SetVolume(volume);
+		slot.voice->SubmitSourceBuffer(&buf);
+		slot.voice->Start();
+	}
 
-	//ファイルがRIFFであるか
-	if (strncmp(riff.chunk.id, "RIFF", 4) != 0) {
-		assert(0);
+	void StopVoice(uint32_t voiceIndex) override {
+		Slot& slot = slots_[voiceIndex];
+		if (slot.voice) {
+			slot.voice->Stop();
+			slot.voice->FlushSourceBuffers();
+		}
 	}
 
-	//パスがWAVEであるか
-	if (strncmp(riff.type, "WAVE", 4) != 0) {
-		assert(0);
+	bool IsVoicePlaying(uint32_t voiceIndex) override {
+		Slot& slot = slots_[voiceIndex];
+		if (!slot.voice) {
+			return false;
+		}
+		XAUDIO2_VOICE_STATE state;
+		slot.voice->GetState(&state, XAUDIO2_VOICE_NOSAMPLESPLAYED);
+		return state.BuffersQueued > 0;
 	}
 
-	//Formatチャンク読み込み
-	FormatChunk format = {};
+private:
+	struct Slot {
+		IXAudio2SourceVoice* voice = nullptr;
+		std::vector<uint8_t> format;
+	};
 
-	//チャンクヘッダー確認
-	file.read((char*)&format, sizeof(ChunkHeader));
-	if (strncmp(format.chunk.id, "fmt ", 4) != 0) {
-		assert(0);
-	}
+	IXAudio2* xAudio2_;
+	Slot slots_[SoundMixer::kVoiceCount];
+};
 
-	//チャンク本体読み込み
-	assert(format.chunk.size <= sizeof(format.fmt));
-	file.read((char*)&format.fmt, format.chunk.size);
+}
 
-	//Dataチャンク読み込み
-	ChunkHeader data;
-	file.read((char*)&data, sizeof(data));
+MixerBackend* Audio::CreateMixerBackend() {
+	return new XAudio2MixerBackend(xAudio2.Get());
+}
 
-	//JUNKチャンクの場合
-	if (strncmp(data.id, "JUNK", 4) == 0) {
-		file.seekg(data.size, std::ios_base::cur);
-		file.read((char*)&data, sizeof(data));
+void Audio::Finalize() {
+	StopMusic();
+	mixer_.Finalize();
+	delete mixerBackend_;
+	mixerBackend_ = nullptr;
+	for (RetiredVoice& retired : retiredVoices_) {
+		retired.voice->DestroyVoice();
 	}
+	retiredVoices_.clear();
+	xAudio2.Reset();
+	soundBank_.Clear();
+}
 
-	if (strncmp(data.id, "LIST", 4) == 0) {
-		file.seekg(data.size, std::ios_base::cur);
-		file.read((char*)&data, sizeof(data));
-	}
-	
-	if (strncmp(data.id, "data", 4) != 0) {
-		assert(0);
-	}
+void Audio::Initialize() {
 
+	result = XAudio2Create(&xAudio2, 0, XAUDIO2_DEFAULT_PROCESSOR);
+	result = xAudio2->CreateMasteringVoice(&masterVoice);
 
+	mixerBackend_ = CreateMixerBackend();
+	mixer_.Initialize(mixerBackend_);
+}
 
-	//波形データ読み込み
-	char* pBuffer = new char[data.size];
-	file.read(pBuffer, data.size);
+void Audio::Update() {
+	mixer_.Update();
+}
+
+const SoundBuffer* Audio::LoadSE(const char* filename) {
+	const SoundBuffer* sound = soundBank_.Acquire(filename);
+	assert(sound);
+	return sound;
+}
+
+void Audio::UnloadSE(const SoundBuffer*& sound) {
+	mixer_.StopSound(sound);
+	soundBank_.Release(sound);
+	sound = nullptr;
+}
 
-	//Waveファイルを閉じる
-	file.close();
+SoundData Audio::LoadWave(const char* filename) {
+	DestroyFinishedVoices();
 
+	const SoundBuffer* buffer = soundBank_.Acquire(filename);
+	assert(buffer);
 
 	//全てまとめる
 	SoundData soundData = {};
+	std::memcpy(&soundData.wfex, buffer->format.data(), sizeof(WAVEFORMATEX));
+	soundData.pBuffer = buffer->data;
+	soundData.byfferSize = buffer->dataSize;
+	soundData.source = buffer;
 
-	soundData.wfex = format.fmt;
-	soundData.pBuffer = reinterpret_cast<BYTE*>(pBuffer);
-	soundData.byfferSize = data.size;
-
-	result = xAudio2.Get()->CreateSourceVoice(&soundData.pSourceVoice, &soundData.wfex);
+	// WAVEFORMATEXTENSIBLEもそのまま渡す
+	result = xAudio2.Get()->CreateSourceVoice(&soundData.pSourceVoice, reinterpret_cast<const WAVEFORMATEX*>(buffer->format.data()));
 	assert(SUCCEEDED(result));
 
 	return soundData;
 }
 
+void Audio::UnloadWave(SoundData& soundData) {
+	DestroyFinishedVoices();
+
+	if (soundData.pSourceVoice) {
+		// シーン切り替え直前の決定音などは鳴り終わるまで残す(波形の参照もそれまで持つ)
+		XAUDIO2_VOICE_STATE state;
+		soundData.pSourceVoice->GetState(&state, XAUDIO2_VOICE_NOSAMPLESPLAYED);
+		if (state.BuffersQueued > 0) {
+			retiredVoices_.push_back({ soundData.pSourceVoice, soundData.source });
+			soundData = {};
+			return;
+		}
+		soundData.pSourceVoice->DestroyVoice();
+	}
+	soundBank_.Release(soundData.source);
+	soundData = {};
+}
+
+void Audio::DestroyFinishedVoices() {
+	for (size_t i = 0; i < retiredVoices_.size();) {
+		XAUDIO2_VOICE_STATE state;
+		retiredVoices_[i].voice->GetState(&state, XAUDIO2_VOICE_NOSAMPLESPLAYED);
+		if (state.BuffersQueued > 0) {
+			++i;
+			continue;
+		}
+		retiredVoices_[i].voice->DestroyVoice();
+		soundBank_.Release(retiredVoices_[i].source);
+		retiredVoices_[i] = retiredVoices_.back();
+		retiredVoices_.pop_back();
+	}
+}
+
+bool Audio::PreloadWave(const char* filename) {
+	return soundBank_.Preload(filename);
+}
+
 
 void Audio::SoundPlayWave(SoundData soundData,const float volume, bool isLoop) {
+	// UnloadWave済み
+	if (!soundData.pSourceVoice) {
+		return;
+	}
 
 	//波状データを読み込む
 	XAUDIO2_BUFFER buf{};
@@ -129,15 +237,50 @@ void Audio::SoundPlayWave(SoundData soundData,const float volume, bool isLoop) {
 }
 
 
-void Audio::SoundUnload(SoundData* soundData) {
-	delete[] soundData->pBuffer; //newしたため（波形データ読み込み）
-
-	soundData->pBuffer = 0;
-	soundData->byfferSize = 0;
-	soundData->wfex = {};
-}
-
 void Audio::StopWave(SoundData soundData) {
+	if (!soundData.pSourceVoice) {
+		return;
+	}
 	result = soundData.pSourceVoice->Stop(); //音源を止める
 	result = soundData.pSourceVoice->FlushSourceBuffers(); //音源のリセット
-}
\ No newline at end of file
+}
+
+
+void Audio::PlayMusic(const char* filename, const float volume, bool isLoop) {
+	StopMusic();
+
+	// ヘッダーだけ先に読む
+	music_ = new MusicStream();
+	if (!music_->Open(filename)) {
+		OutputDebugStringA((std::string("Audio::PlayMusic: failed to open ") + filename + "\n").c_str());
+		delete music_;
+		music_ = nullptr;
+		return;
+	}
+
+	musicVoice_ = new MusicVoice();
+	const WAVEFORMATEX* wfex = reinterpret_cast<const WAVEFORMATEX*>(music_->GetFormat().data());
+	result = xAudio2->CreateSourceVoice(&musicVoice_->voice, wfex, 0, XAUDIO2_DEFAULT_FREQ_RATIO, musicVoice_);
+	assert(SUCCEEDED(result));
+
+	// 最初のチャンクが届いた時点で鳴り始める
+	result = musicVoice_->voice->SetVolume(volume);
+	result = musicVoice_->voice->Start();
+	music_->Start(*musicVoice_, isLoop);
+}
+
+void Audio::StopMusic() {
+	if (!music_) {
+		return;
+	}
+	// 先に読み込みスレッドを止めてからボイスを消す(DestroyVoiceはコールバックが終わるまで待つ)
+	music_->Stop();
+	musicVoice_->voice->Stop();
+	musicVoice_->voice->FlushSourceBuffers();
+	musicVoice_->voice->DestroyVoice();
+
+	delete musicVoice_;
+	musicVoice_ = nullptr;
+	delete music_;
+	music_ = nullptr;
+}
@@ -7,31 +7,24 @@
 //ComPtr
 #include <wrl.h>
 #include <cassert>
+#include "SoundBank.h"
+#include "MusicStream.h"
+#include "SoundMixer.h"
 
-struct ChunkHeader {
-	char id[4];//チャンク毎ID
-	int32_t size;//サイズ
-};
-
-struct RiffHeader {
-	ChunkHeader chunk;//RIFF
-	char type[4];//WAVE
-};
-
-struct FormatChunk {
-	ChunkHeader chunk;
-	WAVEFORMATEX fmt;
-};
+class MusicVoice;
 
+// 再生用のハンドル。波形はSoundBankのものを共有し、ここではボイスだけを持つ
 struct SoundData {
 	//波形フォーマット
 	WAVEFORMATEX wfex;
-	//バッファ先頭
-	BYTE* pBuffer;
+	//バッファ先頭(SoundBankが持っている)
+	const BYTE* pBuffer;
 	//サイズ
 	unsigned int byfferSize;
 	//ソースボイス
 	IXAudio2SourceVoice* pSourceVoice = nullptr;
+	//共有している波形
+	const SoundBuffer* source = nullptr;
 };
 
 class Audio{
@@ -41,13 +34,40 @@ public:
 
 	void Initialize();
 	void Finalize();
+	// 毎フレーム最初に呼ぶ(鳴り終わった効果音のボイスを空ける)
+	void Update();
 
+	// 波形は同じパスなら1回だけ読み込み、呼ぶたびにボイスだけを作る
 	SoundData LoadWave(const char* filename);
+	// LoadWaveで作ったボイスを消して波形の参照を返す
+	void UnloadWave(SoundData& soundData);
+	// 波形だけ先に読み込んでおく(ボイスは作らない。次のシーン切り替えまでに参照されなければ捨てられる)
+	bool PreloadWave(const char* filename);
+	// どこからも使われていない波形を捨てる(シーン切り替えのたびにGameManagerが呼ぶ)
+	void ReleaseUnusedWaves() { soundBank_.ReleaseUnused(); }
+
+	const SoundBank& GetSoundBank() const { return soundBank_; }
 
 	//音声再生
 	void SoundPlayWave(SoundData soundData, const float volume, bool isLoop = false);
 	void StopWave(SoundData soundData);
 
+	// 効果音はミキサーのボイスを使い回す(ボイス数と1フレームに同じ音を鳴らす数に上限がある)
+	const SoundBuffer* LoadSE(const char* filename);
+	// 鳴っている分を止めて波形の参照を返す
+	void UnloadSE(const SoundBuffer*& sound);
+	// priorityが高いほど他の音に奪われにくい
+	void PlaySE(const SoundBuffer* sound, const float volume, int priority = 0) { mixer_.Play(sound, volume, priority); }
+	// 位置付き。リスナーから遠いほど奪われやすい
+	void PlaySE3D(const SoundBuffer* sound, const float volume, int priority, const Vector3& position) { mixer_.Play3D(sound, volume, priority, position); }
+	void SetListenerPosition(const Vector3& position) { mixer_.SetListenerPosition(position); }
+	const SoundMixer& GetMixer() const { return mixer_; }
+
+	// BGMはファイルを丸ごと読まず、少しずつ読みながら鳴らす(同時に鳴らすのは1曲だけ)
+	void PlayMusic(const char* filename, const float volume, bool isLoop = true);
+	void StopMusic();
+	bool IsMusicPlaying() const { return music_ != nullptr; }
+
 private:
 
 	static Audio* instance;
@@ -57,15 +77,29 @@ private:
 	Audio(Audio&) = default;
 	Audio& operator=(Audio&) = default;
 
-	SoundData SoundLoadWave(const char* filename);//string?
+	// 再生が終わったボイスを消す
+	void DestroyFinishedVoices();
 
-	//音声データの解放 delete
-	void SoundUnload(SoundData* soundData);
+	// 効果音を鳴らす先を作る(Audio.cppはXAudio2、ヘッドレスのNullAudio.cppは音を出さないもの)
+	MixerBackend* CreateMixerBackend();
 
+	// 読み込んだ波形(パスごとに1つ)
+	SoundBank soundBank_;
 
+	// UnloadWaveの時点でまだ鳴っていたボイス(鳴り終わったら消す)
+	struct RetiredVoice {
+		IXAudio2SourceVoice* voice;
+		const SoundBuffer* source;
+	};
+	std::vector<RetiredVoice> retiredVoices_;
 
+	// 効果音
+	SoundMixer mixer_;
+	MixerBackend* mixerBackend_ = nullptr;
 
-	SoundData soundData_;
+	// 再生中のBGM
+	MusicStream* music_ = nullptr;
+	MusicVoice* musicVoice_ = nullptr;
 
 	//audio
 	Microsoft::WRL::ComPtr<IXAudio2> xAudio2;
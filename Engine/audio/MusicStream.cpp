@@ -0,0 +1,178 @@
+#include "MusicStream.h"
+#include "SoundBank.h"
+#include "WaveParser.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+	// WAVEFORMATEX::nBlockAlignの位置
+	const size_t kBlockAlignOffset = 12;
+}
+
+void NullMusicSink::Submit(MusicStream& stream, const uint8_t* data, uint32_t size, uint32_t chunkIndex, bool isLast) {
+	hash_ = Hash(data, size, hash_);
+	receivedBytes_ += size;
+	receivedChunkCount_++;
+	if (isLast) {
+		isEnded_ = true;
+	}
+	stream.ReleaseChunk(chunkIndex);
+}
+
+uint64_t NullMusicSink::Hash(const uint8_t* data, size_t size, uint64_t hash) {
+	for (size_t i = 0; i < size; ++i) {
+		hash ^= data[i];
+		hash *= 0x100000001B3ull;
+	}
+	return hash;
+}
+
+MusicStream::~MusicStream() {
+	Stop();
+}
+
+bool MusicStream::Open(const std::string& filePath) {
+	// ヘッダーはマップして調べる(触るのは先頭のページだけなので波形は読まない)
+	{
+		MappedFile mappedFile;
+		if (!mappedFile.Open(filePath)) {
+			return false;
+		}
+		WaveView view;
+		if (WaveParser::Parse(mappedFile.GetData(), mappedFile.GetSize(), view) != WaveParseResult::Ok || view.dataSize == 0) {
+			return false;
+		}
+		WaveParser::CopyFormat(view, format_);
+		dataOffset_ = static_cast<std::streamoff>(view.dataOffset);
+		dataSize_ = view.dataSize;
+	}
+
+	// チャンクの切れ目がサンプルの途中にならないようにする
+	uint16_t blockAlign = 0;
+	std::memcpy(&blockAlign, format_.data() + kBlockAlignOffset, sizeof(blockAlign));
+	if (blockAlign == 0 || blockAlign > kChunkSize) {
+		return false;
+	}
+	chunkBytes_ = kChunkSize - kChunkSize % blockAlign;
+	position_ = 0;
+
+	file_.open(filePath, std::ios_base::binary);
+	return file_.is_open();
+}
+
+void MusicStream::Start(MusicSink& sink, bool isLoop) {
+	Stop();
+
+	sink_ = &sink;
+	isLoop_ = isLoop;
+	ring_.resize(GetBufferBytes());
+	freeChunkCount_ = kChunkCount;
+	nextChunk_ = 0;
+	stopRequested_ = false;
+	decodedBytes_ = 0;
+	isDecoding_ = true;
+
+	file_.clear();
+	file_.seekg(dataOffset_);
+	position_ = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	thread_ = std::thread([this, start]() {
+		DecodeLoop(start);
+		isDecoding_ = false;
+	});
+}
+
+void MusicStream::Stop() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stopRequested_ = true;
+	}
+	chunkReleased_.notify_all();
+	if (thread_.joinable()) {
+		thread_.join();
+	}
+	sink_ = nullptr;
+}
+
+void MusicStream::WaitForEnd() {
+	if (thread_.joinable()) {
+		thread_.join();
+	}
+}
+
+void MusicStream::ReleaseChunk(uint32_t chunkIndex) {
+	(void)chunkIndex; // チャンクは渡した順に返ってくる
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		freeChunkCount_++;
+	}
+	chunkReleased_.notify_one();
+}
+
+void MusicStream::DecodeLoop(std::chrono::steady_clock::time_point start) {
+	bool isFirst = true;
+	while (true) {
+		uint32_t chunkIndex;
+		{
+			// 空いているチャンクが出るまで待つ
+			std::unique_lock<std::mutex> lock(mutex_);
+			chunkReleased_.wait(lock, [this]() { return stopRequested_ || freeChunkCount_ > 0; });
+			if (stopRequested_) {
+				return;
+			}
+			chunkIndex = nextChunk_;
+			nextChunk_ = (nextChunk_ + 1) % kChunkCount;
+			freeChunkCount_--;
+		}
+
+		uint8_t* chunk = ring_.data() + static_cast<size_t>(chunkIndex) * kChunkSize;
+		uint32_t size = ReadChunk(chunk);
+		if (isFirst) {
+			// 鳴り始めるまでの遅れ
+			firstChunkMilliseconds_ = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			isFirst = false;
+		}
+		if (size == 0) {
+			return;
+		}
+		decodedBytes_ += size;
+
+		bool isLast = !isLoop_ && position_ >= dataSize_;
+		sink_->Submit(*this, chunk, size, chunkIndex, isLast);
+		if (isLast) {
+			return;
+		}
+	}
+}
+
+uint32_t MusicStream::ReadChunk(uint8_t* chunk) {
+	uint32_t filled = 0;
+	while (filled < chunkBytes_) {
+		if (position_ >= dataSize_) {
+			if (!isLoop_) {
+				break;
+			}
+			// 曲の頭に戻ってチャンクの残りを埋める(ループの継ぎ目で隙間を作らない)
+			file_.clear();
+			file_.seekg(dataOffset_);
+			position_ = 0;
+		}
+
+		uint32_t readSize = (std::min)(chunkBytes_ - filled, dataSize_ - position_);
+		file_.read(reinterpret_cast<char*>(chunk + filled), readSize);
+		uint32_t readCount = static_cast<uint32_t>(file_.gcount());
+		filled += readCount;
+		position_ += readCount;
+		if (readCount < readSize) {
+			// ファイルがヘッダーより短い
+			position_ = dataSize_;
+			if (!isLoop_ || readCount == 0) {
+				break;
+			}
+		}
+	}
+	return filled;
+}
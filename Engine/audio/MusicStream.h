@@ -0,0 +1,105 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class MusicStream;
+
+// ストリームから読んだチャンクを受け取って鳴らす側
+class MusicSink {
+public:
+	virtual ~MusicSink() = default;
+	// dataを鳴らす。鳴らし終わったらstream.ReleaseChunk(chunkIndex)を呼ぶ(どのスレッドからでもよい)
+	// isLastはループしない曲の最後のチャンク
+	virtual void Submit(MusicStream& stream, const uint8_t* data, uint32_t size, uint32_t chunkIndex, bool isLast) = 0;
+};
+
+// 受け取ったらすぐ返す(鳴らさない)。テストと計測用に受け取った分のハッシュを取る
+class NullMusicSink : public MusicSink {
+public:
+	void Submit(MusicStream& stream, const uint8_t* data, uint32_t size, uint32_t chunkIndex, bool isLast) override;
+
+	uint64_t GetReceivedBytes() const { return receivedBytes_; }
+	uint32_t GetReceivedChunkCount() const { return receivedChunkCount_; }
+	uint64_t GetHash() const { return hash_; }
+	bool IsEnded() const { return isEnded_; }
+
+	// FNV-1a。hashに続けて混ぜる
+	static uint64_t Hash(const uint8_t* data, size_t size, uint64_t hash = kHashBasis);
+	static const uint64_t kHashBasis = 0xCBF29CE484222325ull;
+
+private:
+	std::atomic<uint64_t> receivedBytes_ = 0;
+	std::atomic<uint32_t> receivedChunkCount_ = 0;
+	uint64_t hash_ = kHashBasis; //読み込みスレッドだけが書く
+	std::atomic<bool> isEnded_ = false;
+};
+
+// WAVのPCMを固定サイズのチャンクずつ別スレッドで読み、リングバッファに入れてMusicSinkへ渡す
+// 曲の長さに関係なく使うメモリはkChunkSize * kChunkCountだけ
+// 最初のチャンクを読んだ時点でSinkに渡すので、全部読み終わるのを待たずに鳴り始める
+class MusicStream {
+public:
+	MusicStream() = default;
+	~MusicStream();
+	MusicStream(const MusicStream&) = delete;
+	MusicStream& operator=(const MusicStream&) = delete;
+
+	// ヘッダーだけ読んでPCMの位置を調べる(失敗したらfalse)
+	bool Open(const std::string& filePath);
+	// 読み込みスレッドを開始する。sinkはStopまで生きていること
+	void Start(MusicSink& sink, bool isLoop);
+	// 読み込みスレッドを止めて待つ(Sinkに渡したチャンクの後始末はSink側で行う)
+	void Stop();
+	// ループしない曲を最後まで読み終わるのを待つ
+	void WaitForEnd();
+
+	// Sinkが鳴らし終わったチャンクを返す
+	void ReleaseChunk(uint32_t chunkIndex);
+
+	// fmtチャンクの中身(18バイト未満なら0で埋めてWAVEFORMATEXにしてある)
+	const std::vector<uint8_t>& GetFormat() const { return format_; }
+	uint32_t GetDataSize() const { return dataSize_; }
+	bool IsDecoding() const { return isDecoding_; }
+
+	// 統計
+	uint64_t GetDecodedBytes() const { return decodedBytes_; }
+	double GetFirstChunkMilliseconds() const { return firstChunkMilliseconds_; }
+	static size_t GetBufferBytes() { return static_cast<size_t>(kChunkSize) * kChunkCount; }
+
+	static const uint32_t kChunkSize = 64 * 1024;
+	static const uint32_t kChunkCount = 4;
+
+private:
+	void DecodeLoop(std::chrono::steady_clock::time_point start);
+	// 1チャンク分読む(ループならデータの先頭に戻って続きを詰める)。読めた大きさを返す
+	uint32_t ReadChunk(uint8_t* chunk);
+
+	std::ifstream file_;
+	std::vector<uint8_t> format_;
+	std::streamoff dataOffset_ = 0;
+	uint32_t dataSize_ = 0;
+	uint32_t chunkBytes_ = kChunkSize; //ブロック境界に揃えたチャンクの大きさ
+	uint32_t position_ = 0;            //dataチャンク内の読み込み位置
+
+	std::vector<uint8_t> ring_;
+	MusicSink* sink_ = nullptr;
+	bool isLoop_ = false;
+
+	std::thread thread_;
+	std::mutex mutex_;
+	std::condition_variable chunkReleased_;
+	uint32_t freeChunkCount_ = 0;
+	uint32_t nextChunk_ = 0;
+	bool stopRequested_ = false;
+
+	std::atomic<bool> isDecoding_ = false;
+	std::atomic<uint64_t> decodedBytes_ = 0;
+	std::atomic<double> firstChunkMilliseconds_ = 0.0;
+};
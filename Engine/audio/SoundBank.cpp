@@ -0,0 +1,105 @@
+#include "SoundBank.h"
+#include "WaveParser.h"
+#include "Logger.h"
+#include <chrono>
+#include <filesystem>
+
+const SoundBuffer* SoundBank::Acquire(const std::string& filePath) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	SoundBuffer* buffer = FindOrLoad(NormalizePath(filePath));
+	if (buffer) {
+		buffer->refCount++;
+	}
+	return buffer;
+}
+
+void SoundBank::Release(const SoundBuffer* buffer) {
+	if (!buffer) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(mutex_);
+	auto it = buffers_.find(buffer->path);
+	if (it != buffers_.end() && it->second->refCount > 0) {
+		it->second->refCount--;
+	}
+}
+
+bool SoundBank::Preload(const std::string& filePath) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return FindOrLoad(NormalizePath(filePath)) != nullptr;
+}
+
+void SoundBank::ReleaseUnused() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	for (auto it = buffers_.begin(); it != buffers_.end();) {
+		if (it->second->refCount == 0) {
+			it = buffers_.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+}
+
+void SoundBank::Clear() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	buffers_.clear();
+}
+
+size_t SoundBank::GetBufferCount() const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return buffers_.size();
+}
+
+size_t SoundBank::GetLoadedBytes() const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	size_t bytes = 0;
+	for (const auto& [key, buffer] : buffers_) {
+		bytes += buffer->format.size() + buffer->file.size();
+	}
+	return bytes;
+}
+
+std::string SoundBank::NormalizePath(const std::string& filePath) {
+	return std::filesystem::path(filePath).lexically_normal().generic_string();
+}
+
+SoundBuffer* SoundBank::FindOrLoad(const std::string& key) {
+	auto it = buffers_.find(key);
+	if (it != buffers_.end()) {
+		cacheHitCount_++;
+		return it->second.get();
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	std::unique_ptr<SoundBuffer> buffer = std::make_unique<SoundBuffer>();
+	if (!LoadFile(key, *buffer)) {
+		return nullptr;
+	}
+	loadMilliseconds_ += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	fileLoadCount_++;
+
+	buffer->path = key;
+	SoundBuffer* result = buffer.get();
+	buffers_[key] = std::move(buffer);
+	return result;
+}
+
+bool SoundBank::LoadFile(const std::string& filePath, SoundBuffer& buffer) {
+	// ファイルを1回で読み、波形はその中を指す
+	// (マップしたままにしないのは、再生中にオーディオスレッドでページフォルトさせないため)
+	if (!WaveParser::ReadFile(filePath, buffer.file)) {
+		return false;
+	}
+	WaveView view;
+	WaveParseResult result = WaveParser::Parse(buffer.file.data(), buffer.file.size(), view);
+	if (result != WaveParseResult::Ok) {
+		Logger::log("SoundBank: " + filePath + " " + WaveParser::ToString(result) + "\n");
+		return false;
+	}
+
+	WaveParser::CopyFormat(view, buffer.format);
+	buffer.data = view.data;
+	buffer.dataSize = view.dataSize;
+	return true;
+}
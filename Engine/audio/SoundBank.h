@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 読み込んだ波形1ファイル分。読み込み後は変更しない
+struct SoundBuffer {
+	std::string path;
+	std::vector<uint8_t> format;   // fmtチャンクの中身(18バイト未満なら0で埋めてWAVEFORMATEXにしてある)
+	std::vector<uint8_t> file;     // ファイル丸ごと
+	const uint8_t* data = nullptr; // file内のPCMデータ(コピーせずに指す)
+	uint32_t dataSize = 0;
+	uint32_t refCount = 0;
+};
+
+// 波形データをパスごとに1回だけ読み込んで共有する
+// 参照が0になってもすぐには捨てず、ReleaseUnusedで捨てる(リスタートで読み直さないため。シーンが切り替わるとGameManagerが呼ぶ)
+class SoundBank {
+public:
+	~SoundBank() { Clear(); }
+
+	// 読み込み済みならそれを、無ければ読み込んで返し、参照を1増やす(読めなければnullptr)
+	const SoundBuffer* Acquire(const std::string& filePath);
+	// Acquireした分を返す
+	void Release(const SoundBuffer* buffer);
+	// 読み込みだけしておく(参照は増やさない)
+	bool Preload(const std::string& filePath);
+
+	// 参照が0のものを捨てる
+	void ReleaseUnused();
+	void Clear();
+
+	// 統計
+	size_t GetBufferCount() const;
+	size_t GetLoadedBytes() const;
+	uint32_t GetFileLoadCount() const { return fileLoadCount_; }
+	uint32_t GetCacheHitCount() const { return cacheHitCount_; }
+	double GetLoadMilliseconds() const { return loadMilliseconds_; }
+
+	// "./sound/a.wav" と "sound/a.wav" を同じキーにする
+	static std::string NormalizePath(const std::string& filePath);
+
+	// ファイルを読んでbufferに入れる(失敗したらfalse)
+	static bool LoadFile(const std::string& filePath, SoundBuffer& buffer);
+
+private:
+	// mutex_をロックした状態で呼ぶ
+	SoundBuffer* FindOrLoad(const std::string& key);
+
+	mutable std::mutex mutex_;
+	std::unordered_map<std::string, std::unique_ptr<SoundBuffer>> buffers_;
+
+	uint32_t fileLoadCount_ = 0;
+	uint32_t cacheHitCount_ = 0;
+	double loadMilliseconds_ = 0.0;
+};
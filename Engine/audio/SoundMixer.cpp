@@ -0,0 +1,175 @@
+#include "SoundMixer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+	// WAVEFORMATEX::nAvgBytesPerSecの位置
+	const size_t kAvgBytesPerSecOffset = 8;
+
+	// aの方が残す価値が低ければtrue
+	bool IsWeaker(int priorityA, float audibilityA, uint64_t orderA, int priorityB, float audibilityB, uint64_t orderB) {
+		if (priorityA != priorityB) {
+			return priorityA < priorityB;
+		}
+		if (audibilityA != audibilityB) {
+			return audibilityA < audibilityB;
+		}
+		return orderA < orderB;
+	}
+}
+
+void NullMixerBackend::StartVoice(uint32_t voiceIndex, const SoundBuffer& sound, float volume) {
+	(void)volume;
+	if (remainingSeconds_.size() <= voiceIndex) {
+		remainingSeconds_.resize(voiceIndex + 1, 0.0f);
+	}
+	uint32_t bytesPerSecond = 0;
+	if (sound.format.size() >= kAvgBytesPerSecOffset + sizeof(bytesPerSecond)) {
+		std::memcpy(&bytesPerSecond, sound.format.data() + kAvgBytesPerSecOffset, sizeof(bytesPerSecond));
+	}
+	remainingSeconds_[voiceIndex] = bytesPerSecond ? static_cast<float>(sound.dataSize) / bytesPerSecond : 0.0f;
+	startCount_++;
+}
+
+void NullMixerBackend::StopVoice(uint32_t voiceIndex) {
+	if (voiceIndex < remainingSeconds_.size()) {
+		remainingSeconds_[voiceIndex] = 0.0f;
+	}
+}
+
+bool NullMixerBackend::IsVoicePlaying(uint32_t voiceIndex) {
+	return voiceIndex < remainingSeconds_.size() && remainingSeconds_[voiceIndex] > 0.0f;
+}
+
+void NullMixerBackend::Advance(float seconds) {
+	for (float& remaining : remainingSeconds_) {
+		remaining = (std::max)(remaining - seconds, 0.0f);
+	}
+}
+
+void SoundMixer::Initialize(MixerBackend* backend) {
+	backend_ = backend;
+	for (Voice& voice : voices_) {
+		voice = {};
+	}
+	frameCounts_.clear();
+	frameCounts_.reserve(kVoiceCount);
+}
+
+void SoundMixer::Finalize() {
+	if (!backend_) {
+		return;
+	}
+	for (uint32_t i = 0; i < kVoiceCount; ++i) {
+		if (voices_[i].sound) {
+			backend_->StopVoice(i);
+			voices_[i] = {};
+		}
+	}
+	backend_ = nullptr;
+}
+
+void SoundMixer::Update() {
+	if (!backend_) {
+		return;
+	}
+	for (uint32_t i = 0; i < kVoiceCount; ++i) {
+		if (voices_[i].sound && !backend_->IsVoicePlaying(i)) {
+			voices_[i] = {};
+		}
+	}
+	frameCounts_.clear();
+}
+
+uint32_t SoundMixer::Play(const SoundBuffer* sound, float volume, int priority) {
+	return PlayInternal(sound, volume, priority, 0.0f);
+}
+
+uint32_t SoundMixer::Play3D(const SoundBuffer* sound, float volume, int priority, const Vector3& position) {
+	float dx = position.x - listenerPosition_.x;
+	float dy = position.y - listenerPosition_.y;
+	float dz = position.z - listenerPosition_.z;
+	return PlayInternal(sound, volume, priority, std::sqrt(dx * dx + dy * dy + dz * dz));
+}
+
+uint32_t SoundMixer::PlayInternal(const SoundBuffer* sound, float volume, int priority, float distance) {
+	if (!backend_ || !sound) {
+		return kInvalidVoice;
+	}
+
+	// 同じ音は1フレームにkMaxSameSoundPerFrame回まで
+	FrameCount* frameCount = nullptr;
+	for (FrameCount& count : frameCounts_) {
+		if (count.sound == sound) {
+			frameCount = &count;
+			break;
+		}
+	}
+	if (frameCount && frameCount->count >= kMaxSameSoundPerFrame) {
+		cappedCount_++;
+		return kInvalidVoice;
+	}
+
+	const float audibility = volume / (1.0f + distance / kReferenceDistance);
+
+	// 空きを探し、無ければ一番弱いボイスを候補にする
+	uint32_t target = kInvalidVoice;
+	for (uint32_t i = 0; i < kVoiceCount; ++i) {
+		const Voice& voice = voices_[i];
+		if (!voice.sound) {
+			target = i;
+			break;
+		}
+		if (target == kInvalidVoice || IsWeaker(voice.priority, voice.audibility, voice.startOrder,
+			voices_[target].priority, voices_[target].audibility, voices_[target].startOrder)) {
+			target = i;
+		}
+	}
+
+	Voice& voice = voices_[target];
+	if (voice.sound) {
+		// 新しい音の方が弱ければ鳴らさない(同じ強さなら新しい方を鳴らす)
+		if (IsWeaker(priority, audibility, UINT64_MAX, voice.priority, voice.audibility, voice.startOrder)) {
+			rejectedCount_++;
+			return kInvalidVoice;
+		}
+		stolenCount_++;
+	}
+
+	backend_->StartVoice(target, *sound, volume);
+	voice.sound = sound;
+	voice.priority = priority;
+	voice.audibility = audibility;
+	voice.startOrder = ++startOrder_;
+
+	if (frameCount) {
+		frameCount->count++;
+	}
+	else {
+		frameCounts_.push_back({ sound, 1 });
+	}
+	return target;
+}
+
+void SoundMixer::StopSound(const SoundBuffer* sound) {
+	if (!backend_ || !sound) {
+		return;
+	}
+	for (uint32_t i = 0; i < kVoiceCount; ++i) {
+		if (voices_[i].sound == sound) {
+			backend_->StopVoice(i);
+			voices_[i] = {};
+		}
+	}
+}
+
+uint32_t SoundMixer::GetActiveVoiceCount() const {
+	uint32_t count = 0;
+	for (const Voice& voice : voices_) {
+		if (voice.sound) {
+			count++;
+		}
+	}
+	return count;
+}
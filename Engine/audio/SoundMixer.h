@@ -0,0 +1,97 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "SoundBank.h"
+#include "Vector3.h"
+
+// SoundMixerが実際に鳴らす先。ボイスは番号で指定する(0 ～ SoundMixer::kVoiceCount-1)
+class MixerBackend {
+public:
+	virtual ~MixerBackend() = default;
+	// voiceIndexで鳴っている音を止めてsoundを鳴らす
+	virtual void StartVoice(uint32_t voiceIndex, const SoundBuffer& sound, float volume) = 0;
+	virtual void StopVoice(uint32_t voiceIndex) = 0;
+	virtual bool IsVoicePlaying(uint32_t voiceIndex) = 0;
+	// 時間を進める(実際に鳴らすバックエンドは勝手に進むので何もしない)
+	virtual void Advance([[maybe_unused]] float seconds) {}
+};
+
+// 音を出さないバックエンド。再生時間だけを数える(ヘッドレス実行と計測用)
+class NullMixerBackend : public MixerBackend {
+public:
+	void StartVoice(uint32_t voiceIndex, const SoundBuffer& sound, float volume) override;
+	void StopVoice(uint32_t voiceIndex) override;
+	bool IsVoicePlaying(uint32_t voiceIndex) override;
+
+	// 時間を進める(鳴り終わったボイスは止まる)
+	void Advance(float seconds) override;
+
+	uint32_t GetStartCount() const { return startCount_; }
+
+private:
+	std::vector<float> remainingSeconds_;
+	uint32_t startCount_ = 0;
+};
+
+// 効果音をkVoiceCount個のボイスに割り当てる
+// ・空きが無ければ優先度→聞こえやすさ(音量と距離)→古さの順で一番弱いボイスを奪う
+// ・同じ音を1フレームに鳴らせるのはkMaxSameSoundPerFrame回まで(大量の大砲が同時に撃っても重ならない)
+class SoundMixer {
+public:
+	// バックエンドはFinalizeまで生きていること
+	void Initialize(MixerBackend* backend);
+	// 全部止める
+	void Finalize();
+
+	// フレームの頭で呼ぶ。鳴り終わったボイスを空きに戻し、同じ音の回数を数え直す
+	void Update();
+
+	// 距離で聞こえやすさを決めるときの基準(プレイヤーの位置)
+	void SetListenerPosition(const Vector3& position) { listenerPosition_ = position; }
+
+	// 鳴らしたボイス番号を返す(鳴らさなかったらkInvalidVoice)
+	uint32_t Play(const SoundBuffer* sound, float volume, int priority = 0);
+	// 位置付き。遠いほど奪われやすい(音量は変えない)
+	uint32_t Play3D(const SoundBuffer* sound, float volume, int priority, const Vector3& position);
+
+	// soundで鳴っているボイスを全部止める(波形を捨てる前に呼ぶ)
+	void StopSound(const SoundBuffer* sound);
+
+	// 統計
+	uint32_t GetActiveVoiceCount() const;
+	uint32_t GetStolenCount() const { return stolenCount_; }
+	uint32_t GetCappedCount() const { return cappedCount_; }
+	uint32_t GetRejectedCount() const { return rejectedCount_; }
+
+	static const uint32_t kVoiceCount = 16;
+	static const uint32_t kMaxSameSoundPerFrame = 2;
+	static const uint32_t kInvalidVoice = UINT32_MAX;
+	// この距離で聞こえやすさが半分になる
+	static constexpr float kReferenceDistance = 20.0f;
+
+private:
+	uint32_t PlayInternal(const SoundBuffer* sound, float volume, int priority, float distance);
+
+	struct Voice {
+		const SoundBuffer* sound = nullptr; // nullptrなら空き
+		int priority = 0;
+		float audibility = 0.0f;
+		uint64_t startOrder = 0;
+	};
+
+	// 今フレームに鳴らした回数
+	struct FrameCount {
+		const SoundBuffer* sound;
+		uint32_t count;
+	};
+
+	MixerBackend* backend_ = nullptr;
+	Voice voices_[kVoiceCount];
+	std::vector<FrameCount> frameCounts_;
+	Vector3 listenerPosition_ = { 0.0f, 0.0f, 0.0f };
+	uint64_t startOrder_ = 0;
+
+	uint32_t stolenCount_ = 0;
+	uint32_t cappedCount_ = 0;
+	uint32_t rejectedCount_ = 0;
+};
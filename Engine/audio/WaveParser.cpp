@@ -0,0 +1,108 @@
+#include "WaveParser.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace {
+	const size_t kChunkHeaderSize = 8;
+	const size_t kRiffHeaderSize = 12;
+
+	uint32_t ReadU32(const uint8_t* p) {
+		uint32_t value;
+		std::memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	uint16_t ReadU16(const uint8_t* p) {
+		uint16_t value;
+		std::memcpy(&value, p, sizeof(value));
+		return value;
+	}
+}
+
+namespace WaveParser {
+	WaveParseResult Parse(const uint8_t* data, size_t size, WaveView& view) {
+		view = {};
+		if (size < kRiffHeaderSize || std::memcmp(data, "RIFF", 4) != 0 || std::memcmp(data + 8, "WAVE", 4) != 0) {
+			return WaveParseResult::NotRiff;
+		}
+
+		// RIFFの大きさが実際のファイルより大きいものがあるので、短い方を終わりにする
+		const size_t riffEnd = (std::min)(size, static_cast<size_t>(ReadU32(data + 4)) + kChunkHeaderSize);
+		if (riffEnd < kRiffHeaderSize) {
+			return WaveParseResult::Truncated;
+		}
+
+		size_t position = kRiffHeaderSize;
+		while (position + kChunkHeaderSize <= riffEnd && (!view.format || !view.data)) {
+			const uint8_t* header = data + position;
+			const uint32_t chunkSize = ReadU32(header + 4);
+			const size_t body = position + kChunkHeaderSize;
+			if (chunkSize > riffEnd - body) {
+				return WaveParseResult::Truncated;
+			}
+
+			if (std::memcmp(header, "fmt ", 4) == 0 && !view.format) {
+				if (chunkSize < kMinFormatSize) {
+					return WaveParseResult::BadFormat;
+				}
+				// WAVEFORMATEX以上ならcbSize分の続きが入っていること
+				if (chunkSize >= kFormatExSize && kFormatExSize + ReadU16(data + body + 16) > chunkSize) {
+					return WaveParseResult::BadFormat;
+				}
+				view.format = data + body;
+				view.formatSize = chunkSize;
+			}
+			else if (std::memcmp(header, "data", 4) == 0 && !view.data) {
+				view.data = data + body;
+				view.dataSize = chunkSize;
+				view.dataOffset = body;
+			}
+
+			// チャンクは2バイト境界に並ぶ
+			position = body + chunkSize + (chunkSize & 1);
+		}
+
+		if (!view.format) {
+			return WaveParseResult::MissingFormat;
+		}
+		if (!view.data) {
+			return WaveParseResult::MissingData;
+		}
+		return WaveParseResult::Ok;
+	}
+
+	bool ReadFile(const std::string& filePath, std::vector<uint8_t>& bytes) {
+		std::ifstream file(filePath, std::ios_base::binary | std::ios_base::ate);
+		if (!file.is_open()) {
+			return false;
+		}
+		std::streamoff size = file.tellg();
+		if (size < 0) {
+			return false;
+		}
+		bytes.resize(static_cast<size_t>(size));
+		file.seekg(0);
+		file.read(reinterpret_cast<char*>(bytes.data()), size);
+		return static_cast<bool>(file);
+	}
+
+	void CopyFormat(const WaveView& view, std::vector<uint8_t>& format) {
+		format.assign(view.format, view.format + view.formatSize);
+		if (format.size() < kFormatExSize) {
+			format.resize(kFormatExSize, 0);
+		}
+	}
+
+	const char* ToString(WaveParseResult result) {
+		switch (result) {
+		case WaveParseResult::Ok: return "Ok";
+		case WaveParseResult::NotRiff: return "NotRiff";
+		case WaveParseResult::Truncated: return "Truncated";
+		case WaveParseResult::BadFormat: return "BadFormat";
+		case WaveParseResult::MissingFormat: return "MissingFormat";
+		case WaveParseResult::MissingData: return "MissingData";
+		}
+		return "Unknown";
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// WAVファイルの中身を指す。元のバッファが生きている間だけ使える
+struct WaveView {
+	const uint8_t* format = nullptr; // fmtチャンクの中身
+	uint32_t formatSize = 0;
+	const uint8_t* data = nullptr;   // PCMデータ
+	uint32_t dataSize = 0;
+	size_t dataOffset = 0;           // ファイル先頭からdataの中身までの位置
+};
+
+enum class WaveParseResult {
+	Ok,
+	NotRiff,       // RIFF/WAVEではない
+	Truncated,     // チャンクの大きさがファイルからはみ出している
+	BadFormat,     // fmtの大きさが合わない
+	MissingFormat,
+	MissingData,
+};
+
+// RIFF(WAV)のチャンクを順番に見て、fmtとdataを探す
+// fmt/data以外のチャンク(JUNK, LIST, bext ...)は順番や数に関係なく飛ばす
+namespace WaveParser {
+	// [data, data + size)を解析してviewに入れる。コピーはしない
+	// RIFFヘッダーの大きさがファイルより大きい場合はファイルの終わりまでを見る
+	WaveParseResult Parse(const uint8_t* data, size_t size, WaveView& view);
+
+	// ファイルを丸ごと1回で読む
+	bool ReadFile(const std::string& filePath, std::vector<uint8_t>& bytes);
+
+	// fmtをWAVEFORMATEXとしてそのまま渡せるように、18バイト未満なら0で埋めてコピーする
+	void CopyFormat(const WaveView& view, std::vector<uint8_t>& format);
+
+	const char* ToString(WaveParseResult result);
+
+	// WAVEFORMATEXの大きさ
+	const uint32_t kFormatExSize = 18;
+	// PCMWAVEFORMATの大きさ(fmtの最小)
+	const uint32_t kMinFormatSize = 16;
+}
@@ -0,0 +1,75 @@
+#include "AllocationCounter.h"
+#include <cstdlib>
+#include <new>
+
+// Headlessは描画の確保をSelfTestで確かめるのでReleaseでも数える
+#if defined(_DEBUG) || defined(HEADLESS)
+#define ALLOCATION_COUNTER_ENABLED
+#endif
+
+#ifdef ALLOCATION_COUNTER_ENABLED
+namespace {
+	thread_local uint64_t allocationCount = 0;
+
+	void* Allocate(size_t size) {
+		allocationCount++;
+		// 0バイトでも有効なポインタを返す
+		return std::malloc(size ? size : 1);
+	}
+}
+
+// 置き換えるのは通常のnew/deleteだけ(アラインメント指定版は数えない)
+void* operator new(size_t size) {
+	void* p = Allocate(size);
+	if (p == nullptr) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void* operator new[](size_t size) {
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+	return Allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+	return Allocate(size);
+}
+
+void operator delete(void* p) noexcept {
+	std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+	std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+	std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+	std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+	std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+	std::free(p);
+}
+#endif
+
+namespace AllocationCounter {
+	uint64_t GetCount() {
+#ifdef ALLOCATION_COUNTER_ENABLED
+		return allocationCount;
+#else
+		return 0;
+#endif
+	}
+}
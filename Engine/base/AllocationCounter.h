@@ -0,0 +1,9 @@
+#pragma once
+#include <cstdint>
+
+// ヒープ確保の回数を数える(DebugビルドとHeadlessだけ)
+// 描画などの区間の前後でGetCountの差を取り、確保が起きていないことを確かめる
+namespace AllocationCounter {
+	// このスレッドでこれまでにoperator newが呼ばれた回数(それ以外では常に0)
+	uint64_t GetCount();
+}
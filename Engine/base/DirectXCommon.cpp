@@ -7,7 +7,6 @@
 #pragma comment(lib,"dxgi.lib")
 #pragma comment(lib,"dxcompiler.lib")
 
-#include <thread>
 #include "SrvManager.h"
 #include "ImGuiManager.h"
 
@@ -31,7 +30,8 @@ DirectXCommon* DirectXCommon::GetInstance() {
 
 void DirectXCommon::Initialize() {
 
-	InitializeFixFPS();
+	// 60FPSに固定(寝てから最後だけ回って待つ)
+	framePacer_ = new FramePacer();
 
 	assert(winApp_);
 
@@ -669,7 +669,7 @@ void DirectXCommon::PostDraw() {
 		WaitForSingleObject(fenceEvent, INFINITE);
 	}
 	// FPS
-	UpdateFixFPS();
+	framePacer_->Wait();
 
 	//次のフレームのコマンドリストを準備
 	hr = commandAllocator->Reset();
@@ -678,33 +678,10 @@ void DirectXCommon::PostDraw() {
 	assert(SUCCEEDED(hr));
 }
 
-void DirectXCommon::InitializeFixFPS() {
-	//現在時間を記録
-	reference_ = std::chrono::steady_clock::now();
-}
-
-void DirectXCommon::UpdateFixFPS() {
-	//1/60秒ピッタリ
-	const std::chrono::microseconds kMinTime(uint64_t(1000000.0f / 60.0f));
-	//1/60秒少し短い
-	//vsyncまちの無駄時間軽減に使う
-	const std::chrono::microseconds kMinCheckTime(uint64_t(1000000.0f / 65.0f));
-
-
-	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
-
-	std::chrono::microseconds elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - reference_);
-
-	if (elapsed < kMinCheckTime) {
-		while (std::chrono::steady_clock::now() - reference_ < kMinTime) {
-			std::this_thread::sleep_for(std::chrono::microseconds(1));
-		}
-	}
-	reference_ = std::chrono::steady_clock::now();
-}
-
 void DirectXCommon::Finalize() {
 	CloseHandle(fenceEvent);
+	delete framePacer_;
+	framePacer_ = nullptr;
 	delete instance;
 	instance = nullptr;
 }
\ No newline at end of file
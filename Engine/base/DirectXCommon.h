@@ -12,7 +12,7 @@
 #include <dxcapi.h>
 
 #include "externals/DirectXTex/DirectXTex.h"
-#include <chrono>
+#include "FramePacer.h"
 
 class DirectXCommon {
 public:
@@ -65,6 +65,8 @@ public:
 	ID3D12GraphicsCommandList* GetCommandList() const { return commandList.Get(); }
 	D3D12_CPU_DESCRIPTOR_HANDLE GetDsvHandle() { return dsvHandle; }
 	HANDLE GetFenceEvent() { return fenceEvent; }
+	// フレームレートの固定(目標レートの変更と間隔の統計)
+	FramePacer* GetFramePacer() { return framePacer_; }
 
 	D3D12_RENDER_TARGET_VIEW_DESC GetRtvDesc() { return rtvDesc; }
 	ID3D12DescriptorHeap* GetSrvDescriptorHeap() { return srvDescriptorHeap.Get(); }
@@ -161,10 +163,7 @@ private:
 	D3D12_RESOURCE_BARRIER barrier{};
 
 	//Fix = 固定
-	void InitializeFixFPS();
-	void UpdateFixFPS();
-	//逆行しないタイマー
-	std::chrono::steady_clock::time_point reference_;
+	FramePacer* framePacer_ = nullptr;
 
 
 	static DirectXCommon* instance;
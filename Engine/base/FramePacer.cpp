@@ -0,0 +1,168 @@
+#include "FramePacer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <timeapi.h>
+#pragma comment(lib, "winmm.lib")
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#else
+#include <thread>
+#endif
+
+namespace {
+	const uint32_t kIntervalMask = FramePacer::kIntervalCount - 1;
+	static_assert((FramePacer::kIntervalCount & kIntervalMask) == 0, "kIntervalCount must be a power of two");
+}
+
+FramePacer::SystemClock::SystemClock() {
+#ifdef _WIN32
+	// Windows 10 1803以降は高分解能のタイマーが使える
+	timer_ = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+	isHighResolution_ = timer_ != nullptr;
+	if (!isHighResolution_) {
+		// 使えなければ普通のタイマーを1ms単位で使う
+		timeBeginPeriod(1);
+		timer_ = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+	}
+#endif
+}
+
+FramePacer::SystemClock::~SystemClock() {
+#ifdef _WIN32
+	if (timer_) {
+		CloseHandle(timer_);
+	}
+	if (!isHighResolution_) {
+		timeEndPeriod(1);
+	}
+#endif
+}
+
+int64_t FramePacer::SystemClock::Now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void FramePacer::SystemClock::Sleep(int64_t nanoseconds) {
+#ifdef _WIN32
+	if (timer_) {
+		// 100ns単位。負の値は今からの相対時間
+		LARGE_INTEGER dueTime;
+		dueTime.QuadPart = -(nanoseconds / 100);
+		if (SetWaitableTimerEx(timer_, &dueTime, 0, nullptr, nullptr, nullptr, 0)) {
+			WaitForSingleObject(timer_, INFINITE);
+			return;
+		}
+	}
+	::Sleep(static_cast<DWORD>(nanoseconds / 1000000));
+#else
+	std::this_thread::sleep_for(std::chrono::nanoseconds(nanoseconds));
+#endif
+}
+
+FramePacer::FramePacer(Clock* clock) {
+	if (clock == nullptr) {
+		ownedClock_ = new SystemClock();
+		clock = ownedClock_;
+	}
+	clock_ = clock;
+	SetTargetRate(targetRate_);
+}
+
+FramePacer::~FramePacer() {
+	delete ownedClock_;
+}
+
+void FramePacer::SetTargetRate(float framesPerSecond) {
+	targetRate_ = (std::max)(framesPerSecond, 0.0f);
+	period_ = targetRate_ > 0.0f ? static_cast<int64_t>(1000000000.0 / targetRate_) : 0;
+	// 次のWaitから新しい間隔で数え直す
+	hasWoken_ = false;
+}
+
+void FramePacer::Wait() {
+	int64_t now = clock_->Now();
+
+	// 最初の1回(と間隔を変えた直後)は締め切りを決めるだけ
+	if (!hasWoken_) {
+		hasWoken_ = true;
+		deadline_ = now + period_;
+		previousWake_ = now;
+		return;
+	}
+
+	int64_t spin = 0;
+	if (period_ > 0) {
+		if (now > deadline_) {
+			// 処理落ち。取り戻そうとして短いフレームを続けないように、ここから数え直す
+			missedCount_++;
+			deadline_ = now;
+		} else {
+			// 締め切りのspinMargin手前まで寝る
+			int64_t remaining = deadline_ - now;
+			if (remaining > spinMargin_) {
+				clock_->Sleep(remaining - spinMargin_);
+				now = clock_->Now();
+				if (now > deadline_) {
+					lateWakeCount_++;
+				}
+			}
+			// 残りは時計を見ながら回る
+			int64_t spinStart = now;
+			while (now < deadline_) {
+				now = clock_->Now();
+			}
+			spin = now - spinStart;
+			// 1フレーム以上寝過ごしたら数え直す
+			if (now - deadline_ > period_) {
+				deadline_ = now;
+			}
+		}
+		deadline_ += period_;
+	}
+
+	uint32_t index = writeCount_ & kIntervalMask;
+	intervals_[index] = now - previousWake_;
+	spins_[index] = spin;
+	writeCount_++;
+	previousWake_ = now;
+}
+
+FramePacer::PacingStats FramePacer::GetStats() const {
+	PacingStats stats;
+	stats.sampleCount = (std::min)(writeCount_, kIntervalCount);
+	stats.missedCount = missedCount_;
+	stats.lateWakeCount = lateWakeCount_;
+	if (stats.sampleCount == 0) {
+		return stats;
+	}
+
+	double sum = 0.0;
+	double spinSum = 0.0;
+	int64_t minInterval = intervals_[0];
+	int64_t maxInterval = intervals_[0];
+	for (uint32_t i = 0; i < stats.sampleCount; ++i) {
+		sum += static_cast<double>(intervals_[i]);
+		spinSum += static_cast<double>(spins_[i]);
+		minInterval = (std::min)(minInterval, intervals_[i]);
+		maxInterval = (std::max)(maxInterval, intervals_[i]);
+	}
+	const double mean = sum / stats.sampleCount;
+	double squareSum = 0.0;
+	for (uint32_t i = 0; i < stats.sampleCount; ++i) {
+		const double difference = static_cast<double>(intervals_[i]) - mean;
+		squareSum += difference * difference;
+	}
+
+	const double kNanosecondsToMilliseconds = 1.0 / 1000000.0;
+	stats.mean = static_cast<float>(mean * kNanosecondsToMilliseconds);
+	stats.standardDeviation = static_cast<float>(std::sqrt(squareSum / stats.sampleCount) * kNanosecondsToMilliseconds);
+	stats.min = static_cast<float>(minInterval * kNanosecondsToMilliseconds);
+	stats.max = static_cast<float>(maxInterval * kNanosecondsToMilliseconds);
+	stats.spin = static_cast<float>(spinSum / stats.sampleCount * kNanosecondsToMilliseconds);
+	return stats;
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+// フレームの間隔を目標のレートに揃える
+// 締め切りの少し手前(spinMargin)までOSのタイマーで寝て、残りだけ時計を見ながら回る
+// 以前のsleep_for(1us)を回し続ける方法と違い、CPUを使うのは最後の数百マイクロ秒だけ
+// 時計は差し替えられる(テストでは寝た時間を自由に決められる偽の時計を使う)
+class FramePacer {
+public:
+	// 時間はすべてナノ秒
+	class Clock {
+	public:
+		virtual ~Clock() = default;
+		virtual int64_t Now() = 0;
+		// 少なくともnanosecondsだけ寝る(長く寝すぎることはある)
+		virtual void Sleep(int64_t nanoseconds) = 0;
+	};
+
+	// steady_clockと高分解能の待機タイマー(Windows)
+	class SystemClock : public Clock {
+	public:
+		SystemClock();
+		~SystemClock() override;
+		SystemClock(const SystemClock&) = delete;
+		SystemClock& operator=(const SystemClock&) = delete;
+
+		int64_t Now() override;
+		void Sleep(int64_t nanoseconds) override;
+
+	private:
+		void* timer_ = nullptr;
+		bool isHighResolution_ = false;
+	};
+
+	// clockがnullptrならSystemClockを使う。渡したclockはFramePacerより長く生きていること
+	explicit FramePacer(Clock* clock = nullptr);
+	~FramePacer();
+	FramePacer(const FramePacer&) = delete;
+	FramePacer& operator=(const FramePacer&) = delete;
+
+	// 目標のフレームレート(0以下なら待たない)
+	void SetTargetRate(float framesPerSecond);
+	float GetTargetRate() const { return targetRate_; }
+
+	// 締め切りの何ナノ秒前から回って待つか
+	void SetSpinMargin(int64_t nanoseconds) { spinMargin_ = nanoseconds; }
+	int64_t GetSpinMargin() const { return spinMargin_; }
+
+	// 1フレームに1回呼ぶ。次の締め切りまで待ち、前回からの間隔を記録する
+	void Wait();
+
+	// 直近kIntervalCountフレームの間隔(ミリ秒)
+	struct PacingStats {
+		float mean = 0.0f;
+		float standardDeviation = 0.0f;
+		float min = 0.0f;
+		float max = 0.0f;
+		uint32_t sampleCount = 0;
+		// 回って待った時間の1フレーム平均
+		float spin = 0.0f;
+		// 待つ前に締め切りを過ぎていた回数(処理落ち)
+		uint32_t missedCount = 0;
+		// 寝すぎて締め切りを過ぎた回数(spinMarginが足りない)
+		uint32_t lateWakeCount = 0;
+	};
+	PacingStats GetStats() const;
+
+	// 記録するフレーム数(2のべき乗)
+	static constexpr uint32_t kIntervalCount = 256;
+	// デフォルトの回る時間(0.4ms)
+	static constexpr int64_t kDefaultSpinMargin = 400000;
+
+private:
+	Clock* clock_ = nullptr;
+	SystemClock* ownedClock_ = nullptr;
+
+	float targetRate_ = 60.0f;
+	int64_t period_ = 0;
+	int64_t spinMargin_ = kDefaultSpinMargin;
+
+	// 次の締め切りと前回Waitを抜けた時刻
+	int64_t deadline_ = 0;
+	int64_t previousWake_ = 0;
+	bool hasWoken_ = false;
+
+	std::array<int64_t, kIntervalCount> intervals_{};
+	std::array<int64_t, kIntervalCount> spins_{};
+	uint32_t writeCount_ = 0;
+	uint32_t missedCount_ = 0;
+	uint32_t lateWakeCount_ = 0;
+};
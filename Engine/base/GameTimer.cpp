@@ -0,0 +1,48 @@
+#include "GameTimer.h"
+#include <algorithm>
+#include <cmath>
+
+GameTimer* GameTimer::instance = nullptr;
+
+GameTimer* GameTimer::GetInstance() {
+	if (instance == nullptr) {
+		instance = new GameTimer();
+	}
+	return instance;
+}
+
+void GameTimer::Finalize() {
+	delete instance;
+	instance = nullptr;
+}
+
+void GameTimer::Advance(double frameSeconds) {
+	if (frameSeconds < 0.0) {
+		frameSeconds = 0.0;
+	}
+
+	// tickの整数倍に近ければ揃える(計測の揺れで溜まる量がずれないように)
+	double ticks = std::round(frameSeconds / kStep);
+	if (ticks >= 1.0 && std::abs(frameSeconds - ticks * kStep) < kSnapSeconds) {
+		frameSeconds = ticks * kStep;
+	}
+
+	accumulator_ += frameSeconds;
+	const double maxAccumulator = kStep * kMaxTicksPerFrame;
+	if (accumulator_ > maxAccumulator) {
+		droppedTime_ += accumulator_ - maxAccumulator;
+		accumulator_ = maxAccumulator;
+	}
+	frameTickCount_ = 0;
+}
+
+bool GameTimer::Step() {
+	// 揃えた分の誤差で1tickに僅かに足りないことがあるので少しだけ余裕を見る
+	if (accumulator_ + kStep * 1e-6 < kStep) {
+		return false;
+	}
+	accumulator_ = (std::max)(accumulator_ - kStep, 0.0);
+	tickCount_++;
+	frameTickCount_++;
+	return true;
+}
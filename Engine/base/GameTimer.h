@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+
+// ゲームの更新を描画の速さと切り離して、固定間隔(tick)で進める
+// 描画1回ごとにAdvanceで経過時間を足し、Stepがtrueを返す間だけUpdateを呼ぶ
+// 120Hz/144Hzのモニターや処理落ちでも、ゲームは1秒にkTickRate回だけ進む
+class GameTimer {
+public:
+	static GameTimer* GetInstance();
+	void Finalize();
+
+	// 1秒あたりの更新回数
+	// 重力や速度などゲーム側の定数は1tickあたりの値なので、変えるならそれらも合わせて直す
+	static constexpr double kTickRate = 60.0;
+	// 1tickの時間(秒)
+	static constexpr double kStep = 1.0 / kTickRate;
+
+	// 前の描画からの経過時間(秒)を足す。溜まりすぎた分(kMaxTicksPerFrameより先)は捨てる
+	void Advance(double frameSeconds);
+
+	// 1tick分溜まっていれば取り出してtrue
+	bool Step();
+
+	// 1tickの時間(秒)。Updateはこれだけ進める
+	float GetDeltaTime() const { return static_cast<float>(kStep); }
+
+	// 最後のtickから次のtickまでのどこを描くか(0〜1)。描画で前の状態と補間する用
+	float GetAlpha() const { return static_cast<float>(accumulator_ / kStep); }
+
+	// これまでに進めたtick数と、その合計時間(秒)
+	uint64_t GetTickCount() const { return tickCount_; }
+	double GetTotalTime() const { return static_cast<double>(tickCount_) * kStep; }
+
+	// 直近のフレームで進めたtick数
+	uint32_t GetFrameTickCount() const { return frameTickCount_; }
+	// 溜まりすぎて捨てた時間(秒)
+	double GetDroppedTime() const { return droppedTime_; }
+
+	// 1回の描画で進める最大のtick数(長い引っかかりの後に一気に進めすぎない)
+	static const uint32_t kMaxTicksPerFrame = 5;
+	// tickの整数倍とこれ以内の差しかないフレーム時間は整数倍に揃える(60Hz描画で0tick/2tickが交互に出ないように)
+	static constexpr double kSnapSeconds = 0.0002;
+
+private:
+	GameTimer() = default;
+	~GameTimer() = default;
+	GameTimer(const GameTimer&) = delete;
+	GameTimer& operator=(const GameTimer&) = delete;
+
+	static GameTimer* instance;
+
+	double accumulator_ = 0.0;
+	uint64_t tickCount_ = 0;
+	uint32_t frameTickCount_ = 0;
+	double droppedTime_ = 0.0;
+};
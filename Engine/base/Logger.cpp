@@ -1,8 +1,16 @@
 #include "Logger.h"
+#ifdef _WIN32
 #include<Windows.h>
+#else
+#include <cstdio>
+#endif
 
 namespace Logger {
 	void log(const std::string& message) {
+#ifdef _WIN32
 		OutputDebugStringA(message.c_str());
+#else
+		std::fputs(message.c_str(), stderr);
+#endif
 	}
 };
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+	Close();
+}
+
+bool MappedFile::Open(const std::string& filePath) {
+	Close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER fileSize{};
+	if (!GetFileSizeEx(file, &fileSize)) {
+		CloseHandle(file);
+		return false;
+	}
+	file_ = file;
+	size_ = static_cast<size_t>(fileSize.QuadPart);
+	isOpen_ = true;
+
+	// 0バイトのファイルはマップできないので空のまま返す
+	if (size_ == 0) {
+		return true;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr) {
+		Close();
+		return false;
+	}
+	mapping_ = mapping;
+
+	data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if (data_ == nullptr) {
+		Close();
+		return false;
+	}
+#else
+	int file = open(filePath.c_str(), O_RDONLY);
+	if (file < 0) {
+		return false;
+	}
+
+	struct stat st {};
+	if (fstat(file, &st) != 0) {
+		close(file);
+		return false;
+	}
+	file_ = file;
+	size_ = static_cast<size_t>(st.st_size);
+	isOpen_ = true;
+
+	if (size_ == 0) {
+		return true;
+	}
+
+	void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file, 0);
+	if (data == MAP_FAILED) {
+		Close();
+		return false;
+	}
+	data_ = static_cast<const uint8_t*>(data);
+#endif
+
+	return true;
+}
+
+void MappedFile::Close() {
+#ifdef _WIN32
+	if (data_) {
+		UnmapViewOfFile(data_);
+	}
+	if (mapping_) {
+		CloseHandle(static_cast<HANDLE>(mapping_));
+		mapping_ = nullptr;
+	}
+	if (file_) {
+		CloseHandle(static_cast<HANDLE>(file_));
+		file_ = nullptr;
+	}
+#else
+	if (data_) {
+		munmap(const_cast<uint8_t*>(data_), size_);
+	}
+	if (file_ >= 0) {
+		close(file_);
+		file_ = -1;
+	}
+#endif
+
+	data_ = nullptr;
+	size_ = 0;
+	isOpen_ = false;
+}
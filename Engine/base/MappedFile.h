@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 読み込み専用のメモリマップドファイル
+// ファイル全体をコピーせずにそのまま参照する。Closeかデストラクタで解放
+class MappedFile {
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// ファイルを開いてマップする(失敗したらfalse)
+	bool Open(const std::string& filePath);
+	void Close();
+
+	const uint8_t* GetData() const { return data_; }
+	size_t GetSize() const { return size_; }
+	bool IsOpen() const { return isOpen_; }
+
+private:
+	const uint8_t* data_ = nullptr;
+	size_t size_ = 0;
+	bool isOpen_ = false;
+
+#ifdef _WIN32
+	void* file_ = nullptr;    // HANDLE
+	void* mapping_ = nullptr; // HANDLE
+#else
+	int file_ = -1;
+#endif
+};
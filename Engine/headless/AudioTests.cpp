@@ -0,0 +1,505 @@
+// WaveParser・MusicStream・SoundMixerのテストと計測
+#include "SelfTest.h"
+#include "WaveParser.h"
+#include "MusicStream.h"
+#include "SoundBank.h"
+#include "SoundMixer.h"
+#include "FastRandom.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace {
+	const size_t kChunkHeaderSize = 8;
+	// WAVEFORMATEX::nAvgBytesPerSecの位置
+	const size_t kAvgBytesPerSecOffset = 8;
+
+	// テスト用にWAVを組み立てる
+	struct WaveBuilder {
+		std::vector<uint8_t> bytes;
+
+		WaveBuilder() {
+			// テストのWAVはどれもヘッダーとチャンク数個なので、先に取っておく
+			bytes.reserve(256);
+			Append("RIFF", 4);
+			AppendU32(0);
+			Append("WAVE", 4);
+		}
+		void Append(const void* p, size_t size) {
+			// 先に広げてから書く(空のvectorへのinsertはGCCが-Wstringop-overflowを出す)
+			size_t offset = bytes.size();
+			bytes.resize(offset + size);
+			std::memcpy(bytes.data() + offset, p, size);
+		}
+		void AppendU32(uint32_t value) { Append(&value, sizeof(value)); }
+		// 中身がsize個のvalueのチャンクを足す(奇数なら埋め草も)
+		void Chunk(const char* id, uint32_t size, uint8_t value = 0) {
+			Append(id, 4);
+			AppendU32(size);
+			bytes.resize(bytes.size() + size + (size & 1), value);
+		}
+		// 16bitステレオ44.1kHzのfmt。cbSizeは18バイト以上のときだけ書く
+		void Format(uint32_t size, uint16_t cbSize = 0) {
+			size_t begin = bytes.size() + kChunkHeaderSize;
+			Chunk("fmt ", size);
+			const uint16_t tag = 1, channels = 2, blockAlign = 4, bits = 16;
+			const uint32_t rate = 44100, bytesPerSecond = rate * blockAlign;
+			uint8_t pcm[18];
+			std::memcpy(pcm, &tag, 2);
+			std::memcpy(pcm + 2, &channels, 2);
+			std::memcpy(pcm + 4, &rate, 4);
+			std::memcpy(pcm + 8, &bytesPerSecond, 4);
+			std::memcpy(pcm + 12, &blockAlign, 2);
+			std::memcpy(pcm + 14, &bits, 2);
+			std::memcpy(pcm + 16, &cbSize, 2);
+			std::memcpy(bytes.data() + begin, pcm, (std::min)(size, 18u));
+		}
+		// RIFFの大きさを書く(adjustで実際とずらせる)
+		std::vector<uint8_t>& Finish(int32_t adjust = 0) {
+			uint32_t riffSize = static_cast<uint32_t>(static_cast<int64_t>(bytes.size()) - 8 + adjust);
+			std::memcpy(bytes.data() + 4, &riffSize, sizeof(riffSize));
+			return bytes;
+		}
+	};
+
+	// 以前の読み方(fmt→JUNK→LIST→dataの順しか読めない)
+	bool ParseWaveLegacy(const std::string& filePath, std::vector<uint8_t>& format, std::vector<uint8_t>& data) {
+		struct ChunkHeader {
+			char id[4];
+			int32_t size;
+		};
+
+		std::ifstream file(filePath, std::ios_base::binary);
+		if (!file.is_open()) {
+			return false;
+		}
+
+		ChunkHeader riff;
+		char type[4];
+		file.read(reinterpret_cast<char*>(&riff), sizeof(riff));
+		file.read(type, sizeof(type));
+		if (strncmp(riff.id, "RIFF", 4) != 0 || strncmp(type, "WAVE", 4) != 0) {
+			return false;
+		}
+
+		ChunkHeader fmt;
+		file.read(reinterpret_cast<char*>(&fmt), sizeof(fmt));
+		if (strncmp(fmt.id, "fmt ", 4) != 0 || fmt.size > static_cast<int32_t>(WaveParser::kFormatExSize)) {
+			return false;
+		}
+		format.resize(fmt.size);
+		file.read(reinterpret_cast<char*>(format.data()), fmt.size);
+
+		ChunkHeader chunk;
+		file.read(reinterpret_cast<char*>(&chunk), sizeof(chunk));
+		if (strncmp(chunk.id, "JUNK", 4) == 0) {
+			file.seekg(chunk.size, std::ios_base::cur);
+			file.read(reinterpret_cast<char*>(&chunk), sizeof(chunk));
+		}
+		if (strncmp(chunk.id, "LIST", 4) == 0) {
+			file.seekg(chunk.size, std::ios_base::cur);
+			file.read(reinterpret_cast<char*>(&chunk), sizeof(chunk));
+		}
+		if (strncmp(chunk.id, "data", 4) != 0 || chunk.size < 0) {
+			return false;
+		}
+
+		data.resize(chunk.size);
+		file.read(reinterpret_cast<char*>(data.data()), chunk.size);
+		return static_cast<bool>(file);
+	}
+}
+
+namespace SelfTest {
+	bool TestWaveParser() {
+		int failedCount = 0;
+		auto expect = [&failedCount](const char* name, const std::vector<uint8_t>& bytes, WaveParseResult expected,
+			uint32_t expectedDataSize = 0) {
+			WaveView view;
+			WaveParseResult result = WaveParser::Parse(bytes.data(), bytes.size(), view);
+			bool ok = result == expected;
+			if (ok && result == WaveParseResult::Ok) {
+				// ビューは元のバッファの中を指す
+				ok = view.dataSize == expectedDataSize && view.data == bytes.data() + view.dataOffset &&
+					view.format >= bytes.data() && view.format + view.formatSize <= bytes.data() + bytes.size() &&
+					view.data + view.dataSize <= bytes.data() + bytes.size();
+			}
+			if (!ok) {
+				Log(std::string("TestWaveParser: FAILED ") + name + " returned " + WaveParser::ToString(result) + "\n");
+				failedCount++;
+			}
+		};
+
+		{
+			WaveBuilder b;
+			b.Format(16);
+			b.Chunk("data", 64, 1);
+			expect("fmt data", b.Finish(), WaveParseResult::Ok, 64);
+		}
+		{
+			// JUNKが先頭(sound/damage.wavと同じ並び)
+			WaveBuilder b;
+			b.Chunk("JUNK", 28);
+			b.Format(16);
+			b.Chunk("data", 64, 1);
+			expect("JUNK first", b.Finish(), WaveParseResult::Ok, 64);
+		}
+		{
+			WaveBuilder b;
+			b.Chunk("JUNK", 28);
+			b.Format(18);
+			b.Chunk("LIST", 26);
+			b.Chunk("bext", 602);
+			b.Chunk("LIST", 4);
+			b.Chunk("data", 128, 1);
+			expect("many unknown chunks", b.Finish(), WaveParseResult::Ok, 128);
+		}
+		{
+			WaveBuilder b;
+			b.Chunk("data", 32, 1);
+			b.Format(16);
+			expect("data before fmt", b.Finish(), WaveParseResult::Ok, 32);
+		}
+		{
+			WaveBuilder b;
+			b.Chunk("odd ", 3);
+			b.Format(16);
+			b.Chunk("data", 5, 1);
+			expect("odd sized chunks", b.Finish(), WaveParseResult::Ok, 5);
+		}
+		{
+			WaveBuilder b;
+			b.Format(40, 22);
+			b.Chunk("data", 16, 1);
+			expect("extensible fmt", b.Finish(), WaveParseResult::Ok, 16);
+		}
+		{
+			// RIFFの大きさが実際より大きい
+			WaveBuilder b;
+			b.Format(16);
+			b.Chunk("data", 64, 1);
+			expect("riff size too large", b.Finish(8), WaveParseResult::Ok, 64);
+		}
+		{
+			// 終わりに半端なバイトがある
+			WaveBuilder b;
+			b.Format(16);
+			b.Chunk("data", 64, 1);
+			b.Append("xyz", 3);
+			expect("trailing bytes", b.Finish(), WaveParseResult::Ok, 64);
+		}
+		{
+			WaveBuilder b;
+			b.Format(16);
+			b.Chunk("data", 64, 1);
+			std::vector<uint8_t>& bytes = b.Finish();
+			bytes.resize(bytes.size() - 1);
+			expect("data cut short", bytes, WaveParseResult::Truncated);
+		}
+		{
+			WaveBuilder b;
+			b.Format(16);
+			b.Append("LIST", 4);
+			b.AppendU32(0xFFFFFFFFu);
+			b.Chunk("data", 64, 1);
+			expect("huge chunk size", b.Finish(), WaveParseResult::Truncated);
+		}
+		{
+			// RIFFの大きさより後ろのチャンクは見ない
+			WaveBuilder b;
+			b.Format(16);
+			size_t riffSize = b.bytes.size() - 8;
+			b.Chunk("data", 64, 1);
+			std::vector<uint8_t>& bytes = b.Finish();
+			uint32_t size32 = static_cast<uint32_t>(riffSize);
+			std::memcpy(bytes.data() + 4, &size32, sizeof(size32));
+			expect("data after riff end", bytes, WaveParseResult::MissingData);
+		}
+		{
+			WaveBuilder b;
+			b.Format(14);
+			b.Chunk("data", 64, 1);
+			expect("fmt too small", b.Finish(), WaveParseResult::BadFormat);
+		}
+		{
+			WaveBuilder b;
+			b.Format(18, 22);
+			b.Chunk("data", 64, 1);
+			expect("cbSize past fmt", b.Finish(), WaveParseResult::BadFormat);
+		}
+		{
+			WaveBuilder b;
+			b.Chunk("data", 64, 1);
+			expect("no fmt", b.Finish(), WaveParseResult::MissingFormat);
+		}
+		{
+			WaveBuilder b;
+			b.Format(16);
+			b.Chunk("LIST", 26);
+			expect("no data", b.Finish(), WaveParseResult::MissingData);
+		}
+		{
+			WaveBuilder b;
+			b.bytes[8] = 'A';
+			b.Format(16);
+			b.Chunk("data", 64, 1);
+			expect("not WAVE", b.Finish(), WaveParseResult::NotRiff);
+		}
+		{
+			std::vector<uint8_t> bytes = { 'R', 'I', 'F', 'F', 0, 0 };
+			expect("too short", bytes, WaveParseResult::NotRiff);
+		}
+		{
+			// 16バイトのfmtはcbSize=0のWAVEFORMATEXに広げる
+			WaveBuilder b;
+			b.Format(16);
+			b.Chunk("data", 4, 1);
+			std::vector<uint8_t>& bytes = b.Finish();
+			WaveView view;
+			std::vector<uint8_t> format;
+			WaveParser::Parse(bytes.data(), bytes.size(), view);
+			WaveParser::CopyFormat(view, format);
+			uint16_t cbSize = 0xFFFF;
+			if (format.size() == WaveParser::kFormatExSize) {
+				std::memcpy(&cbSize, format.data() + 16, sizeof(cbSize));
+			}
+			if (cbSize != 0 || std::memcmp(format.data(), view.format, 16) != 0) {
+				Log("TestWaveParser: FAILED CopyFormat\n");
+				failedCount++;
+			}
+		}
+
+		Log("TestWaveParser: " + std::to_string(failedCount) + " failed\n");
+		return failedCount == 0;
+	}
+
+	bool BenchmarkWaveParser(const std::string& directoryPath) {
+		namespace fs = std::filesystem;
+		const int kRepeat = 20;
+
+		size_t totalBytes = 0;
+		size_t fileCount = 0;
+		size_t legacyFailCount = 0;
+		size_t failCount = 0;
+		double legacySeconds = 0.0;
+		double loadSeconds = 0.0;
+		double parseSeconds = 0.0;
+
+		std::error_code ec;
+		for (const fs::directory_entry& entry : fs::directory_iterator(directoryPath, ec)) {
+			if (!entry.is_regular_file() || entry.path().extension() != ".wav") {
+				continue;
+			}
+			const std::string path = entry.path().string();
+			std::vector<uint8_t> legacyFormat;
+			std::vector<uint8_t> legacyData;
+			std::vector<uint8_t> bytes;
+			WaveView view;
+			bool legacyOk = true;
+			bool ok = true;
+
+			// 以前の読み方(ヘッダーごとにread)
+			auto start = std::chrono::steady_clock::now();
+			for (int i = 0; i < kRepeat; ++i) {
+				legacyOk = ParseWaveLegacy(path, legacyFormat, legacyData) && legacyOk;
+			}
+			auto legacyEnd = std::chrono::steady_clock::now();
+
+			// SoundBankと同じ読み方(1回で読んで中を指す)
+			for (int i = 0; i < kRepeat; ++i) {
+				ok = WaveParser::ReadFile(path, bytes) && WaveParser::Parse(bytes.data(), bytes.size(), view) == WaveParseResult::Ok && ok;
+			}
+			auto loadEnd = std::chrono::steady_clock::now();
+
+			// 解析だけ
+			uint64_t parsedBytes = 0;
+			for (int i = 0; i < kRepeat; ++i) {
+				WaveParser::Parse(bytes.data(), bytes.size(), view);
+				parsedBytes += view.dataSize;
+			}
+			auto parseEnd = std::chrono::steady_clock::now();
+
+			if (!ok || parsedBytes != static_cast<uint64_t>(view.dataSize) * kRepeat) {
+				Log("BenchmarkWaveParser: failed " + path + "\n");
+				failCount++;
+				continue;
+			}
+			if (!legacyOk) {
+				legacyFailCount++;
+			}
+			else if (legacyData.size() != view.dataSize || std::memcmp(legacyData.data(), view.data, view.dataSize) != 0) {
+				Log("BenchmarkWaveParser: mismatch " + path + "\n");
+				failCount++;
+			}
+
+			fileCount++;
+			totalBytes += bytes.size() * kRepeat;
+			legacySeconds += std::chrono::duration<double>(legacyEnd - start).count();
+			loadSeconds += std::chrono::duration<double>(loadEnd - legacyEnd).count();
+			parseSeconds += std::chrono::duration<double>(parseEnd - loadEnd).count();
+		}
+
+		if (fileCount == 0 || legacySeconds <= 0.0 || loadSeconds <= 0.0) {
+			Log("BenchmarkWaveParser: no wav files\n");
+			return failCount == 0;
+		}
+		double megaBytes = static_cast<double>(totalBytes) / (1024.0 * 1024.0);
+		double parseMicroseconds = parseSeconds * 1.0e6 / static_cast<double>(fileCount * kRepeat);
+		Log("BenchmarkWaveParser: " + std::to_string(fileCount) + " files, " + std::to_string(megaBytes) +
+			"MB, legacy " + std::to_string(megaBytes / legacySeconds) + "MB/s (" + std::to_string(legacyFailCount) +
+			" unreadable), bulk read " + std::to_string(megaBytes / loadSeconds) + "MB/s, parse " +
+			std::to_string(parseMicroseconds) + "us/file, failures " + std::to_string(failCount) + "\n");
+		return failCount == 0;
+	}
+
+	bool BenchmarkMusicStream(const std::string& directoryPath) {
+		namespace fs = std::filesystem;
+
+		size_t fileCount = 0;
+		size_t mismatchCount = 0;
+		uint64_t totalBytes = 0;
+		size_t largestFileBytes = 0;
+		double totalSeconds = 0.0;
+		double maxFirstChunkMilliseconds = 0.0;
+
+		std::error_code ec;
+		for (const fs::directory_entry& entry : fs::directory_iterator(directoryPath, ec)) {
+			if (!entry.is_regular_file() || entry.path().extension() != ".wav") {
+				continue;
+			}
+			const std::string path = entry.path().string();
+
+			// 丸ごと読んだ結果を正解にする
+			SoundBuffer expected;
+			if (!SoundBank::LoadFile(path, expected)) {
+				continue;
+			}
+			const uint8_t* expectedData = expected.data;
+			const size_t expectedSize = expected.dataSize;
+
+			// 1回通して読む
+			MusicStream stream;
+			NullMusicSink sink;
+			if (!stream.Open(path)) {
+				Log("BenchmarkMusicStream: open failed " + path + "\n");
+				mismatchCount++;
+				continue;
+			}
+			auto start = std::chrono::steady_clock::now();
+			stream.Start(sink, false);
+			stream.WaitForEnd();
+			totalSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+			if (!sink.IsEnded() || sink.GetReceivedBytes() != expectedSize ||
+				sink.GetHash() != NullMusicSink::Hash(expectedData, expectedSize) ||
+				stream.GetFormat() != expected.format) {
+				Log("BenchmarkMusicStream: mismatch " + path + "\n");
+				mismatchCount++;
+			}
+
+			// ループ: 2周半以上流して止め、受け取った分が曲を繰り返したものと一致すること
+			MusicStream loopStream;
+			NullMusicSink loopSink;
+			loopStream.Open(path);
+			loopStream.Start(loopSink, true);
+			while (loopStream.IsDecoding() && loopSink.GetReceivedBytes() < expectedSize * 5 / 2 + MusicStream::kChunkSize) {
+				std::this_thread::yield();
+			}
+			loopStream.Stop();
+
+			uint64_t hash = NullMusicSink::kHashBasis;
+			uint64_t remaining = loopSink.GetReceivedBytes();
+			while (remaining > 0) {
+				size_t size = static_cast<size_t>((std::min)(remaining, static_cast<uint64_t>(expectedSize)));
+				hash = NullMusicSink::Hash(expectedData, size, hash);
+				remaining -= size;
+			}
+			if (hash != loopSink.GetHash()) {
+				Log("BenchmarkMusicStream: loop mismatch " + path + "\n");
+				mismatchCount++;
+			}
+
+			fileCount++;
+			totalBytes += expectedSize;
+			largestFileBytes = (std::max)(largestFileBytes, expectedSize);
+			maxFirstChunkMilliseconds = (std::max)(maxFirstChunkMilliseconds, stream.GetFirstChunkMilliseconds());
+		}
+
+		if (fileCount == 0 || totalSeconds <= 0.0) {
+			Log("BenchmarkMusicStream: no wav files\n");
+			return mismatchCount == 0;
+		}
+		double megaBytes = static_cast<double>(totalBytes) / (1024.0 * 1024.0);
+		Log("BenchmarkMusicStream: " + std::to_string(fileCount) + " files, " + std::to_string(megaBytes) + "MB, " +
+			std::to_string(megaBytes / totalSeconds) + "MB/s, first chunk max " + std::to_string(maxFirstChunkMilliseconds) +
+			"ms, buffer " + std::to_string(MusicStream::GetBufferBytes() / 1024) + "KB (largest file " + std::to_string(largestFileBytes / 1024) +
+			"KB), mismatches " + std::to_string(mismatchCount) + "\n");
+		return mismatchCount == 0;
+	}
+
+	bool BenchmarkSoundMixer() {
+		const uint32_t kCannonCount = 256;
+		const uint32_t kFrameCount = 600;
+		const float kFireInterval = 3.0f;
+		const float kDeltaTime = 1.0f / 60.0f;
+
+		// 1秒・44.1kHz・16bitステレオ相当の波形(中身は使わない)
+		SoundBuffer sound;
+		sound.format.resize(18);
+		const uint32_t bytesPerSecond = 44100 * 4;
+		std::memcpy(sound.format.data() + kAvgBytesPerSecOffset, &bytesPerSecond, sizeof(bytesPerSecond));
+		sound.file.resize(bytesPerSecond);
+		sound.data = sound.file.data();
+		sound.dataSize = bytesPerSecond;
+
+		NullMixerBackend backend;
+		SoundMixer mixer;
+		mixer.Initialize(&backend);
+		mixer.SetListenerPosition({ 0.0f, 0.0f, 0.0f });
+
+		// 大砲の位置と発射タイマー(最初の1/4は同じフレームに撃ち、残りはばらける)
+		FastRandom random(1357);
+		std::vector<Vector3> positions(kCannonCount);
+		std::vector<float> timers(kCannonCount, 0.0f);
+		for (uint32_t i = 0; i < kCannonCount; ++i) {
+			positions[i] = { random.NextFloat(-100.0f, 100.0f), 0.0f, random.NextFloat(-100.0f, 100.0f) };
+			if (i >= kCannonCount / 4) {
+				timers[i] = random.NextFloat(0.0f, kFireInterval);
+			}
+		}
+
+		uint32_t fireCount = 0;
+		uint32_t maxActiveVoices = 0;
+		double maxFrameMicroseconds = 0.0;
+		double totalMicroseconds = 0.0;
+		for (uint32_t frame = 0; frame < kFrameCount; ++frame) {
+			auto start = std::chrono::steady_clock::now();
+			mixer.Update();
+			for (uint32_t i = 0; i < kCannonCount; ++i) {
+				timers[i] -= kDeltaTime;
+				if (timers[i] <= 0.0f) {
+					mixer.Play3D(&sound, 0.4f, 0, positions[i]);
+					timers[i] += kFireInterval;
+					fireCount++;
+				}
+			}
+			double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+			totalMicroseconds += microseconds;
+			maxFrameMicroseconds = (std::max)(maxFrameMicroseconds, microseconds);
+			maxActiveVoices = (std::max)(maxActiveVoices, mixer.GetActiveVoiceCount());
+			backend.Advance(kDeltaTime);
+		}
+
+		Log("BenchmarkSoundMixer: " + std::to_string(kCannonCount) + " cannons, " + std::to_string(fireCount) +
+			" shots, voices started " + std::to_string(backend.GetStartCount()) + ", max active " + std::to_string(maxActiveVoices) +
+			"/" + std::to_string(SoundMixer::kVoiceCount) + ", stolen " + std::to_string(mixer.GetStolenCount()) +
+			", capped " + std::to_string(mixer.GetCappedCount()) + ", rejected " + std::to_string(mixer.GetRejectedCount()) +
+			", frame avg " + std::to_string(totalMicroseconds / kFrameCount) + "us max " + std::to_string(maxFrameMicroseconds) + "us\n");
+		mixer.Finalize();
+		return true;
+	}
+}
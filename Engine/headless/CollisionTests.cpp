@@ -0,0 +1,80 @@
+// ステージ障害物のブロードフェーズの計測
+#include "SelfTest.h"
+#include "CollisionWorld.h"
+#include "StageCollisionCache.h"
+#include "GameData.h"
+#include <chrono>
+#include <vector>
+
+namespace SelfTest {
+	bool BenchmarkStageCollision(int stageNumber) {
+		std::vector<AABB> obstacles;
+		std::string stageFile = "resource/Object/stage" + std::to_string(stageNumber) + "/stage" + std::to_string(stageNumber) + ".obj";
+		if (!StageCollisionCache::LoadOrBuild(stageFile, obstacles)) {
+			Log("BenchmarkStageCollision: " + stageFile + " could not be loaded\n");
+			return false;
+		}
+		CollisionWorld collisionWorld;
+		collisionWorld.Build(std::move(obstacles));
+
+		// 開始位置のプレイヤーくらいの範囲で問い合わせる
+		const Vector3& position = PlayerPosition::stage[stageNumber];
+		AABB area = { { position.x - 1.0f, position.y - 1.0f, position.z - 1.0f }, { position.x + 1.0f, position.y + 1.0f, position.z + 1.0f } };
+
+		// 総当たりとグリッドの比較
+		const int kQueryCount = 1000;
+		int hits = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < kQueryCount; ++i) {
+			for (const AABB& box : collisionWorld.GetBoxes()) {
+				hits += IsCollisionAABB(area, box) ? 1 : 0;
+			}
+		}
+		auto mid = std::chrono::steady_clock::now();
+		std::vector<uint32_t> candidates;
+		for (int i = 0; i < kQueryCount; ++i) {
+			collisionWorld.GetGrid().Query(area, candidates);
+			for (uint32_t index : candidates) {
+				hits += IsCollisionAABB(area, collisionWorld.GetBox(index)) ? 1 : 0;
+			}
+		}
+		auto end = std::chrono::steady_clock::now();
+		double bruteMicroseconds = std::chrono::duration<double, std::micro>(mid - start).count() / kQueryCount;
+		double gridMicroseconds = std::chrono::duration<double, std::micro>(end - mid).count() / kQueryCount;
+
+		// 一括判定(SIMD)とスカラー版のスループット比較
+		AABBSoA boxes;
+		boxes.Reserve(collisionWorld.GetBoxCount());
+		for (const AABB& box : collisionWorld.GetBoxes()) {
+			boxes.Push(box);
+		}
+		std::vector<uint32_t> scalarHits;
+		std::vector<uint32_t> batchHits;
+		scalarHits.reserve(boxes.Size());
+		batchHits.reserve(boxes.Size());
+
+		start = std::chrono::steady_clock::now();
+		for (int i = 0; i < kQueryCount; ++i) {
+			scalarHits.clear();
+			IsCollisionAABBBatchScalar(area, boxes, scalarHits);
+		}
+		mid = std::chrono::steady_clock::now();
+		for (int i = 0; i < kQueryCount; ++i) {
+			batchHits.clear();
+			IsCollisionAABBBatch(area, boxes, batchHits);
+		}
+		end = std::chrono::steady_clock::now();
+
+		double tested = static_cast<double>(boxes.Size()) * kQueryCount;
+		double scalarBoxesPerSecond = tested / std::chrono::duration<double>(mid - start).count();
+		double batchBoxesPerSecond = tested / std::chrono::duration<double>(end - mid).count();
+
+		bool isSame = scalarHits == batchHits;
+		Log("BenchmarkStageCollision: stage" + std::to_string(stageNumber) + " obstacles " + std::to_string(collisionWorld.GetBoxCount()) +
+			", brute " + std::to_string(bruteMicroseconds) + "us, grid " + std::to_string(gridMicroseconds) +
+			"us (" + std::to_string(candidates.size()) + " candidates, hits " + std::to_string(hits) + "), batch " +
+			std::to_string(batchBoxesPerSecond / 1.0e6) + " Mboxes/s, scalar " + std::to_string(scalarBoxesPerSecond / 1.0e6) +
+			" Mboxes/s (" + std::to_string(batchHits.size()) + " hits)" + (isSame ? "" : ", batch differs from scalar") + "\n");
+		return isSame;
+	}
+}
@@ -0,0 +1,111 @@
+// Headlessプロジェクトの入口
+// 使い方: Headless.exe [ステージ番号(0〜6)] [ティック数] [シード]
+//         Headless.exe replay 記録ファイル
+//         Headless.exe test   (SelfTestのテストを全部動かす。失敗があれば1を返す)
+//         Headless.exe bench  (SelfTestの計測を全部動かす)
+//         Headless.exe bake フォルダ (フォルダ/Object以下のOBJを.mdlに変換する。失敗があれば1を返す)
+// 描画も待ちもせずに指定したティック数だけステージを回し、1秒あたりのティック数と状態のハッシュを出す
+// 同じシード(と同じ記録)なら毎回同じハッシュになる
+#include "HeadlessStage.h"
+#include "Audio.h"
+#include "Input.h"
+#include "TextureManager.h"
+#include "ParticleCommon.h"
+#include "ParticleManager.h"
+#include "GameTimer.h"
+#include "GameRandom.h"
+#include "TraceRecorder.h"
+#include "Logger.h"
+#include "SelfTest.h"
+#include "ModelBinary.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+int main(int argc, char* argv[]) {
+	TraceRecorder::GetInstance()->SetThreadName("Main");
+	if (argc > 1 && (std::string(argv[1]) == "test" || std::string(argv[1]) == "bench")) {
+		bool isPassed = std::string(argv[1]) == "test" ? SelfTest::RunTests() : SelfTest::RunBenchmarks();
+		TraceRecorder::GetInstance()->Finalize();
+		return isPassed ? 0 : 1;
+	}
+	if (argc > 2 && std::string(argv[1]) == "bake") {
+		int bakedCount = 0;
+		bool isSucceeded = ModelBinary::BakeDirectory(argv[2], bakedCount);
+		std::printf("baked %d models%s\n", bakedCount, isSucceeded ? "" : " (some failed)");
+		TraceRecorder::GetInstance()->Finalize();
+		return isSucceeded ? 0 : 1;
+	}
+
+	Input* input = Input::GetInstance();
+	input->Initialize(nullptr);
+
+	int stageNumber = 1;
+	uint64_t tickCount = 36000;
+	uint64_t seed = 1;
+	if (argc > 2 && std::string(argv[1]) == "replay") {
+		// 記録したステージとシードで、記録したtick数だけ回す
+		if (!input->StartReplay(argv[2])) {
+			std::printf("%s could not be read\n", argv[2]);
+			input->Finalize();
+			return 1;
+		}
+		const InputRecordHeader& header = input->GetReplayHeader();
+		stageNumber = static_cast<int>(header.stage);
+		tickCount = header.frameCount;
+		seed = header.seed;
+	} else {
+		stageNumber = argc > 1 ? std::atoi(argv[1]) : stageNumber;
+		tickCount = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : tickCount;
+		seed = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : seed;
+	}
+	if (stageNumber < 0 || stageNumber > 6 || tickCount == 0) {
+		std::printf("usage: Headless [stage(0-6)] [ticks] [seed]\n       Headless replay <file>\n       Headless test\n       Headless bench\n       Headless bake <dir>\n");
+		input->Finalize();
+		return 1;
+	}
+
+	Audio::GetInstance()->Initialize();
+
+	HeadlessStage* stage = new HeadlessStage();
+	bool isLoaded = stage->Initialize(stageNumber, seed);
+	if (!isLoaded) {
+		std::printf("stage%d could not be loaded\n", stageNumber);
+	}
+
+	// 実時間は見ずに、1ティックずつ進める
+	GameTimer* gameTimer = GameTimer::GetInstance();
+	auto start = std::chrono::steady_clock::now();
+	for (uint64_t i = 0; isLoaded && i < tickCount; ++i) {
+		gameTimer->Advance(gameTimer->GetDeltaTime());
+		while (gameTimer->Step()) {
+			stage->Update();
+		}
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	if (isLoaded) {
+		uint64_t ticks = gameTimer->GetTickCount();
+		std::string result = "Headless: stage" + std::to_string(stageNumber) + " " + std::to_string(ticks) + " ticks in " +
+			std::to_string(seconds) + "s, " + std::to_string(ticks / seconds) + " ticks/s (" +
+			std::to_string(seconds * 1000000.0 / ticks) + "us/tick), restarts " + std::to_string(stage->GetRestartCount()) +
+			", clears " + std::to_string(stage->GetClearCount()) + "\n";
+		char hashText[32];
+		std::snprintf(hashText, sizeof(hashText), "%016llx", static_cast<unsigned long long>(stage->GetStateHash()));
+		result += "Headless: seed " + std::to_string(seed) + ", state hash " + hashText + "\n";
+		std::printf("%s", result.c_str());
+		Logger::log(result);
+	}
+
+	delete stage;
+	ParticleManager::GetInstance()->Finalize();
+	ParticleCommon::GetInstance()->Finalize();
+	TextureManager::GetInstance()->Finalize();
+	Audio::GetInstance()->Finalize();
+	input->Finalize();
+	gameTimer->Finalize();
+	GameRandom::GetInstance()->Finalize();
+	TraceRecorder::GetInstance()->Finalize();
+	return isLoaded ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+#include "HeadlessStage.h"
+#include "Audio.h"
+#include "Input.h"
+#include "ParticleCommon.h"
+#include "StageCollisionCache.h"
+#include "GameData.h"
+#include "GameRandom.h"
+#include "ParticleEmitter.h"
+#include "StateHash.h"
+#include "TraceRecorder.h"
+
+HeadlessStage::~HeadlessStage() {
+	Finalize();
+}
+
+bool HeadlessStage::Initialize(int stageNumber, uint64_t seed) {
+	stageNumber_ = stageNumber;
+	restartCount_ = 0;
+	clearCount_ = 0;
+	stateHash_ = StateHash::kInitialHash;
+
+	// 敵は作るときに乱数を使うので、Setupより前に揃える
+	GameRandom::GetInstance()->Seed(seed);
+	ParticleEmitter::GetInstance()->SetSeed(seed);
+	return Setup();
+}
+
+void HeadlessStage::Finalize() {
+	delete camera_;
+	camera_ = nullptr;
+	delete player_;
+	player_ = nullptr;
+	delete mapLoader_;
+	mapLoader_ = nullptr;
+	delete enemyLoader_;
+	enemyLoader_ = nullptr;
+
+	collisionWorld_.Clear();
+}
+
+bool HeadlessStage::Setup() {
+	// GameScene::Initializeと同じ順番で作る
+	camera_ = new Camera();
+	ParticleCommon::GetInstance()->SetDefaultCamera(camera_);
+
+	player_ = new Player();
+	player_->Init(camera_);
+
+	mapLoader_ = new MapLoader();
+	std::string objectsFile = "resource/objects" + std::to_string(stageNumber_) + ".csv";
+	if (mapLoader_->LoadMapData(objectsFile)) {
+		mapLoader_->CreateObjects(player_);
+	}
+
+	player_->SetPosition(PlayerPosition::stage[stageNumber_]);
+
+	// 障害物情報の読み込み
+	std::vector<AABB> obstacles;
+	std::string stageFile = "resource/Object/stage" + std::to_string(stageNumber_) + "/stage" + std::to_string(stageNumber_) + ".obj";
+	if (!StageCollisionCache::LoadOrBuild(stageFile, obstacles)) {
+		return false;
+	}
+	collisionWorld_.Build(std::move(obstacles));
+	player_->SetCollisionWorld(&collisionWorld_);
+
+	enemyLoader_ = new EnemyLoader();
+	std::string enemiesFile = "resource/enemies" + std::to_string(stageNumber_) + ".csv";
+	if (enemyLoader_->LoadEnemyData(enemiesFile)) {
+		enemyLoader_->CreateEnemies(player_, &collisionWorld_);
+	}
+
+	player_->SetGhostEnemies(enemyLoader_->GetGhostList());
+	player_->SetCannonEnemies(enemyLoader_->GetCannonEnemyList());
+	player_->SetSpringEnemies(enemyLoader_->GetSpringEnemyList());
+
+	const std::vector<Block*>& blocks = mapLoader_->GetBlockList();
+	player_->SetBlocks(blocks);
+	for (CannonEnemy* cannon : enemyLoader_->GetCannonEnemyList()) {
+		cannon->SetBlocks(blocks);
+	}
+	for (SpringEnemy* spring : enemyLoader_->GetSpringEnemyList()) {
+		spring->SetBlocks(blocks);
+	}
+
+	player_->SetGhostBlocks(mapLoader_->GetGhostBlockList());
+	player_->SetDoor(mapLoader_->GetDoorList());
+
+	if (mapLoader_->GetGoal()) {
+		player_->SetGoal(mapLoader_->GetGoal());
+	}
+	return true;
+}
+
+void HeadlessStage::Update() {
+	TRACE_SCOPE("HeadlessStage::Update");
+
+	// Framework::Updateの代わり
+	Input::GetInstance()->Update();
+	Audio::GetInstance()->Update();
+
+	// ゴールしたか、死んでデスパーティクルが終わったら作り直す
+	bool isClear = mapLoader_->GetGoal() && mapLoader_->GetGoal()->IsClear();
+	bool isOver = player_->GetHp() <= 0 && !player_->GetDeadPlayer();
+	if (isClear || isOver) {
+		if (isClear) {
+			clearCount_++;
+		}
+		restartCount_++;
+		Finalize();
+		Setup();
+		stateHash_ = StateHash::Combine(stateHash_, restartCount_);
+		return;
+	}
+
+	// GameScene::Updateのゲーム部分
+	camera_->Update();
+
+	player_->Update();
+	Audio::GetInstance()->SetListenerPosition(player_->GetWorldPosition());
+
+	enemyLoader_->Update();
+	mapLoader_->Update();
+
+	stateHash_ = StateHash::Combine(stateHash_, StateHash::Compute(player_, enemyLoader_, mapLoader_));
+}
+
+void HeadlessStage::Draw() {
+	player_->Draw();
+	enemyLoader_->Draw();
+	mapLoader_->Draw();
+}
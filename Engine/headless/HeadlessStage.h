@@ -0,0 +1,50 @@
+#pragma once
+#include "Camera.h"
+#include "Player.h"
+#include "CollisionWorld.h"
+#include "MapLoader.h"
+#include "EnemyLoader.h"
+#include <cstdint>
+
+// ウィンドウとGPUなしでステージを動かす(GameSceneからUI、BGM、天球、ポーズ、フェードを除いたもの)
+// プレイヤーが死ぬかゴールしたら同じステージを作り直して続ける
+class HeadlessStage {
+public:
+	HeadlessStage() = default;
+	~HeadlessStage();
+	HeadlessStage(const HeadlessStage&) = delete;
+	HeadlessStage& operator=(const HeadlessStage&) = delete;
+
+	// ステージを読み込む(stage.objが開けなければfalse)
+	// 乱数はseedで始めるので、同じ入力なら毎回同じ状態になる
+	bool Initialize(int stageNumber, uint64_t seed);
+	void Finalize();
+
+	// 1ティック進める
+	void Update();
+
+	// GameScene::Drawのモデル描画と同じ順番で描く(Object3dはNullRenderなので何も積まない)
+	void Draw();
+
+	// 作り直した回数
+	uint32_t GetRestartCount() const { return restartCount_; }
+	uint32_t GetClearCount() const { return clearCount_; }
+
+	// 最初のtickからの状態のハッシュ(StateHash)
+	uint64_t GetStateHash() const { return stateHash_; }
+
+private:
+	bool Setup();
+
+	int stageNumber_ = 1;
+
+	Camera* camera_ = nullptr;
+	Player* player_ = nullptr;
+	MapLoader* mapLoader_ = nullptr;
+	EnemyLoader* enemyLoader_ = nullptr;
+	CollisionWorld collisionWorld_;
+
+	uint32_t restartCount_ = 0;
+	uint32_t clearCount_ = 0;
+	uint64_t stateHash_ = 0;
+};
@@ -0,0 +1,83 @@
+// InputRecorder/InputPlaybackのテスト
+#include "SelfTest.h"
+#include "InputRecording.h"
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+namespace {
+	bool IsSameFrame(const InputFrame& a, const InputFrame& b) {
+		return std::memcmp(a.keys, b.keys, sizeof(a.keys)) == 0 && std::memcmp(&a.pad, &b.pad, sizeof(a.pad)) == 0 && a.isPadConnected == b.isPadConnected;
+	}
+}
+
+namespace SelfTest {
+	bool TestInputRecorder() {
+		int failedCount = 0;
+		auto check = [&failedCount](bool condition, const std::string& name) {
+			if (!condition) {
+				Log("TestInputRecorder: FAILED " + name + "\n");
+				failedCount++;
+			}
+		};
+		const std::string filePath = (std::filesystem::temp_directory_path() / "TestInputRecorder.rec").string();
+
+		// 600tick: 100tickごとにキーを押し替え、パッドのスティックは150tickの間だけ倒す
+		const uint32_t kFrameCount = 600;
+		std::vector<InputFrame> frames(kFrameCount);
+		for (uint32_t i = 0; i < kFrameCount; ++i) {
+			InputFrame& frame = frames[i];
+			frame = {};
+			frame.SetKey(0x39, (i / 100) % 2 == 1); // SPACE
+			frame.SetKey(0x11, i >= 300);           // W
+			frame.SetKey(0xFF, i == 599);
+			frame.isPadConnected = i >= 50;
+			if (i >= 200 && i < 350) {
+				frame.pad.thumbLX = 20000;
+				frame.pad.buttons = 0x1000; // A
+			}
+		}
+
+		{
+			InputRecorder recorder;
+			check(recorder.Open(filePath, 0x123456789ABCDEFull, 3), "open for writing");
+			for (const InputFrame& frame : frames) {
+				recorder.Write(frame);
+			}
+			recorder.Close(0xFEDCBA9876543210ull);
+		}
+		{
+			InputPlayback playback;
+			check(playback.Open(filePath), "open for reading");
+			const InputRecordHeader& header = playback.GetHeader();
+			check(header.seed == 0x123456789ABCDEFull && header.stage == 3, "header keeps seed and stage");
+			check(header.frameCount == kFrameCount && header.stateHash == 0xFEDCBA9876543210ull, "header keeps frame count and hash");
+
+			uint32_t mismatchCount = 0;
+			InputFrame frame;
+			for (uint32_t i = 0; i < kFrameCount; ++i) {
+				if (!playback.Read(frame) || !IsSameFrame(frame, frames[i])) {
+					mismatchCount++;
+				}
+			}
+			check(mismatchCount == 0, "every frame reads back (" + std::to_string(mismatchCount) + " mismatched)");
+			check(playback.IsFinished() && !playback.Read(frame), "stops after the last frame");
+			check(frames[599].IsKeyDown(0xFF) && !frames[598].IsKeyDown(0xFF), "key bits");
+		}
+
+		// 変わらないtickは1バイト(このパターンだと600tickで1KB未満)
+		const uintmax_t fileSize = std::filesystem::file_size(filePath);
+		check(fileSize < sizeof(InputRecordHeader) + kFrameCount + 1024, "file is compact (" + std::to_string(fileSize) + " bytes)");
+
+		{
+			// 途中で切れたファイルは読まない
+			std::filesystem::resize_file(filePath, fileSize - 5);
+			InputPlayback playback;
+			check(!playback.Open(filePath), "truncated file is rejected");
+		}
+		std::filesystem::remove(filePath);
+
+		Log("TestInputRecorder: " + std::to_string(failedCount) + " failed\n");
+		return failedCount == 0;
+	}
+}
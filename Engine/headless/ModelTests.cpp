@@ -0,0 +1,179 @@
+// ObjLoaderの計測とモデル描画のテスト
+#include "SelfTest.h"
+#include "ObjLoader.h"
+#include "MappedFile.h"
+#include "HeadlessStage.h"
+#include "AllocationCounter.h"
+#include "Audio.h"
+#include "Input.h"
+#include "TextureManager.h"
+#include "ParticleCommon.h"
+#include "ParticleManager.h"
+#include "GameRandom.h"
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+
+namespace {
+	// 以前のistringstreamによる解析
+	void ParseObjLegacy(const std::string& text, ModelData& modelData, std::string& materialFilename) {
+		std::vector<Vector4> positions;
+		std::vector<Vector3> normals;
+		std::vector<Vector2> texcoords;
+		std::string line;
+		std::istringstream file(text);
+
+		while (std::getline(file, line)) {
+			std::string identifier;
+			std::istringstream s(line);
+			s >> identifier;
+
+			if (identifier == "v") {
+				Vector4 position;
+				s >> position.x >> position.y >> position.z;
+				position.s = 1.0f;
+				position.x *= -1.0f;
+				positions.push_back(position);
+			}
+			else if (identifier == "vt") {
+				Vector2 texcoord;
+				s >> texcoord.x >> texcoord.y;
+				texcoord.y = 1.0f - texcoord.y;
+				texcoords.push_back(texcoord);
+			}
+			else if (identifier == "vn") {
+				Vector3 normal;
+				s >> normal.x >> normal.y >> normal.z;
+				normal.x *= -1.0f;
+				normals.push_back(normal);
+			}
+			else if (identifier == "f") {
+				VertexData triangle[3];
+				for (int32_t faceVertex = 0; faceVertex < 3; ++faceVertex) {
+					std::string vertexDefinition;
+					s >> vertexDefinition;
+
+					std::istringstream v(vertexDefinition);
+					uint32_t elementIndices[3];
+					for (int32_t element = 0; element < 3; ++element) {
+						std::string index;
+						std::getline(v, index, '/');
+						elementIndices[element] = std::stoi(index);
+					}
+					triangle[faceVertex] = { positions[elementIndices[0] - 1], texcoords[elementIndices[1] - 1], normals[elementIndices[2] - 1] };
+				}
+				modelData.vertices.push_back(triangle[2]);
+				modelData.vertices.push_back(triangle[1]);
+				modelData.vertices.push_back(triangle[0]);
+			}
+			else if (identifier == "mtllib") {
+				s >> materialFilename;
+			}
+		}
+	}
+}
+
+namespace SelfTest {
+	bool BenchmarkObjLoader(const std::string& directoryPath) {
+		namespace fs = std::filesystem;
+		const int kRepeat = 20;
+
+		size_t totalBytes = 0;
+		size_t mismatchCount = 0;
+		double legacySeconds = 0.0;
+		double fastSeconds = 0.0;
+
+		std::error_code ec;
+		for (const fs::directory_entry& entry : fs::recursive_directory_iterator(directoryPath + "/Object", ec)) {
+			if (!entry.is_regular_file() || entry.path().extension() != ".obj") {
+				continue;
+			}
+
+			MappedFile file;
+			if (!file.Open(entry.path().string())) {
+				continue;
+			}
+			const char* begin = reinterpret_cast<const char*>(file.GetData());
+			const char* end = begin + file.GetSize();
+			std::string text(begin, end);
+
+			ModelData legacyData;
+			ModelData fastData;
+			std::string materialFilename;
+
+			auto start = std::chrono::steady_clock::now();
+			for (int i = 0; i < kRepeat; ++i) {
+				legacyData.vertices.clear();
+				ParseObjLegacy(text, legacyData, materialFilename);
+			}
+			auto mid = std::chrono::steady_clock::now();
+			for (int i = 0; i < kRepeat; ++i) {
+				fastData.vertices.clear();
+				ObjLoader::Parse(begin, end, fastData, materialFilename);
+			}
+			auto finish = std::chrono::steady_clock::now();
+
+			// 新旧で結果が一致すること
+			if (legacyData.vertices.size() != fastData.vertices.size() ||
+				std::memcmp(legacyData.vertices.data(), fastData.vertices.data(), sizeof(VertexData) * fastData.vertices.size()) != 0) {
+				Log("BenchmarkObjLoader: mismatch " + entry.path().string() + "\n");
+				mismatchCount++;
+			}
+
+			totalBytes += file.GetSize() * kRepeat;
+			legacySeconds += std::chrono::duration<double>(mid - start).count();
+			fastSeconds += std::chrono::duration<double>(finish - mid).count();
+		}
+
+		double megaBytes = static_cast<double>(totalBytes) / (1024.0 * 1024.0);
+		if (legacySeconds <= 0.0 || fastSeconds <= 0.0) {
+			Log("BenchmarkObjLoader: no obj files\n");
+			return mismatchCount == 0;
+		}
+		Log("BenchmarkObjLoader: " + std::to_string(megaBytes) + "MB, legacy " +
+			std::to_string(megaBytes / legacySeconds) + "MB/s, fast " +
+			std::to_string(megaBytes / fastSeconds) + "MB/s, mismatches " + std::to_string(mismatchCount) + "\n");
+		return mismatchCount == 0;
+	}
+
+	bool TestDrawAllocations(uint32_t tickCount) {
+		Input* input = Input::GetInstance();
+		input->Initialize(nullptr);
+		Audio::GetInstance()->Initialize();
+
+		// 全ステージで毎tick描画し、その間のヒープ確保を数える(GameScene::Drawの_DEBUGの確認と同じ)
+		int failedCount = 0;
+		for (int stageNumber = 0; stageNumber <= 6; ++stageNumber) {
+			HeadlessStage stage;
+			if (!stage.Initialize(stageNumber, 1)) {
+				Log("TestDrawAllocations: FAILED stage" + std::to_string(stageNumber) + " could not be loaded\n");
+				failedCount++;
+				continue;
+			}
+
+			uint64_t allocations = 0;
+			for (uint32_t i = 0; i < tickCount; ++i) {
+				stage.Update();
+				uint64_t start = AllocationCounter::GetCount();
+				stage.Draw();
+				allocations += AllocationCounter::GetCount() - start;
+			}
+			if (allocations > 0) {
+				Log("TestDrawAllocations: FAILED stage" + std::to_string(stageNumber) + " " + std::to_string(allocations) +
+					" heap allocations in " + std::to_string(tickCount) + " draws\n");
+				failedCount++;
+			}
+		}
+
+		ParticleManager::GetInstance()->Finalize();
+		ParticleCommon::GetInstance()->Finalize();
+		TextureManager::GetInstance()->Finalize();
+		Audio::GetInstance()->Finalize();
+		input->Finalize();
+		GameRandom::GetInstance()->Finalize();
+
+		Log("TestDrawAllocations: " + std::to_string(failedCount) + " failed\n");
+		return failedCount == 0;
+	}
+}
@@ -0,0 +1,80 @@
+// Headlessプロジェクト用の音(鳴らさない)
+// 波形の読み込みとSoundBankの参照カウントはそのまま。効果音はSoundMixerをNullMixerBackendで回す
+// BGMは開かない
+#include "Audio.h"
+#include "GameTimer.h"
+#include <cstring>
+
+Audio* Audio::instance = nullptr;
+
+Audio* Audio::GetInstance() {
+	if (instance == nullptr) {
+		instance = new Audio;
+	}
+	return instance;
+}
+
+MixerBackend* Audio::CreateMixerBackend() {
+	return new NullMixerBackend();
+}
+
+void Audio::Initialize() {
+	mixerBackend_ = CreateMixerBackend();
+	mixer_.Initialize(mixerBackend_);
+}
+
+void Audio::Finalize() {
+	mixer_.Finalize();
+	delete mixerBackend_;
+	mixerBackend_ = nullptr;
+	soundBank_.Clear();
+}
+
+void Audio::Update() {
+	// 鳴っている時間だけ進めてからボイスを空ける
+	if (mixerBackend_) {
+		mixerBackend_->Advance(GameTimer::GetInstance()->GetDeltaTime());
+	}
+	mixer_.Update();
+}
+
+const SoundBuffer* Audio::LoadSE(const char* filename) {
+	const SoundBuffer* sound = soundBank_.Acquire(filename);
+	assert(sound);
+	return sound;
+}
+
+void Audio::UnloadSE(const SoundBuffer*& sound) {
+	mixer_.StopSound(sound);
+	soundBank_.Release(sound);
+	sound = nullptr;
+}
+
+SoundData Audio::LoadWave(const char* filename) {
+	const SoundBuffer* buffer = soundBank_.Acquire(filename);
+	assert(buffer);
+
+	SoundData soundData = {};
+	std::memcpy(&soundData.wfex, buffer->format.data(), sizeof(WAVEFORMATEX));
+	soundData.pBuffer = buffer->data;
+	soundData.byfferSize = buffer->dataSize;
+	soundData.source = buffer;
+	return soundData;
+}
+
+void Audio::UnloadWave(SoundData& soundData) {
+	soundBank_.Release(soundData.source);
+	soundData = {};
+}
+
+bool Audio::PreloadWave(const char* filename) {
+	return soundBank_.Preload(filename);
+}
+
+void Audio::SoundPlayWave([[maybe_unused]] SoundData soundData, [[maybe_unused]] const float volume, [[maybe_unused]] bool isLoop) {}
+
+void Audio::StopWave([[maybe_unused]] SoundData soundData) {}
+
+void Audio::PlayMusic([[maybe_unused]] const char* filename, [[maybe_unused]] const float volume, [[maybe_unused]] bool isLoop) {}
+
+void Audio::StopMusic() {}
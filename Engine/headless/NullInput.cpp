@@ -0,0 +1,72 @@
+// Headlessプロジェクト用の入力(何も押されていない、コントローラーは繋がっていない)
+// 記録した入力を再生しているときはその入力になる
+#include "Input.h"
+#include <cstring>
+
+Input* Input::instance = nullptr;
+
+uint32_t Input::kSRVIndexTop = 1;
+
+Input* Input::GetInstance() {
+	if (instance == nullptr) {
+		instance = new Input;
+	}
+	return instance;
+}
+
+void Input::Finalize() {
+	StopRecording(0);
+	StopReplay();
+	delete instance;
+	instance = nullptr;
+}
+
+void Input::Initialize(WinApp* winApp) {
+	this->winApp_ = winApp;
+}
+
+void Input::Update() {
+	std::memcpy(keyPre, key, sizeof(key));
+	std::memset(key, 0, sizeof(key));
+	std::memset(&padState_, 0, sizeof(XINPUT_STATE));
+	isPadConnected_ = false;
+
+	// 再生中は記録した入力になる
+	ApplyRecording();
+}
+
+bool Input::PushKey(BYTE keyNumber) {
+	return key[keyNumber] != 0;
+}
+
+bool Input::TriggerKey(BYTE keyNumber) {
+	return key[keyNumber] && !keyPre[keyNumber];
+}
+
+bool Input::GetJoystickState(uint32_t num, XINPUT_STATE& state) {
+	prevState = state;
+	if (num == 0) {
+		state = padState_;
+		return isPadConnected_;
+	}
+	std::memset(&state, 0, sizeof(XINPUT_STATE));
+	return false;
+}
+
+bool Input::GetJoystickStatePrevious(uint32_t num, XINPUT_STATE& state) {
+	std::memset(&state, 0, sizeof(XINPUT_STATE));
+	if (num == 0 && isPadConnected_) {
+		state = prevState;
+		return true;
+	}
+	return false;
+}
+
+void Input::SetStates(XINPUT_STATE state, XINPUT_STATE preState) {
+	copyState_ = state;
+	copyPreState_ = preState;
+}
+
+void Input::SetVibration([[maybe_unused]] uint32_t num, [[maybe_unused]] float leftMotor, [[maybe_unused]] float rightMotor) {}
+
+void Input::StopVibration([[maybe_unused]] uint32_t num) {}
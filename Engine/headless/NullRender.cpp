@@ -0,0 +1,78 @@
+// Headlessプロジェクト用の描画(何も描かない)
+// ゲーム側から呼ばれる分だけ、GPUを使わない形で定義する
+// パーティクルの発生と移動はParticle.cppをそのまま使う(描画の書き込みだけ捨てる)
+#include "Object3d.h"
+#include "Sprite.h"
+#include "TextureManager.h"
+#include "ParticleCommon.h"
+#include "ParticleManager.h"
+
+// Object3d
+void Object3d::Initialize() {}
+void Object3d::SetModelFile([[maybe_unused]] const std::string& filePath) {}
+void Object3d::Draw([[maybe_unused]] const WorldTransform& worldTransform) {}
+void Object3d::Draw([[maybe_unused]] const WorldTransform& worldTransform, [[maybe_unused]] D3D12_GPU_DESCRIPTOR_HANDLE textureHandle) {}
+
+// Sprite
+void Sprite::Initialize([[maybe_unused]] std::string textureFilePath) {}
+void Sprite::Update() {}
+
+// TextureManager
+TextureManager* TextureManager::instance = nullptr;
+
+TextureManager* TextureManager::GetInstance() {
+	if (instance == nullptr) {
+		instance = new TextureManager;
+	}
+	return instance;
+}
+
+void TextureManager::Finalize() {
+	delete instance;
+	instance = nullptr;
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE TextureManager::LoadTextureHandle([[maybe_unused]] const std::string& filePath) {
+	return {};
+}
+
+// ParticleCommon(カメラを渡すだけ)
+ParticleCommon* ParticleCommon::instance = nullptr;
+
+ParticleCommon* ParticleCommon::GetInstance() {
+	if (instance == nullptr) {
+		instance = new ParticleCommon;
+	}
+	return instance;
+}
+
+void ParticleCommon::Finalize() {
+	delete instance;
+	instance = nullptr;
+}
+
+// ParticleManager(グループは1つ、書き込み先は渡さない)
+ParticleManager* ParticleManager::instance = nullptr;
+
+ParticleManager* ParticleManager::GetInstance() {
+	if (instance == nullptr) {
+		instance = new ParticleManager();
+	}
+	return instance;
+}
+
+ParticleManager::~ParticleManager() = default;
+
+void ParticleManager::Finalize() {
+	delete instance;
+	instance = nullptr;
+}
+
+uint32_t ParticleManager::GetGroupIndex([[maybe_unused]] const std::string& textureFilePath) {
+	return 0;
+}
+
+ParticleForGPU* ParticleManager::AllocateInstances([[maybe_unused]] uint32_t groupIndex, uint32_t& count) {
+	count = 0;
+	return nullptr;
+}
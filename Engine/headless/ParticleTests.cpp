@@ -0,0 +1,373 @@
+// ParticleStore・ParticleBillboard・ParticleManagerのテストと計測(GPUを使わない)
+#include "SelfTest.h"
+#include "ParticleManager.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <list>
+#include <numbers>
+#include <random>
+#include <vector>
+
+using namespace MyMath;
+
+namespace {
+	// 以前の行列を掛け合わせる版
+	void WriteBillboardReference(const ParticleStore& store, uint32_t index, const Matrix4x4& cameraWorld, const Matrix4x4& viewProjection, ParticleForGPU& out) {
+		Matrix4x4 scaleMatrix = MakeScaleMatrix({ store.scaleX[index], store.scaleY[index], store.scaleZ[index] });
+		Matrix4x4 translateMatrix = MakeTranslateMatrix({ store.translateX[index], store.translateY[index], store.translateZ[index] });
+
+		//回転行列(Z回転のみ)
+		Matrix4x4 rotateX = MakeRotateXMatrix(0.0f);
+		Matrix4x4 rotateY = MakeRotateYMatrix(0.0f);
+		Matrix4x4 rotateZ = MakeRotateZMatrix(store.rotateZ[index]);
+		Matrix4x4 rotateXYZ = Multiply(Multiply(rotateX, rotateY), rotateZ);
+
+		//ビルボード
+		Matrix4x4 backToFrontMatrix = MakeRotateYMatrix(std::numbers::pi_v<float>);
+		Matrix4x4 billboardMatrix = Multiply(Multiply(backToFrontMatrix, rotateXYZ), cameraWorld);
+		billboardMatrix.m[3][0] = 0.0f;
+		billboardMatrix.m[3][1] = 0.0f;
+		billboardMatrix.m[3][2] = 0.0f;
+
+		out.World = Multiply(scaleMatrix, Multiply(billboardMatrix, translateMatrix));
+		out.WVP = Multiply(out.World, viewProjection);
+		out.color = store.color[index];
+		out.color.s = store.alpha[index];
+	}
+}
+
+namespace SelfTest {
+	bool TestParticleIntegrate(uint32_t particleCount) {
+		const int kFrameCount = 60;
+		const float kDeltaTime = 1.0f / 60.0f;
+		// 加算の順番は同じなので、違いが出るのは±0の符号くらい
+		const uint32_t kMaxUlp = 1;
+
+		AccelerationField field;
+		field.acceleration = { 0.0f, 15.0f, 0.0f };
+		field.area.min = { -1.0f, -1.0f, -1.0f };
+		field.area.max = { 1.0f, 1.0f, 1.0f };
+
+		// 場の内外と縮小の境目をまたぐように散らす
+		ParticleStore simd;
+		simd.Initialize(particleCount);
+		std::mt19937 randomEngine(5678);
+		std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+		std::uniform_real_distribution<float> distScale(-0.1f, 1.0f);
+		std::uniform_real_distribution<float> distTime(1.0f, 3.0f);
+		while (!simd.IsFull()) {
+			Particles particle;
+			particle.transform.scale = { distScale(randomEngine), distScale(randomEngine), distScale(randomEngine) };
+			particle.transform.rotate = { 0.0f, 0.0f, 0.0f };
+			particle.transform.translate = { distribution(randomEngine), distribution(randomEngine), distribution(randomEngine) };
+			particle.velocity = { distribution(randomEngine), distribution(randomEngine), distribution(randomEngine) };
+			particle.color = { 1.0f, 1.0f, 1.0f, 1.0f };
+			particle.lifeTime = distTime(randomEngine);
+			particle.currentTime = 0.0f;
+			simd.Add(particle);
+		}
+		ParticleStore scalar = simd;
+
+		using Clock = std::chrono::steady_clock;
+		Clock::duration simdTime{}, scalarTime{};
+		for (int frame = 0; frame < kFrameCount; ++frame) {
+			auto start = Clock::now();
+			simd.Integrate(kDeltaTime, field, 0.5f);
+			auto mid = Clock::now();
+			scalar.IntegrateScalar(kDeltaTime, field, 0.5f);
+			auto end = Clock::now();
+			simdTime += mid - start;
+			scalarTime += end - mid;
+		}
+
+		// floatのビット列を大小順の整数にして差を取る(+0と-0は同じになる)
+		auto toOrdered = [](float value) {
+			int32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			return bits < 0 ? static_cast<int64_t>(INT32_MIN) - bits : static_cast<int64_t>(bits);
+		};
+		uint64_t maxUlp = 0;
+		auto compare = [&](const std::vector<float>& a, const std::vector<float>& b) {
+			for (uint32_t i = 0; i < particleCount; ++i) {
+				int64_t diff = toOrdered(a[i]) - toOrdered(b[i]);
+				maxUlp = (std::max)(maxUlp, static_cast<uint64_t>(diff < 0 ? -diff : diff));
+			}
+		};
+		compare(simd.translateX, scalar.translateX);
+		compare(simd.translateY, scalar.translateY);
+		compare(simd.translateZ, scalar.translateZ);
+		compare(simd.velocityX, scalar.velocityX);
+		compare(simd.velocityY, scalar.velocityY);
+		compare(simd.velocityZ, scalar.velocityZ);
+		compare(simd.scaleX, scalar.scaleX);
+		compare(simd.scaleY, scalar.scaleY);
+		compare(simd.scaleZ, scalar.scaleZ);
+		compare(simd.currentTime, scalar.currentTime);
+		compare(simd.alpha, scalar.alpha);
+
+		double particleFrames = static_cast<double>(particleCount) * kFrameCount;
+		Log("TestParticleIntegrate: " + std::to_string(particleCount) + " particles, max diff " +
+			std::to_string(maxUlp) + "ulp, SIMD " +
+			std::to_string(std::chrono::duration<double, std::nano>(simdTime).count() / particleFrames) + "ns/particle, scalar " +
+			std::to_string(std::chrono::duration<double, std::nano>(scalarTime).count() / particleFrames) + "ns/particle\n");
+		if (maxUlp > kMaxUlp) {
+			Log("TestParticleIntegrate: FAILED SIMD integrate differs from scalar\n");
+			return false;
+		}
+		return true;
+	}
+
+	bool BenchmarkParticleStore(uint32_t particleCount) {
+		const int kFrameCount = 120;
+		const float kDeltaTime = 1.0f / 60.0f;
+
+		AccelerationField field;
+		field.acceleration = { 0.0f, 15.0f, 0.0f };
+		field.area.min = { -1.0f, -1.0f, -1.0f };
+		field.area.max = { 1.0f, 1.0f, 1.0f };
+
+		// 毎フレーム減った分だけ発生させる
+		std::mt19937 randomEngine(1234);
+		std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> distTime(1.0f, 3.0f);
+		auto makeParticle = [&]() {
+			Particles particle;
+			particle.transform.scale = { 1.0f, 1.0f, 1.0f };
+			particle.transform.rotate = { 0.0f, 0.0f, 0.0f };
+			particle.transform.translate = { 0.0f, 0.0f, 0.0f };
+			particle.velocity = { distribution(randomEngine), distribution(randomEngine), distribution(randomEngine) };
+			particle.color = { 1.0f, 1.0f, 1.0f, 1.0f };
+			particle.lifeTime = distTime(randomEngine);
+			particle.currentTime = 0.0f;
+			return particle;
+		};
+
+		using Clock = std::chrono::steady_clock;
+		auto nanoseconds = [](Clock::duration d) { return std::chrono::duration<double, std::nano>(d).count(); };
+
+		// 以前のstd::list版
+		std::list<Particles> list;
+		uint64_t listUpdated = 0;
+		Clock::duration listEmit{}, listUpdate{};
+		for (int frame = 0; frame < kFrameCount; ++frame) {
+			auto start = Clock::now();
+			std::list<Particles> emitted;
+			while (list.size() + emitted.size() < particleCount) {
+				emitted.push_back(makeParticle());
+			}
+			list.splice(list.end(), emitted);
+			auto mid = Clock::now();
+
+			for (auto it = list.begin(); it != list.end();) {
+				if (it->lifeTime <= it->currentTime) {
+					it = list.erase(it);
+					continue;
+				}
+				Vector3& t = it->transform.translate;
+				if ((field.area.min.x < t.x && field.area.max.x > t.x) &&
+					(field.area.min.y < t.y && field.area.max.y > t.y) &&
+					(field.area.min.z < t.z && field.area.max.z > t.z)) {
+					it->velocity.x += field.acceleration.x * kDeltaTime;
+					it->velocity.y += field.acceleration.y * kDeltaTime;
+					it->velocity.z += field.acceleration.z * kDeltaTime;
+				}
+				t.x += it->velocity.x * kDeltaTime;
+				t.y += it->velocity.y * kDeltaTime;
+				t.z += it->velocity.z * kDeltaTime;
+				if (it->transform.scale.x > 0.0f) {
+					it->transform.scale.x -= 0.5f * kDeltaTime;
+				}
+				if (it->transform.scale.y > 0.0f) {
+					it->transform.scale.y -= 0.5f * kDeltaTime;
+				}
+				if (it->transform.scale.z > 0.0f) {
+					it->transform.scale.z -= 0.5f * kDeltaTime;
+				}
+				it->currentTime += kDeltaTime;
+				listUpdated++;
+				++it;
+			}
+			auto end = Clock::now();
+			listEmit += mid - start;
+			listUpdate += end - mid;
+		}
+
+		// SoA版
+		ParticleStore store;
+		store.Initialize(particleCount);
+		uint64_t storeUpdated = 0;
+		Clock::duration storeEmit{}, storeUpdate{};
+		for (int frame = 0; frame < kFrameCount; ++frame) {
+			auto start = Clock::now();
+			while (!store.IsFull()) {
+				store.Add(makeParticle());
+			}
+			auto mid = Clock::now();
+			store.RemoveDead();
+			store.Integrate(kDeltaTime, field, 0.5f);
+			auto end = Clock::now();
+			storeUpdated += store.GetCount();
+			storeEmit += mid - start;
+			storeUpdate += end - mid;
+		}
+
+		// 更新は1粒あたり、発生は1フレームあたり(乱数込み)
+		Log("BenchmarkParticleStore: " + std::to_string(particleCount) + " particles x " + std::to_string(kFrameCount) + " frames\n" +
+			"  update: list " + std::to_string(nanoseconds(listUpdate) / listUpdated) + "ns/particle, SoA " +
+			std::to_string(nanoseconds(storeUpdate) / storeUpdated) + "ns/particle\n" +
+			"  emit: list " + std::to_string(nanoseconds(listEmit) / kFrameCount / 1000.0) + "us/frame, SoA " +
+			std::to_string(nanoseconds(storeEmit) / kFrameCount / 1000.0) + "us/frame\n");
+		return true;
+	}
+
+	bool BenchmarkParticleBillboard(uint32_t particleCount) {
+		const int kFrameCount = 60;
+
+		Matrix4x4 cameraWorld = MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, { 0.3f, 0.7f, 0.0f }, { 0.0f, 5.0f, -20.0f });
+		Matrix4x4 viewProjection = Multiply(Inverse(cameraWorld), MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 100.0f));
+
+		// 半分はZ回転あり(Plane)、半分は回転なし(Normal)
+		ParticleStore store;
+		store.Initialize(particleCount);
+		std::mt19937 randomEngine(4321);
+		std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+		std::uniform_real_distribution<float> distScale(0.1f, 2.0f);
+		std::uniform_real_distribution<float> distRotate(-std::numbers::pi_v<float>, std::numbers::pi_v<float>);
+		while (!store.IsFull()) {
+			Particles particle;
+			float scale = distScale(randomEngine);
+			particle.transform.scale = { scale, scale, scale };
+			particle.transform.rotate = { 0.0f, 0.0f, (store.GetCount() % 2) ? distRotate(randomEngine) : 0.0f };
+			particle.transform.translate = { distribution(randomEngine), distribution(randomEngine), distribution(randomEngine) };
+			particle.velocity = { 0.0f, 0.0f, 0.0f };
+			particle.color = { 1.0f, 1.0f, 1.0f, 1.0f };
+			particle.lifeTime = 1.0f;
+			particle.currentTime = 0.0f;
+			store.Add(particle);
+		}
+		AccelerationField field{};
+		store.Integrate(0.0f, field, 0.0f);
+
+		std::vector<ParticleForGPU> fast(particleCount);
+		std::vector<ParticleForGPU> reference(particleCount);
+
+		using Clock = std::chrono::steady_clock;
+		Clock::duration fastTime{}, referenceTime{};
+		for (int frame = 0; frame < kFrameCount; ++frame) {
+			auto start = Clock::now();
+			for (uint32_t i = 0; i < particleCount; ++i) {
+				WriteBillboardReference(store, i, cameraWorld, viewProjection, reference[i]);
+			}
+			auto mid = Clock::now();
+			ParticleBillboard billboard;
+			billboard.Begin(cameraWorld, viewProjection);
+			for (uint32_t i = 0; i < particleCount; ++i) {
+				billboard.Write(store, i, fast[i]);
+			}
+			auto end = Clock::now();
+			referenceTime += mid - start;
+			fastTime += end - mid;
+		}
+
+		// 行列の要素ごとの差(掛ける順番が違うので完全には一致しない)
+		float maxDiff = 0.0f;
+		for (uint32_t i = 0; i < particleCount; ++i) {
+			for (int row = 0; row < 4; ++row) {
+				for (int column = 0; column < 4; ++column) {
+					maxDiff = (std::max)(maxDiff, std::abs(fast[i].World.m[row][column] - reference[i].World.m[row][column]));
+					maxDiff = (std::max)(maxDiff, std::abs(fast[i].WVP.m[row][column] - reference[i].WVP.m[row][column]));
+				}
+			}
+		}
+
+		double particleFrames = static_cast<double>(particleCount) * kFrameCount;
+		Log("BenchmarkParticleBillboard: " + std::to_string(particleCount) + " particles, max diff " +
+			std::to_string(maxDiff) + ", basis " +
+			std::to_string(std::chrono::duration<double, std::nano>(fastTime).count() / particleFrames) + "ns/particle, matrices " +
+			std::to_string(std::chrono::duration<double, std::nano>(referenceTime).count() / particleFrames) + "ns/particle\n");
+		return true;
+	}
+
+	bool BenchmarkParticleEmitters() {
+		const int kFrameCount = 60;
+		const float kDeltaTime = 1.0f / 60.0f;
+		// パーティクルに使ってよい1フレームの時間(16.6msの1/4)
+		const double kBudgetMs = 1000.0 / 60.0 / 4.0;
+		// エミッター1つが常に持っている数
+		const uint32_t kParticlesPerEmitter = 64;
+		// ゲーム中と同じくらいのテクスチャ数に振り分ける
+		const uint32_t kTextureCount = 4;
+		const uint32_t kNumInstance = ParticleManager::kNumInstance;
+
+		Matrix4x4 cameraWorld = MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, { 0.3f, 0.7f, 0.0f }, { 0.0f, 5.0f, -20.0f });
+		Matrix4x4 viewProjection = Multiply(Inverse(cameraWorld), MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 100.0f));
+
+		AccelerationField field;
+		field.acceleration = { 0.0f, 15.0f, 0.0f };
+		field.area.min = { -1.0f, -1.0f, -1.0f };
+		field.area.max = { 1.0f, 1.0f, 1.0f };
+
+		Emitter emitter{};
+		emitter.transform.scale = { 1.0f, 1.0f, 1.0f };
+		emitter.count = kParticlesPerEmitter;
+
+		FastRandom random(2468);
+		// GPUの共有バッファの代わり
+		std::vector<ParticleForGPU> instances(static_cast<size_t>(kNumInstance) * kTextureCount);
+
+		std::string result = "BenchmarkParticleEmitters: " + std::to_string(kParticlesPerEmitter) + " particles per emitter, " +
+			std::to_string(kTextureCount) + " textures\n";
+		uint32_t sustainable = 0;
+		for (uint32_t emitterCount = 16; emitterCount <= 8192; emitterCount *= 2) {
+			std::vector<ParticleStore> stores(emitterCount);
+			for (ParticleStore& store : stores) {
+				store.Initialize(kParticlesPerEmitter);
+			}
+
+			using Clock = std::chrono::steady_clock;
+			Clock::duration total{};
+			uint64_t drawn = 0;
+			uint64_t dropped = 0;
+			for (int frame = 0; frame < kFrameCount; ++frame) {
+				auto start = Clock::now();
+				ParticleBillboard billboard;
+				billboard.Begin(cameraWorld, viewProjection);
+				uint32_t numInstance[kTextureCount] = {};
+				for (uint32_t e = 0; e < emitterCount; ++e) {
+					// 減った分を足して、動かして、テクスチャごとのバッファに詰める
+					ParticleStore& store = stores[e];
+					ParticleEmitter::GetInstance()->MakeEmit(emitter, ParticleType::Normal, store, random);
+					store.RemoveDead();
+					store.Integrate(kDeltaTime, field, 0.5f);
+
+					uint32_t group = e % kTextureCount;
+					uint32_t count = (std::min)(store.GetCount(), kNumInstance - numInstance[group]);
+					ParticleForGPU* out = instances.data() + static_cast<size_t>(group) * kNumInstance + numInstance[group];
+					for (uint32_t i = 0; i < count; ++i) {
+						billboard.Write(store, i, out[i]);
+					}
+					numInstance[group] += count;
+					drawn += count;
+					dropped += store.GetCount() - count;
+				}
+				total += Clock::now() - start;
+			}
+
+			double ms = std::chrono::duration<double, std::milli>(total).count() / kFrameCount;
+			result += "  " + std::to_string(emitterCount) + " emitters: " + std::to_string(ms) + "ms/frame, drawn " +
+				std::to_string(drawn / kFrameCount) + ", dropped " + std::to_string(dropped / kFrameCount) + "\n";
+			// 時間内に収まり、全部描けたものだけ
+			if (ms <= kBudgetMs && dropped == 0) {
+				sustainable = emitterCount;
+			}
+		}
+
+		result += "  sustainable at 60FPS (" + std::to_string(kBudgetMs) + "ms budget): " + std::to_string(sustainable) + " emitters, " +
+			std::to_string(sustainable * kParticlesPerEmitter) + " particles\n";
+		Log(result);
+		return true;
+	}
+}
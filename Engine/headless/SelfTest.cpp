@@ -0,0 +1,43 @@
+#include "SelfTest.h"
+#include "Logger.h"
+#include <cstdio>
+
+namespace SelfTest {
+	void Log(const std::string& message) {
+		std::printf("%s", message.c_str());
+		std::fflush(stdout);
+		Logger::log(message);
+	}
+
+	bool RunTests() {
+		// 失敗しても残りは続ける
+		int failedCount = 0;
+		failedCount += TestGameTimer() ? 0 : 1;
+		failedCount += TestFramePacer() ? 0 : 1;
+		failedCount += TestWaveParser() ? 0 : 1;
+		failedCount += TestInputRecorder() ? 0 : 1;
+		failedCount += TestParticleIntegrate(100000) ? 0 : 1;
+		failedCount += TestDrawAllocations(600) ? 0 : 1;
+
+		Log("SelfTest::RunTests: " + std::to_string(failedCount) + " failed\n");
+		return failedCount == 0;
+	}
+
+	bool RunBenchmarks() {
+		int failedCount = 0;
+		for (int stageNumber = 0; stageNumber <= 6; ++stageNumber) {
+			failedCount += BenchmarkStageCollision(stageNumber) ? 0 : 1;
+		}
+		failedCount += BenchmarkObjLoader("resource") ? 0 : 1;
+		failedCount += BenchmarkParticleStore(100000) ? 0 : 1;
+		failedCount += BenchmarkParticleBillboard(100000) ? 0 : 1;
+		failedCount += BenchmarkParticleEmitters() ? 0 : 1;
+		failedCount += BenchmarkWaveParser("sound") ? 0 : 1;
+		failedCount += BenchmarkMusicStream("sound") ? 0 : 1;
+		failedCount += BenchmarkSoundMixer() ? 0 : 1;
+		failedCount += BenchmarkTraceScope() ? 0 : 1;
+
+		Log("SelfTest::RunBenchmarks: " + std::to_string(failedCount) + " failed\n");
+		return failedCount == 0;
+	}
+}
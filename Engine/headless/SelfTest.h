@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Headlessプロジェクトから動かすテストと計測(ゲーム本体には入れない)
+// Test*は結果が決まっていて、失敗したものをログに出してfalseを返す
+// Benchmark*は速さをログに出す。新旧の結果が食い違ったときだけfalseを返す
+// resource/とsound/を読むものがあるので、リポジトリ直下で実行する
+namespace SelfTest {
+	// 標準出力とLoggerの両方に出す
+	void Log(const std::string& message);
+
+	// 全部のテストを動かす(1つでも失敗したらfalse)
+	bool RunTests();
+	// 全部の計測を動かす
+	bool RunBenchmarks();
+
+	// TimingTests.cpp
+	bool TestGameTimer();
+	bool TestFramePacer();
+	bool BenchmarkTraceScope();
+
+	// AudioTests.cpp
+	bool TestWaveParser();
+	bool BenchmarkWaveParser(const std::string& directoryPath);
+	bool BenchmarkMusicStream(const std::string& directoryPath);
+	bool BenchmarkSoundMixer();
+
+	// InputTests.cpp
+	bool TestInputRecorder();
+
+	// ParticleTests.cpp
+	bool TestParticleIntegrate(uint32_t particleCount);
+	bool BenchmarkParticleStore(uint32_t particleCount);
+	bool BenchmarkParticleBillboard(uint32_t particleCount);
+	bool BenchmarkParticleEmitters();
+
+	// ModelTests.cpp
+	bool BenchmarkObjLoader(const std::string& directoryPath);
+	bool TestDrawAllocations(uint32_t tickCount);
+
+	// CollisionTests.cpp
+	bool BenchmarkStageCollision(int stageNumber);
+}
@@ -0,0 +1,201 @@
+// GameTimer・FramePacer・TraceRecorderのテストと計測
+#include "SelfTest.h"
+#include "GameTimer.h"
+#include "FramePacer.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace {
+	// 寝るとoversleep(0〜maxOversleep)だけ余計に進み、時刻を見るたびにnowCostだけ進む偽の時計
+	class MockClock : public FramePacer::Clock {
+	public:
+		MockClock(int64_t maxOversleep, int64_t nowCost) : maxOversleep_(maxOversleep), nowCost_(nowCost) {}
+
+		int64_t Now() override {
+			time_ += nowCost_;
+			return time_;
+		}
+		void Sleep(int64_t nanoseconds) override {
+			time_ += nanoseconds + (maxOversleep_ > 0 ? static_cast<int64_t>(Next() % static_cast<uint64_t>(maxOversleep_)) : 0);
+			sleepCount_++;
+		}
+		// フレームの処理にかかった時間
+		void Work(int64_t nanoseconds) { time_ += nanoseconds; }
+		uint64_t Next() {
+			state_ = state_ * 6364136223846793005ull + 1442695040888963407ull;
+			return state_ >> 33;
+		}
+		uint32_t GetSleepCount() const { return sleepCount_; }
+
+	private:
+		int64_t time_ = 0;
+		int64_t maxOversleep_;
+		int64_t nowCost_;
+		uint64_t state_ = 1;
+		uint32_t sleepCount_ = 0;
+	};
+
+	// 処理時間work±jitterのフレームをframeCount回流す
+	FramePacer::PacingStats RunFrames(FramePacer& pacer, MockClock& clock, int frameCount, int64_t work, int64_t jitter) {
+		pacer.Wait();
+		for (int i = 0; i < frameCount; ++i) {
+			int64_t offset = jitter > 0 ? static_cast<int64_t>(clock.Next() % static_cast<uint64_t>(jitter * 2)) - jitter : 0;
+			clock.Work(work + offset);
+			pacer.Wait();
+		}
+		return pacer.GetStats();
+	}
+
+	// フレーム時間の列を新しいGameTimerに流して、進んだtick数を返す
+	uint64_t RunTimer(int frameCount, double frameSeconds, double jitterSeconds, uint32_t& maxTicks, float& maxAlpha, double& droppedTime) {
+		GameTimer* timer = GameTimer::GetInstance();
+		maxTicks = 0;
+		maxAlpha = 0.0f;
+		for (int i = 0; i < frameCount; ++i) {
+			timer->Advance(frameSeconds + ((i & 1) ? jitterSeconds : -jitterSeconds));
+			while (timer->Step()) {
+			}
+			maxTicks = (std::max)(maxTicks, timer->GetFrameTickCount());
+			maxAlpha = (std::max)(maxAlpha, timer->GetAlpha());
+		}
+		uint64_t ticks = timer->GetTickCount();
+		droppedTime = timer->GetDroppedTime();
+		timer->Finalize();
+		return ticks;
+	}
+}
+
+namespace SelfTest {
+	bool TestGameTimer() {
+		int failedCount = 0;
+		auto check = [&failedCount](bool condition, const std::string& name) {
+			if (!condition) {
+				Log("TestGameTimer: FAILED " + name + "\n");
+				failedCount++;
+			}
+		};
+
+		uint32_t maxTicks = 0;
+		float maxAlpha = 0.0f;
+		double droppedTime = 0.0;
+		{
+			// 60Hz描画(±0.1msの揺れ)は毎フレーム1tick
+			uint64_t ticks = RunTimer(600, 1.0 / 60.0, 0.0001, maxTicks, maxAlpha, droppedTime);
+			check(ticks == 600 && maxTicks == 1, "60Hz frames advance one tick each (" + std::to_string(ticks) + ")");
+		}
+		{
+			// 144Hz描画でも1秒で60tick
+			uint64_t ticks = RunTimer(144 * 10, 1.0 / 144.0, 0.0, maxTicks, maxAlpha, droppedTime);
+			check(ticks >= 599 && ticks <= 600 && maxTicks == 1, "144Hz frames advance 60 ticks per second (" + std::to_string(ticks) + ")");
+			check(maxAlpha > 0.0f && maxAlpha < 1.0f, "alpha stays below 1 (" + std::to_string(maxAlpha) + ")");
+		}
+		{
+			// 30Hz描画は毎フレーム2tick
+			uint64_t ticks = RunTimer(300, 1.0 / 30.0, 0.0001, maxTicks, maxAlpha, droppedTime);
+			check(ticks == 600 && maxTicks == 2, "30Hz frames advance two ticks each (" + std::to_string(ticks) + ")");
+		}
+		{
+			// 1秒止まっても進めるのはkMaxTicksPerFrameまで
+			uint64_t ticks = RunTimer(1, 1.0, 0.0, maxTicks, maxAlpha, droppedTime);
+			check(ticks == GameTimer::kMaxTicksPerFrame, "a long hitch is clamped to kMaxTicksPerFrame");
+			check(std::abs(droppedTime - (1.0 - GameTimer::kMaxTicksPerFrame * GameTimer::kStep)) < 1e-9, "the clamped time is reported as dropped");
+		}
+
+		Log("TestGameTimer: " + std::to_string(failedCount) + " failed\n");
+		return failedCount == 0;
+	}
+
+	bool TestFramePacer() {
+		int failedCount = 0;
+		auto check = [&failedCount](bool condition, const std::string& name) {
+			if (!condition) {
+				Log("TestFramePacer: FAILED " + name + "\n");
+				failedCount++;
+			}
+		};
+		const int64_t kMillisecond = 1000000;
+
+		{
+			// 60FPS、処理5ms±2ms、寝すぎは最大0.25ms(spinMarginの中に収まる)
+			MockClock clock(250000, 50);
+			FramePacer pacer(&clock);
+			FramePacer::PacingStats stats = RunFrames(pacer, clock, FramePacer::kIntervalCount, 5 * kMillisecond, 2 * kMillisecond);
+			check(std::abs(stats.mean - 1000.0f / 60.0f) < 0.001f, "60FPS mean interval (" + std::to_string(stats.mean) + "ms)");
+			check(stats.standardDeviation < 0.001f, "60FPS interval deviation (" + std::to_string(stats.standardDeviation) + "ms)");
+			check(stats.missedCount == 0 && stats.lateWakeCount == 0, "60FPS never misses");
+			check(clock.GetSleepCount() == FramePacer::kIntervalCount, "sleeps once per frame");
+			check(stats.spin <= FramePacer::kDefaultSpinMargin / 1000000.0f, "spins no longer than the margin (" + std::to_string(stats.spin) + "ms)");
+		}
+		{
+			// 144FPS
+			MockClock clock(250000, 50);
+			FramePacer pacer(&clock);
+			pacer.SetTargetRate(144.0f);
+			FramePacer::PacingStats stats = RunFrames(pacer, clock, FramePacer::kIntervalCount, 2 * kMillisecond, kMillisecond);
+			check(std::abs(stats.mean - 1000.0f / 144.0f) < 0.001f, "144FPS mean interval (" + std::to_string(stats.mean) + "ms)");
+		}
+		{
+			// 処理が20msかかるなら待たずに20ms間隔
+			MockClock clock(250000, 50);
+			FramePacer pacer(&clock);
+			FramePacer::PacingStats stats = RunFrames(pacer, clock, 60, 20 * kMillisecond, 0);
+			check(stats.missedCount == 60 && clock.GetSleepCount() == 0, "frames over budget do not wait");
+			check(std::abs(stats.mean - 20.0f) < 0.001f, "frames over budget keep their own interval (" + std::to_string(stats.mean) + "ms)");
+		}
+		{
+			// 寝すぎがspinMarginより長い(2ms)と遅れて起きたことが分かる
+			MockClock clock(2 * kMillisecond, 50);
+			FramePacer pacer(&clock);
+			FramePacer::PacingStats stats = RunFrames(pacer, clock, FramePacer::kIntervalCount, 5 * kMillisecond, 0);
+			check(stats.lateWakeCount > 0, "oversleep beyond the margin is counted");
+			check(stats.standardDeviation > 0.01f, "oversleep shows up as deviation");
+		}
+		{
+			// 0なら待たない
+			MockClock clock(0, 50);
+			FramePacer pacer(&clock);
+			pacer.SetTargetRate(0.0f);
+			FramePacer::PacingStats stats = RunFrames(pacer, clock, 60, kMillisecond, 0);
+			check(clock.GetSleepCount() == 0 && stats.missedCount == 0 && std::abs(stats.mean - 1.0f) < 0.001f, "unlimited rate does not wait");
+		}
+
+		Log("TestFramePacer: " + std::to_string(failedCount) + " failed\n");
+		return failedCount == 0;
+	}
+
+	bool BenchmarkTraceScope() {
+		const int kScopeCount = 1000000;
+		double enabledNanoseconds = 0.0;
+		double disabledNanoseconds = 0.0;
+		const bool wasEnabled = TraceRecorder::IsEnabled();
+
+		std::thread worker([&]() {
+			TraceRecorder::GetInstance()->SetThreadName("BenchmarkTraceScope");
+
+			TraceRecorder::SetEnabled(true);
+			int64_t start = TraceRecorder::Now();
+			for (int i = 0; i < kScopeCount; ++i) {
+				TRACE_SCOPE("BenchmarkTraceScope");
+			}
+			enabledNanoseconds = static_cast<double>(TraceRecorder::Now() - start) / kScopeCount;
+
+			TraceRecorder::SetEnabled(false);
+			start = TraceRecorder::Now();
+			for (int i = 0; i < kScopeCount; ++i) {
+				TRACE_SCOPE("BenchmarkTraceScope");
+			}
+			disabledNanoseconds = static_cast<double>(TraceRecorder::Now() - start) / kScopeCount;
+		});
+		worker.join();
+		TraceRecorder::SetEnabled(wasEnabled);
+
+		// 60FPSの1フレーム(16.6ms)の1%に収まる区間数
+		const double kOnePercentOfFrameNanoseconds = 166667.0;
+		Log("BenchmarkTraceScope: enabled " + std::to_string(enabledNanoseconds) + "ns/scope, disabled " +
+			std::to_string(disabledNanoseconds) + "ns/scope, " + std::to_string(static_cast<int>(kOnePercentOfFrameNanoseconds / enabledNanoseconds)) +
+			" scopes per frame fit in 1% at 60FPS\n");
+		return true;
+	}
+}
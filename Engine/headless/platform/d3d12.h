@@ -0,0 +1,64 @@
+#pragma once
+#include "wincompat.h"
+
+// 描画クラスのヘッダーが宣言できるだけの型(中身は使わない)
+struct ID3D12Device;
+struct ID3D12GraphicsCommandList;
+struct ID3D12Resource;
+struct ID3D12DescriptorHeap;
+struct ID3D12Fence;
+struct ID3D12CommandQueue;
+struct ID3D12CommandAllocator;
+struct ID3D12RootSignature;
+struct ID3D12PipelineState;
+struct ID3D12Debug1;
+struct ID3D12InfoQueue;
+struct ID3D10Blob;
+typedef ID3D10Blob ID3DBlob;
+
+enum DXGI_FORMAT {
+	DXGI_FORMAT_UNKNOWN,
+};
+enum D3D12_DESCRIPTOR_HEAP_TYPE {
+	D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV,
+};
+
+struct D3D12_GPU_DESCRIPTOR_HANDLE {
+	UINT64 ptr;
+};
+struct D3D12_CPU_DESCRIPTOR_HANDLE {
+	size_t ptr;
+};
+struct D3D12_VERTEX_BUFFER_VIEW {
+	UINT64 BufferLocation;
+	UINT SizeInBytes;
+	UINT StrideInBytes;
+};
+struct D3D12_INDEX_BUFFER_VIEW {
+	UINT64 BufferLocation;
+	UINT SizeInBytes;
+	DXGI_FORMAT Format;
+};
+typedef RECT D3D12_RECT;
+
+struct D3D12_RESOURCE_BARRIER {};
+struct D3D12_RESOURCE_DESC {};
+struct D3D12_HEAP_PROPERTIES {};
+struct D3D12_CLEAR_VALUE {};
+struct D3D12_RANGE {};
+struct D3D12_SUBRESOURCE_DATA {};
+struct D3D12_DESCRIPTOR_HEAP_DESC {};
+struct D3D12_DESCRIPTOR_RANGE {};
+struct D3D12_ROOT_PARAMETER {};
+struct D3D12_ROOT_SIGNATURE_DESC {};
+struct D3D12_STATIC_SAMPLER_DESC {};
+struct D3D12_INPUT_ELEMENT_DESC {};
+struct D3D12_INPUT_LAYOUT_DESC {};
+struct D3D12_BLEND_DESC {};
+struct D3D12_RASTERIZER_DESC {};
+struct D3D12_DEPTH_STENCIL_DESC {};
+struct D3D12_GRAPHICS_PIPELINE_STATE_DESC {};
+struct D3D12_VIEWPORT {};
+struct D3D12_RENDER_TARGET_VIEW_DESC {};
+struct D3D12_SHADER_RESOURCE_VIEW_DESC {};
+struct D3D12_DEPTH_STENCIL_VIEW_DESC {};
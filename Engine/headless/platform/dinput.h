@@ -0,0 +1,7 @@
+#pragma once
+#include "wincompat.h"
+
+#define DIRECTINPUT_VERSION 0x0800
+
+struct IDirectInput8;
+struct IDirectInputDevice8;
@@ -0,0 +1,6 @@
+#pragma once
+
+struct IDxcBlob;
+struct IDxcUtils;
+struct IDxcCompiler3;
+struct IDxcIncludeHandler;
@@ -0,0 +1,9 @@
+#pragma once
+#include "wincompat.h"
+
+struct IDXGIFactory7;
+struct IDXGIAdapter4;
+struct IDXGISwapChain4;
+struct DXGI_SWAP_CHAIN_DESC1 {
+	UINT BufferCount;
+};
@@ -0,0 +1,6 @@
+#pragma once
+
+namespace DirectX {
+struct TexMetadata {};
+class ScratchImage {};
+}
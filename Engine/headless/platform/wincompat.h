@@ -0,0 +1,128 @@
+#pragma once
+// Windows以外でヘッドレスをビルドするための代用ヘッダー(CMakeLists.txtがWIN32以外のときだけインクルードパスに足す)
+// シミュレーションで触る型と定数だけを置く。中身のある関数は「何もしない」「繋がっていない」を返す
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+typedef unsigned long DWORD;
+typedef unsigned short WORD;
+typedef unsigned char BYTE;
+typedef short SHORT;
+typedef int BOOL;
+typedef unsigned int UINT;
+typedef long LONG;
+typedef float FLOAT;
+typedef uint32_t UINT32;
+typedef uint64_t UINT64;
+typedef long HRESULT;
+typedef intptr_t LRESULT;
+typedef uintptr_t WPARAM;
+typedef intptr_t LPARAM;
+typedef void* HWND;
+typedef void* HINSTANCE;
+typedef void* HANDLE;
+
+#define CALLBACK
+#define WINAPI
+#define SUCCEEDED(hr) ((hr) >= 0)
+#define FAILED(hr) ((hr) < 0)
+#define _countof(array) (sizeof(array) / sizeof((array)[0]))
+
+struct WNDCLASS {
+	HINSTANCE hInstance;
+};
+struct RECT {
+	LONG left, top, right, bottom;
+};
+
+inline void OutputDebugStringA(const char* text) {
+	std::fputs(text, stderr);
+}
+
+inline int sprintf_s(char* buffer, size_t size, const char* format, ...) {
+	va_list args;
+	va_start(args, format);
+	int result = std::vsnprintf(buffer, size, format, args);
+	va_end(args);
+	return result;
+}
+template<size_t N>
+int sprintf_s(char (&buffer)[N], const char* format, ...) {
+	va_list args;
+	va_start(args, format);
+	int result = std::vsnprintf(buffer, N, format, args);
+	va_end(args);
+	return result;
+}
+
+// XInput(コントローラーは常に繋がっていない)
+struct XINPUT_GAMEPAD {
+	WORD wButtons;
+	BYTE bLeftTrigger;
+	BYTE bRightTrigger;
+	SHORT sThumbLX, sThumbLY, sThumbRX, sThumbRY;
+};
+struct XINPUT_STATE {
+	DWORD dwPacketNumber;
+	XINPUT_GAMEPAD Gamepad;
+};
+struct XINPUT_VIBRATION {
+	WORD wLeftMotorSpeed, wRightMotorSpeed;
+};
+
+#define XINPUT_GAMEPAD_DPAD_UP        0x0001
+#define XINPUT_GAMEPAD_DPAD_DOWN      0x0002
+#define XINPUT_GAMEPAD_DPAD_LEFT      0x0004
+#define XINPUT_GAMEPAD_DPAD_RIGHT     0x0008
+#define XINPUT_GAMEPAD_START          0x0010
+#define XINPUT_GAMEPAD_BACK           0x0020
+#define XINPUT_GAMEPAD_LEFT_THUMB     0x0040
+#define XINPUT_GAMEPAD_RIGHT_THUMB    0x0080
+#define XINPUT_GAMEPAD_LEFT_SHOULDER  0x0100
+#define XINPUT_GAMEPAD_RIGHT_SHOULDER 0x0200
+#define XINPUT_GAMEPAD_A              0x1000
+#define XINPUT_GAMEPAD_B              0x2000
+#define XINPUT_GAMEPAD_X              0x4000
+#define XINPUT_GAMEPAD_Y              0x8000
+#define XINPUT_GAMEPAD_LEFT_THUMB_DEADZONE 7849
+
+#define ERROR_SUCCESS              0L
+#define ERROR_DEVICE_NOT_CONNECTED 1167L
+
+inline DWORD XInputGetState(DWORD, XINPUT_STATE*) { return ERROR_DEVICE_NOT_CONNECTED; }
+inline DWORD XInputSetState(DWORD, XINPUT_VIBRATION*) { return ERROR_DEVICE_NOT_CONNECTED; }
+
+// DirectInputのキーコード(dinput.hと同じ値)
+#define DIK_ESCAPE 0x01
+#define DIK_1      0x02
+#define DIK_2      0x03
+#define DIK_3      0x04
+#define DIK_4      0x05
+#define DIK_5      0x06
+#define DIK_TAB    0x0F
+#define DIK_Q      0x10
+#define DIK_W      0x11
+#define DIK_E      0x12
+#define DIK_R      0x13
+#define DIK_T      0x14
+#define DIK_P      0x19
+#define DIK_RETURN 0x1C
+#define DIK_A      0x1E
+#define DIK_S      0x1F
+#define DIK_D      0x20
+#define DIK_F      0x21
+#define DIK_J      0x24
+#define DIK_K      0x25
+#define DIK_L      0x26
+#define DIK_LSHIFT 0x2A
+#define DIK_Z      0x2C
+#define DIK_X      0x2D
+#define DIK_C      0x2E
+#define DIK_SPACE  0x39
+#define DIK_F2     0x3C
+#define DIK_UP     0xC8
+#define DIK_LEFT   0xCB
+#define DIK_RIGHT  0xCD
+#define DIK_DOWN   0xD0
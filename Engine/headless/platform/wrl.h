@@ -0,0 +1,25 @@
+#pragma once
+#include "wincompat.h"
+
+// ポインタを持つだけ(ヘッドレスではCOMオブジェクトを作らない)
+namespace Microsoft {
+namespace WRL {
+template<class T>
+class ComPtr {
+public:
+	ComPtr() = default;
+	ComPtr(std::nullptr_t) {}
+	ComPtr& operator=(std::nullptr_t) { ptr_ = nullptr; return *this; }
+
+	T* Get() const { return ptr_; }
+	T* operator->() const { return ptr_; }
+	T** GetAddressOf() { return &ptr_; }
+	T** ReleaseAndGetAddressOf() { ptr_ = nullptr; return &ptr_; }
+	void Reset() { ptr_ = nullptr; }
+	explicit operator bool() const { return ptr_ != nullptr; }
+
+private:
+	T* ptr_ = nullptr;
+};
+}
+}
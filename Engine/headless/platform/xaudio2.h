@@ -0,0 +1,18 @@
+#pragma once
+#include "wincompat.h"
+
+struct IXAudio2;
+struct IXAudio2SourceVoice;
+struct IXAudio2MasteringVoice;
+struct IXAudio2VoiceCallback {};
+struct XAUDIO2_BUFFER {};
+
+struct WAVEFORMATEX {
+	WORD wFormatTag;
+	WORD nChannels;
+	DWORD nSamplesPerSec;
+	DWORD nAvgBytesPerSec;
+	WORD nBlockAlign;
+	WORD wBitsPerSample;
+	WORD cbSize;
+};
@@ -18,6 +18,8 @@ Input* Input::GetInstance() {
 }
 
 void Input::Finalize() {
+	StopRecording(0);
+	StopReplay();
 	delete instance;
 	instance = nullptr;
 }
@@ -52,6 +54,12 @@ void Input::Update() {
 	result = keyboard->Acquire();
 
 	result = keyboard->GetDeviceState(sizeof(key), key);
+
+	// パッド0番はtickの頭で1回だけ読む(繋がっていないパッドのXInputGetStateは遅い)
+	ZeroMemory(&padState_, sizeof(XINPUT_STATE));
+	isPadConnected_ = XInputGetState(0, &padState_) == ERROR_SUCCESS;
+
+	ApplyRecording();
 }
 
 bool Input::PushKey(BYTE keyNumber) {
@@ -77,6 +85,11 @@ bool Input::GetJoystickState(uint32_t num, XINPUT_STATE& state) {
 	
 	prevState = state;
 
+	if (num == 0) {
+		state = padState_;
+		return isPadConnected_;
+	}
+
 	ZeroMemory(&state, sizeof(XINPUT_STATE));
 	
 	// Simply get the state of the controller from XInput.
@@ -102,6 +115,13 @@ bool Input::GetJoystickStatePrevious(uint32_t num, XINPUT_STATE& state) {
 	
 	ZeroMemory(&state, sizeof(XINPUT_STATE));
 
+	if (num == 0) {
+		if (isPadConnected_) {
+			state = prevState;
+		}
+		return isPadConnected_;
+	}
+
 	// Simply get the state of the controller from XInput.
 	dwResult = XInputGetState(num, &state);
 
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <windows.h>
+#include <Windows.h>
 #include <wrl.h>
 
 #define DIRECTINPUT_VERSION 0x0800
@@ -8,6 +8,9 @@
 #include <Xinput.h>
 
 #include "WinApp.h"
+#include "InputRecording.h"
+#include <string>
+
 class Input{
 public:
 	static Input* GetInstance();
@@ -36,6 +39,19 @@ public:
 	//前のシーンのボタン情報の取得
 	void SetStates(XINPUT_STATE state, XINPUT_STATE preState);
 
+	// 入力の記録(Updateのたびに1tick分を書く)。stateHashは再生したときに比べる値
+	bool StartRecording(const std::string& filePath, uint64_t seed, uint32_t stage);
+	void StopRecording(uint64_t stateHash);
+	bool IsRecording() const { return recorder_ != nullptr; }
+
+	// 記録した入力の再生(Updateのたびに1tick分を読んで、実際の入力の代わりにする)
+	bool StartReplay(const std::string& filePath);
+	void StopReplay();
+	bool IsReplaying() const { return playback_ != nullptr; }
+	// 最後のtickまで読んだか
+	bool IsReplayFinished() const;
+	const InputRecordHeader& GetReplayHeader() const;
+
 private:
 	ComPtr<IDirectInputDevice8> keyboard;
 	ComPtr<IDirectInput8> directInput;
@@ -54,6 +70,16 @@ private:
 	
 	XINPUT_STATE prevState = {};
 
+	// パッド0番はUpdateで1回だけ読む(記録と再生はこの値を使う)
+	XINPUT_STATE padState_ = {};
+	bool isPadConnected_ = false;
+
+	// Updateの最後で呼ぶ。記録中なら書き、再生中なら読んだ入力で上書きする
+	void ApplyRecording();
+	void ResetRecordingState();
+	InputRecorder* recorder_ = nullptr;
+	InputPlayback* playback_ = nullptr;
+
 	XINPUT_STATE copyState_ = {};
 	XINPUT_STATE copyPreState_ = {};
 };
\ No newline at end of file
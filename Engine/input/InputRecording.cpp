@@ -0,0 +1,226 @@
+#include "InputRecording.h"
+#include "Input.h"
+#include <cstring>
+
+static_assert(sizeof(InputPadState) == 12, "パッドの状態はそのままファイルに書き出す");
+static_assert(sizeof(InputRecordHeader) == 32, "ヘッダーのサイズが変わると記録が読めなくなる");
+
+namespace {
+	// 1tickの先頭の1バイト
+	const uint8_t kKeysChanged = 1 << 0;  // 続けてkeysを32バイト
+	const uint8_t kPadChanged = 1 << 1;   // 続けてpadを12バイト
+	const uint8_t kPadConnected = 1 << 2;
+}
+
+void InputFrame::SetKey(uint32_t keyNumber, bool isDown) {
+	const uint8_t bit = static_cast<uint8_t>(1 << (keyNumber & 7));
+	if (isDown) {
+		keys[keyNumber >> 3] |= bit;
+	} else {
+		keys[keyNumber >> 3] &= ~bit;
+	}
+}
+
+bool InputRecorder::Open(const std::string& filePath, uint64_t seed, uint32_t stage) {
+	file_.open(filePath, std::ios::binary | std::ios::trunc);
+	if (!file_.is_open()) {
+		return false;
+	}
+
+	header_ = {};
+	header_.magic = kMagic;
+	header_.version = kVersion;
+	header_.seed = seed;
+	header_.stage = stage;
+	// フレーム数とハッシュはCloseで書き直す
+	file_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+
+	previous_ = {};
+	return true;
+}
+
+void InputRecorder::Write(const InputFrame& frame) {
+	if (!file_.is_open()) {
+		return;
+	}
+
+	const bool isKeysChanged = std::memcmp(frame.keys, previous_.keys, sizeof(frame.keys)) != 0;
+	const bool isPadChanged = std::memcmp(&frame.pad, &previous_.pad, sizeof(frame.pad)) != 0;
+	uint8_t flags = 0;
+	flags |= isKeysChanged ? kKeysChanged : 0;
+	flags |= isPadChanged ? kPadChanged : 0;
+	flags |= frame.isPadConnected ? kPadConnected : 0;
+
+	file_.put(static_cast<char>(flags));
+	if (isKeysChanged) {
+		file_.write(reinterpret_cast<const char*>(frame.keys), sizeof(frame.keys));
+	}
+	if (isPadChanged) {
+		file_.write(reinterpret_cast<const char*>(&frame.pad), sizeof(frame.pad));
+	}
+
+	previous_ = frame;
+	header_.frameCount++;
+}
+
+void InputRecorder::Close(uint64_t stateHash) {
+	if (!file_.is_open()) {
+		return;
+	}
+
+	header_.stateHash = stateHash;
+	file_.seekp(0);
+	file_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+	file_.close();
+}
+
+bool InputPlayback::Open(const std::string& filePath) {
+	std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+	if (!file.is_open()) {
+		return false;
+	}
+	const std::streamsize size = file.tellg();
+	if (size < static_cast<std::streamsize>(sizeof(InputRecordHeader))) {
+		return false;
+	}
+	data_.resize(static_cast<size_t>(size));
+	file.seekg(0);
+	file.read(reinterpret_cast<char*>(data_.data()), size);
+
+	std::memcpy(&header_, data_.data(), sizeof(header_));
+	if (header_.magic != InputRecorder::kMagic || header_.version != InputRecorder::kVersion) {
+		return false;
+	}
+
+	// 途中で切れていないか、最後まで一度読んで確かめる
+	offset_ = sizeof(header_);
+	readCount_ = 0;
+	previous_ = {};
+	InputFrame frame;
+	while (Read(frame)) {
+	}
+	if (readCount_ != header_.frameCount || offset_ != data_.size()) {
+		return false;
+	}
+
+	offset_ = sizeof(header_);
+	readCount_ = 0;
+	previous_ = {};
+	return true;
+}
+
+bool InputPlayback::Read(InputFrame& frame) {
+	if (IsFinished() || offset_ >= data_.size()) {
+		return false;
+	}
+
+	const uint8_t flags = data_[offset_];
+	size_t size = 1;
+	size += (flags & kKeysChanged) ? sizeof(frame.keys) : 0;
+	size += (flags & kPadChanged) ? sizeof(frame.pad) : 0;
+	if (offset_ + size > data_.size()) {
+		return false;
+	}
+
+	const uint8_t* data = data_.data() + offset_ + 1;
+	frame = previous_;
+	if (flags & kKeysChanged) {
+		std::memcpy(frame.keys, data, sizeof(frame.keys));
+		data += sizeof(frame.keys);
+	}
+	if (flags & kPadChanged) {
+		std::memcpy(&frame.pad, data, sizeof(frame.pad));
+	}
+	frame.isPadConnected = (flags & kPadConnected) != 0;
+
+	offset_ += size;
+	readCount_++;
+	previous_ = frame;
+	return true;
+}
+
+// Input(記録と再生はInput.cppとHeadlessのNullInput.cppで共通)
+
+bool Input::StartRecording(const std::string& filePath, uint64_t seed, uint32_t stage) {
+	StopReplay();
+	StopRecording(0);
+
+	recorder_ = new InputRecorder();
+	if (!recorder_->Open(filePath, seed, stage)) {
+		delete recorder_;
+		recorder_ = nullptr;
+		return false;
+	}
+	ResetRecordingState();
+	return true;
+}
+
+void Input::StopRecording(uint64_t stateHash) {
+	if (recorder_) {
+		recorder_->Close(stateHash);
+		delete recorder_;
+		recorder_ = nullptr;
+	}
+}
+
+bool Input::StartReplay(const std::string& filePath) {
+	StopRecording(0);
+	StopReplay();
+
+	playback_ = new InputPlayback();
+	if (!playback_->Open(filePath)) {
+		delete playback_;
+		playback_ = nullptr;
+		return false;
+	}
+	ResetRecordingState();
+	return true;
+}
+
+void Input::StopReplay() {
+	delete playback_;
+	playback_ = nullptr;
+}
+
+bool Input::IsReplayFinished() const {
+	return playback_ && playback_->IsFinished();
+}
+
+const InputRecordHeader& Input::GetReplayHeader() const {
+	static const InputRecordHeader kEmpty = {};
+	return playback_ ? playback_->GetHeader() : kEmpty;
+}
+
+void Input::ResetRecordingState() {
+	// 記録と再生で最初のtickの「前の入力」を揃える
+	std::memset(key, 0, sizeof(key));
+	std::memset(&prevState, 0, sizeof(prevState));
+	std::memset(&copyState_, 0, sizeof(copyState_));
+	std::memset(&copyPreState_, 0, sizeof(copyPreState_));
+}
+
+void Input::ApplyRecording() {
+	InputFrame frame;
+	if (playback_) {
+		// 最後まで再生したら、その後は実際の入力に戻る
+		if (!playback_->Read(frame)) {
+			return;
+		}
+		for (uint32_t i = 0; i < 256; ++i) {
+			key[i] = frame.IsKeyDown(i) ? 0x80 : 0;
+		}
+		std::memcpy(&padState_.Gamepad, &frame.pad, sizeof(frame.pad));
+		isPadConnected_ = frame.isPadConnected;
+		return;
+	}
+
+	if (recorder_) {
+		std::memset(frame.keys, 0, sizeof(frame.keys));
+		for (uint32_t i = 0; i < 256; ++i) {
+			frame.SetKey(i, key[i] != 0);
+		}
+		std::memcpy(&frame.pad, &padState_.Gamepad, sizeof(frame.pad));
+		frame.isPadConnected = isPadConnected_;
+		recorder_->Write(frame);
+	}
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// 入力の記録と再生
+// 1tickごとにキーボード(256キーを1bitずつ)とパッド0番の状態を書く
+// 前のtickから変わった部分だけを書くので、何も触っていないtickは1バイト
+
+// パッドの状態(XINPUT_GAMEPADと同じ並び)
+struct InputPadState {
+	uint16_t buttons;
+	uint8_t leftTrigger;
+	uint8_t rightTrigger;
+	int16_t thumbLX;
+	int16_t thumbLY;
+	int16_t thumbRX;
+	int16_t thumbRY;
+};
+
+// 1tick分の入力
+struct InputFrame {
+	uint8_t keys[32];     // 押されているキーのビット
+	InputPadState pad;
+	bool isPadConnected;
+
+	bool IsKeyDown(uint32_t keyNumber) const { return (keys[keyNumber >> 3] >> (keyNumber & 7)) & 1; }
+	void SetKey(uint32_t keyNumber, bool isDown);
+};
+
+// 記録ファイルの先頭
+struct InputRecordHeader {
+	uint32_t magic;       // 'IREC'
+	uint32_t version;
+	uint64_t seed;        // 記録を始めたときのGameRandomのシード
+	uint32_t stage;       // 記録したステージ
+	uint32_t frameCount;
+	uint64_t stateHash;   // 記録を止めたときの状態のハッシュ(再生して同じになるか確かめる)
+};
+
+// 1tickずつファイルに書く
+class InputRecorder {
+public:
+	static const uint32_t kMagic = 0x43455249; // "IREC"
+	static const uint32_t kVersion = 1;
+
+	bool Open(const std::string& filePath, uint64_t seed, uint32_t stage);
+	void Write(const InputFrame& frame);
+	// ヘッダーのフレーム数とハッシュを書き直して閉じる
+	void Close(uint64_t stateHash);
+
+	bool IsOpen() const { return file_.is_open(); }
+	uint32_t GetFrameCount() const { return header_.frameCount; }
+
+private:
+	std::ofstream file_;
+	InputRecordHeader header_ = {};
+	InputFrame previous_ = {};
+};
+
+// 記録ファイルを丸ごと読み込んで1tickずつ取り出す
+class InputPlayback {
+public:
+	// 形式が違うか、途中で切れていればfalse
+	bool Open(const std::string& filePath);
+
+	// 次のtickの入力(最後まで読んだらfalse)
+	bool Read(InputFrame& frame);
+
+	bool IsFinished() const { return readCount_ >= header_.frameCount; }
+	const InputRecordHeader& GetHeader() const { return header_; }
+
+private:
+	std::vector<uint8_t> data_;
+	size_t offset_ = 0;
+	uint32_t readCount_ = 0;
+	InputRecordHeader header_ = {};
+	InputFrame previous_ = {};
+};
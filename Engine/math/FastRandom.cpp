@@ -0,0 +1,37 @@
+#include "FastRandom.h"
+
+void FastRandom::Seed(uint64_t seed) {
+	// 0だけの状態にならないようにsplitmix64で広げる
+	for (int i = 0; i < 4; i += 2) {
+		seed += 0x9E3779B97F4A7C15ull;
+		uint64_t z = seed;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		z ^= z >> 31;
+		state_[i] = static_cast<uint32_t>(z);
+		state_[i + 1] = static_cast<uint32_t>(z >> 32);
+	}
+}
+
+void FastRandom::FillUniform(float* out, size_t count, float min, float max) {
+	// 状態をローカルに持って回す(メンバ経由の読み書きを避ける)
+	uint32_t s0 = state_[0], s1 = state_[1], s2 = state_[2], s3 = state_[3];
+	const float range = (max - min) * (1.0f / 16777216.0f);
+
+	for (size_t i = 0; i < count; ++i) {
+		const uint32_t result = s0 + s3;
+		const uint32_t t = s1 << 9;
+		s2 ^= s0;
+		s3 ^= s1;
+		s1 ^= s2;
+		s0 ^= s3;
+		s2 ^= t;
+		s3 = (s3 << 11) | (s3 >> 21);
+		out[i] = min + static_cast<float>(result >> 8) * range;
+	}
+
+	state_[0] = s0;
+	state_[1] = s1;
+	state_[2] = s2;
+	state_[3] = s3;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// 軽い乱数(xoshiro128+)
+// 状態は16バイトだけなので毎回作り直しても安い。同じシードなら同じ列を返す
+class FastRandom {
+public:
+	FastRandom() { Seed(kDefaultSeed); }
+	explicit FastRandom(uint64_t seed) { Seed(seed); }
+
+	// シードから状態を作る(splitmix64で広げる)
+	void Seed(uint64_t seed);
+
+	uint32_t NextUInt() {
+		const uint32_t result = state_[0] + state_[3];
+		const uint32_t t = state_[1] << 9;
+		state_[2] ^= state_[0];
+		state_[3] ^= state_[1];
+		state_[1] ^= state_[2];
+		state_[0] ^= state_[3];
+		state_[2] ^= t;
+		state_[3] = (state_[3] << 11) | (state_[3] >> 21);
+		return result;
+	}
+
+	// [0, 1)
+	float NextFloat() {
+		// 上位24bitを仮数に使う
+		return static_cast<float>(NextUInt() >> 8) * (1.0f / 16777216.0f);
+	}
+
+	// [min, max)
+	float NextFloat(float min, float max) {
+		return min + (max - min) * NextFloat();
+	}
+
+	// outにcount個の[min, max)を書く
+	void FillUniform(float* out, size_t count, float min, float max);
+
+	static const uint64_t kDefaultSeed = 0x5DEECE66Dull;
+
+private:
+	uint32_t state_[4];
+};
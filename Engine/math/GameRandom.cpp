@@ -0,0 +1,26 @@
+#include "GameRandom.h"
+#include <random>
+
+GameRandom* GameRandom::instance = nullptr;
+
+GameRandom* GameRandom::GetInstance() {
+	if (instance == nullptr) {
+		instance = new GameRandom();
+	}
+	return instance;
+}
+
+void GameRandom::Finalize() {
+	delete instance;
+	instance = nullptr;
+}
+
+GameRandom::GameRandom() {
+	std::random_device device;
+	Seed((static_cast<uint64_t>(device()) << 32) | device());
+}
+
+void GameRandom::Seed(uint64_t seed) {
+	seed_ = seed;
+	random_.Seed(seed);
+}
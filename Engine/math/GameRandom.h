@@ -0,0 +1,34 @@
+#pragma once
+#include "FastRandom.h"
+#include <cstdint>
+
+// ゲームの乱数(敵の動き、揺れ、破片など)はすべてここから取る
+// 同じシードで同じ入力を与えれば同じ列になるので、入力のリプレイで同じ結果が出る
+// 起動時は毎回違うシードで始まる(以前のsrand(time)と同じ)
+class GameRandom {
+public:
+	static GameRandom* GetInstance();
+	void Finalize();
+
+	void Seed(uint64_t seed);
+	uint64_t GetSeed() const { return seed_; }
+
+	uint32_t NextUInt() { return random_.NextUInt(); }
+
+	// [0, 1)
+	float NextFloat() { return random_.NextFloat(); }
+
+	// [min, max)
+	float NextFloat(float min, float max) { return random_.NextFloat(min, max); }
+
+private:
+	GameRandom();
+	~GameRandom() = default;
+	GameRandom(const GameRandom&) = delete;
+	GameRandom& operator=(const GameRandom&) = delete;
+
+	static GameRandom* instance;
+
+	FastRandom random_;
+	uint64_t seed_ = 0;
+};
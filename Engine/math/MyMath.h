@@ -26,6 +26,7 @@
 
 	struct ModelData {
 		std::vector<VertexData> vertices;
+		std::vector<uint32_t> indices; // 空なら3頂点ずつの非インデックス描画
 		MaterialData material;
 	};
 
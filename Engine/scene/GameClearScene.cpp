@@ -1,4 +1,5 @@
 #include "GameClearScene.h"
+#include "GameTimer.h"
 #include "GameData.h"
 
 void GameClearScene::Initialize() {
@@ -113,7 +114,7 @@ void GameClearScene::Update() {
 
 	stageClear->Update();
 
-	const float deltaTime = 1.0f / 60.0f;
+	const float deltaTime = GameTimer::GetInstance()->GetDeltaTime();
 
 	// 矢印のアニメーション
 	animationTime_ += deltaTime;
@@ -143,4 +144,6 @@ void GameClearScene::Finalize() {
 	delete stageClear;
 	delete Arrow;
 	delete backGround;
+	audio_->UnloadWave(selectSound_);
+	audio_->UnloadWave(decisionSound_);
 }
\ No newline at end of file
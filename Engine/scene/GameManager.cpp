@@ -1,4 +1,6 @@
 #include "GameManager.h"
+#include "TraceRecorder.h"
+#include "Audio.h"
 
 GameManager::GameManager() {
 	// 最初はローディングシーンから開始
@@ -48,6 +50,7 @@ void GameManager::Initialize() {
 }
 
 void GameManager::Update() {
+	TRACE_SCOPE("GameManager::Update");
 
 	prevSceneNo_ = currentSceneNo_;
 	currentSceneNo_ = sceneArr_[currentSceneNo_]->GetSceneNo();
@@ -63,11 +66,18 @@ void GameManager::Update() {
 
 		SceneChange(prevSceneNo_, currentSceneNo_);
 		sceneArr_[currentSceneNo_]->Initialize();
+
+		// 前のシーンだけで使っていた波形を捨てる(次のシーンでも使う波形はInitializeで参照が付いているので残る)
+		Audio::GetInstance()->ReleaseUnusedWaves();
 	}
 
 	sceneArr_[currentSceneNo_]->Update();
 }
 
+void GameManager::UpdateImGui() {
+	sceneArr_[currentSceneNo_]->UpdateImGui();
+}
+
 void GameManager::Draw() {
 	sceneArr_[currentSceneNo_]->Draw();
 }
\ No newline at end of file
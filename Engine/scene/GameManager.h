@@ -16,6 +16,7 @@ public:
 
 	void Initialize();
 	void Update();
+	void UpdateImGui();
 	void Draw();
 	//void Finalize();
 
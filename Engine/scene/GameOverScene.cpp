@@ -1,4 +1,5 @@
 #include "GameOverScene.h"
+#include "GameTimer.h"
 
 void GameOverScene::Initialize() {
 	gameOver = new Sprite();
@@ -92,7 +93,7 @@ void GameOverScene::Update() {
 
 	gameOver->Update();
 	
-	const float deltaTime = 1.0f / 60.0f;
+	const float deltaTime = GameTimer::GetInstance()->GetDeltaTime();
 
 	// 矢印のアニメーション
 	animationTime_ += deltaTime;
@@ -119,4 +120,6 @@ void GameOverScene::Draw() {
 void GameOverScene::Finalize() {
 	delete gameOver;
 	delete Arrow;
+	audio_->UnloadWave(selectSound_);
+	audio_->UnloadWave(decisionSound_);
 }
\ No newline at end of file
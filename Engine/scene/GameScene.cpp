@@ -1,6 +1,15 @@
 #include "GameScene.h"
-#include "ParticleNumber.h"
+#include "GameTimer.h"
 #include "ImGuiManager.h"
+#include "StageCollisionCache.h"
+#include "AllocationCounter.h"
+#include "ParticleManager.h"
+#include "PerformanceMonitor.h"
+#include "TraceRecorder.h"
+#include "GameRandom.h"
+#include "ParticleEmitter.h"
+#include "StateHash.h"
+#include "Logger.h"
 #include <filesystem>
 
 GameScene::GameScene() {}
@@ -17,7 +26,10 @@ void GameScene::Finalize() {
 
 	delete uiManager;
 
-	allObstacles_.clear();
+	collisionWorld_.Clear();
+
+	audio_->UnloadWave(selectSound_);
+	audio_->StopMusic();
 }
 
 void GameScene::Initialize() {
@@ -72,7 +84,7 @@ void GameScene::Initialize() {
 	// CSVから敵の情報を読み込み
 	if (enemyLoader_->LoadEnemyData(enemiesFile)) {
 		// 敵を生成
-		enemyLoader_->CreateEnemies(player_, allObstacles_);
+		enemyLoader_->CreateEnemies(player_, &collisionWorld_);
 	}
 
 	// 各種敵リストをプレイヤーに設定
@@ -106,11 +118,6 @@ void GameScene::Initialize() {
 	player_->SetDoor(doors);
 
 
-	// 障害物リストを Player にセット
-	for (const auto& obstacles : allObstacles_) {
-		player_->SetObstacleList(obstacles);
-	}
-
 	// プレイヤーにGoalへの参照を設定
 	if (mapLoader_ && mapLoader_->GetGoal()) {
 		player_->SetGoal(mapLoader_->GetGoal());
@@ -159,11 +166,7 @@ void GameScene::Initialize() {
 		OutputDebugStringA(bgmDebugMsg.c_str());
 	}
 	
-	BGMSound = audio_->LoadWave(bgmFile.c_str());
-	audio_->SoundPlayWave(BGMSound, 0.25f, true);
-
-	//パーテイクルのメモリ対策でリセット
-	ParticleNum::number = 0;
+	audio_->PlayMusic(bgmFile.c_str(), 0.25f, true);
 
 	//前のシーンのボタン情報の取得
 	state = Input::GetInstance()->GetState();
@@ -171,6 +174,11 @@ void GameScene::Initialize() {
 }
 
 void GameScene::Update() {
+	UpdateScene();
+	UpdateReplay();
+}
+
+void GameScene::UpdateScene() {
 
 	camera_->Update();
 
@@ -184,8 +192,12 @@ void GameScene::Update() {
 		isPaused_ = !isPaused_;
 	}
 
-	// ImGuiの更新
-	UpdateImGui();
+#ifdef _DEBUG
+	// 経過時間を更新(ハイライト表示用)
+	if (objectRotations_.lastModifiedTime > 0) {
+		objectRotations_.lastModifiedTime -= GameTimer::GetInstance()->GetDeltaTime(); // 1秒間ハイライト表示
+	}
+#endif
 
 // マウス選択機能は現在無効化されています
 	// TODO: マウス入力システムを実装後に有効化
@@ -243,12 +255,12 @@ void GameScene::Update() {
 			((state.Gamepad.wButtons & XINPUT_GAMEPAD_A) && !(preState.Gamepad.wButtons & XINPUT_GAMEPAD_A))) {		
 			if (pauseCount_ == 1) {
 				Finalize();
-				audio_->StopWave(BGMSound);
+				audio_->StopMusic();
 				Initialize();
 				isPaused_ = !isPaused_;
 			}		
 			if (pauseCount_ == 2) {
-				audio_->StopWave(BGMSound);
+				audio_->StopMusic();
 				sceneNo = Select;
 			}
 			Input::GetInstance()->SetStates(state, preState);
@@ -259,7 +271,7 @@ void GameScene::Update() {
 
 	// リスタート処理
 	if (Input::GetInstance()->PushKey(DIK_R) || ((state.Gamepad.wButtons & XINPUT_GAMEPAD_Y) && (preState.Gamepad.wButtons & XINPUT_GAMEPAD_Y))) {
-		longPress -= 1.0f / 60.0f;
+		longPress -= GameTimer::GetInstance()->GetDeltaTime();
 	}
 	else {
 		longPress = RestartTimer;
@@ -267,7 +279,7 @@ void GameScene::Update() {
 	// 0になった時リスタート / 押しなおさないと更新されなくする
 	if (longPress < 0 && longPress > -0.017f) {
 		Finalize();
-		audio_->StopWave(BGMSound);
+		audio_->StopMusic();
 		Initialize();
 	}
 	
@@ -275,7 +287,7 @@ void GameScene::Update() {
 	//フェードが終わったらステージクリアかゲームオーバーのシーンに移動
 	if (FadeManager::GetInstance()->IsFadeComplete() && (isClear || isOver)) {
 		if (isClear) {
-			audio_->StopWave(BGMSound); //GameClearSceneに遷移
+			audio_->StopMusic(); //GameClearSceneに遷移
 			sceneNo = GameClear;
 			return; // ゴールクリア状態なら更新処理をスキップ
 		}
@@ -295,7 +307,7 @@ void GameScene::Update() {
 
 	// プレイヤーのHPが0になった場合、GameOverSceneに移行
 	if (player_->GetHp() <= 0 && !isOver) {
-		audio_->StopWave(BGMSound);
+		audio_->StopMusic();
 		//デスパーティクルが終わった時
 		if (!player_->GetDeadPlayer()) {
 			//フェードアウト開始
@@ -310,6 +322,8 @@ void GameScene::Update() {
 	}
 
 	player_->Update();
+	// 効果音の距離はプレイヤーから測る
+	audio_->SetListenerPosition(player_->GetWorldPosition());
 
 	// EnemyLoaderの更新
 	if (enemyLoader_) {
@@ -358,6 +372,10 @@ void GameScene::Draw() {
 	//モデル描画処理
 	Object3dCommon::GetInstance()->Command();
 
+#ifdef _DEBUG
+	uint64_t allocationStart = AllocationCounter::GetCount();
+#endif
+
 	skydome_->Draw();
 
 	stage->Draw(worldTransform_);
@@ -374,6 +392,14 @@ void GameScene::Draw() {
 		mapLoader_->Draw();
 	}
 
+#ifdef _DEBUG
+	// モデル描画ではヒープ確保をしない(確かめるのはSelfTest::TestDrawAllocations。ここは実機で気付くためのログ)
+	uint64_t allocations = AllocationCounter::GetCount() - allocationStart;
+	if (allocations > 0 && drawAllocationCount_ == 0) {
+		OutputDebugStringA(("GameScene::Draw - " + std::to_string(allocations) + " heap allocations while drawing models\n").c_str());
+	}
+	drawAllocationCount_ = allocations;
+#endif
 
 
 	//パーティクル描画処理
@@ -397,6 +423,8 @@ void GameScene::Draw() {
 			mapLoader_->GetGoal()->DrawP();
 		}
 	}
+	//テクスチャごとにまとめて描画
+	ParticleManager::GetInstance()->Draw();
 
 	//スプライト描画処理(UI用)
 	SpriteCommon::GetInstance()->Command();
@@ -444,12 +472,8 @@ void GameScene::Draw() {
 
 
 void GameScene::ChangeStage(int nextStage) {
-	allObstacles_.clear();
-	Command.str("");
-	Command.clear();
-
 	// 前のステージのBGMを停止
-	audio_->StopWave(BGMSound);
+	audio_->StopMusic();
 
 	currentStage_ = nextStage;
 	
@@ -487,8 +511,7 @@ void GameScene::ChangeStage(int nextStage) {
 		OutputDebugStringA(changeDebugMsg.c_str());
 	}
 	
-	BGMSound = audio_->LoadWave(bgmFile.c_str());
-	audio_->SoundPlayWave(BGMSound, 0.25f, true);
+	audio_->PlayMusic(bgmFile.c_str(), 0.25f, true);
 
 	//前ステージの削除
 	delete stage;
@@ -497,14 +520,6 @@ void GameScene::ChangeStage(int nextStage) {
 	stage->Initialize();
 	stage->SetModelFile("stage" + std::to_string(currentStage_));
 
-	// **プレイヤーと敵の障害物リストをクリア**
-	player_->ClearObstacleList();
-	if (enemyLoader_) {
-		for (auto& enemy : enemyLoader_->GetGhostList()) {
-			enemy->ClearObstacleList();
-		}
-	}
-
 	// 新しいオブジェクトデータをロード
 	if (mapLoader_) {
 		std::string objectsFile = "resource/objects" + std::to_string(currentStage_) + ".csv";
@@ -518,16 +533,6 @@ void GameScene::ChangeStage(int nextStage) {
 	std::string stageFile = "resource/Object/stage" + std::to_string(currentStage_) + "/stage" + std::to_string(currentStage_) + ".obj";
 	LoadStage(stageFile);
 
-	// バネ
-	for (auto& springEnemy : enemyLoader_->GetSpringEnemyList()) {
-		springEnemy->ClearObstacleList();
-	}
-
-	// **プレイヤーに新しい障害物リストを設定**
-	for (const auto& obstacles : allObstacles_) {
-		player_->SetObstacleList(obstacles);
-	}
-
 	// **敵の当たり判定も再設定**
 	if (enemyLoader_) {
 		delete enemyLoader_;
@@ -536,14 +541,7 @@ void GameScene::ChangeStage(int nextStage) {
 
 	std::string enemiesFile = "resource/enemies" + std::to_string(currentStage_) + ".csv";
 	if (enemyLoader_->LoadEnemyData(enemiesFile)) {
-		enemyLoader_->CreateEnemies(player_, allObstacles_);
-	}
-
-	// 敵の当たり判定リストを再設定
-	for (auto& enemy : enemyLoader_->GetGhostList()) {
-		for (const auto& obstacles : allObstacles_) {
-			enemy->SetObstacleList(obstacles);
-		}
+		enemyLoader_->CreateEnemies(player_, &collisionWorld_);
 	}
 
 	// プレイヤーに敵リストを設定
@@ -572,59 +570,104 @@ void GameScene::ChangeStage(int nextStage) {
 	}
 }
 
-// AddObstacle、LoadStage、UpdateStageAABBメソッドはそのまま以前の実装を使用
-void GameScene::AddObstacle(std::vector<std::vector<AABB>>& allObstacles, const Vector3& min, const Vector3& max) {
-	AABB obstacle;
-	obstacle.min = min;
-	obstacle.max = max;
-	if (allObstacles.empty() || allObstacles.back().size() >= 500) { // 100個の障害物を追加
-		allObstacles.emplace_back();
-	}
-	allObstacles.back().push_back(obstacle);
+void GameScene::LoadStage(std::string objFile) {
+	// キャッシュがあればOBJを読まずに済ませる
+	std::vector<AABB> obstacles;
+	bool isLoaded = StageCollisionCache::LoadOrBuild(objFile, obstacles);
+	assert(isLoaded);
+	(void)isLoaded;
+
+	// 当たり判定を作り直す
+	collisionWorld_.Build(std::move(obstacles));
+
+	// プレイヤーと敵は同じ当たり判定を参照する
+	player_->SetCollisionWorld(&collisionWorld_);
 }
 
-void GameScene::LoadStage(std::string objFile) {
-	// ステージデータの読み込み
-	std::ifstream file;
-	file.open(objFile);
-	assert(file.is_open());
+void GameScene::UpdateReplay() {
+	Input* input = Input::GetInstance();
 
-	// Commandをリセット
-	Command.str("");
-	Command.clear();
+	// このtickの結果をハッシュに混ぜる
+	if (input->IsRecording() || input->IsReplaying()) {
+		replayHash_ = StateHash::Combine(replayHash_, StateHash::Compute(player_, enemyLoader_, mapLoader_));
+	}
 
-	Command << file.rdbuf();
-	file.close();
+	// 記録はシーンが変わるか止めるまで(次のtickの入力は書かない)
+	if (input->IsRecording() && (sceneNo != Game || replayRequest_ == ReplayRequest::StopRecording)) {
+		input->StopRecording(replayHash_);
+		char text[96];
+		sprintf_s(text, "Recorded input.rec (hash %016llx)", static_cast<unsigned long long>(replayHash_));
+		replayStatus_ = text;
+		Logger::log(replayStatus_ + "\n");
+	}
 
-	// 障害物データをクリア
-	allObstacles_.clear();
+	// 最後のtickまで再生したら、記録したときのハッシュと比べる
+	if (input->IsReplaying() && input->IsReplayFinished()) {
+		const InputRecordHeader& header = input->GetReplayHeader();
+		char text[128];
+		sprintf_s(text, "Replay %s (hash %016llx, recorded %016llx)", replayHash_ == header.stateHash ? "matched" : "MISMATCHED",
+			static_cast<unsigned long long>(replayHash_), static_cast<unsigned long long>(header.stateHash));
+		replayStatus_ = text;
+		Logger::log(replayStatus_ + "\n");
+		input->StopReplay();
+	}
 
-	UpdateStageAABB();
+	if (sceneNo != Game) {
+		replayRequest_ = ReplayRequest::None;
+		return;
+	}
 
-	player_->ClearObstacleList(); // 古い障害物リストを削除
-	// 新しい障害物リスト
-	for (const auto& obstacles : allObstacles_) {
-		player_->SetObstacleList(obstacles);
+	switch (replayRequest_) {
+	case ReplayRequest::Record: {
+		// 新しいシードでステージを最初からやり直して記録する
+		GameRandom* random = GameRandom::GetInstance();
+		uint64_t seed = (static_cast<uint64_t>(random->NextUInt()) << 32) | random->NextUInt();
+		if (input->StartRecording("input.rec", seed, static_cast<uint32_t>(currentStage_))) {
+			RestartForReplay(seed);
+			replayStatus_ = "Recording...";
+		} else {
+			replayStatus_ = "Could not open input.rec";
+		}
+		break;
+	}
+	case ReplayRequest::Replay:
+		// 記録したステージとシードでやり直して再生する
+		if (input->StartReplay("input.rec")) {
+			const InputRecordHeader& header = input->GetReplayHeader();
+			GameData::selectedStage = static_cast<int>(header.stage);
+			RestartForReplay(header.seed);
+			replayStatus_ = "Replaying...";
+		} else {
+			replayStatus_ = "Could not read input.rec";
+		}
+		break;
+	default:
+		break;
 	}
+	replayRequest_ = ReplayRequest::None;
+}
 
-	//たまにバグる
-	//if (enemyLoader_) {
-	//	for (auto& enemy : enemyLoader_->GetEnemyList()) {
-	//		enemy->ClearObstacleList();
-	//		for (const auto& obstacles : allObstacles_) {
-	//			enemy->SetObstacleList(obstacles);
-	//		}
-	//	}
-	//}
+void GameScene::RestartForReplay(uint64_t seed) {
+	Finalize();
+
+	// 敵は作るときに乱数を使うので、Initializeより前に揃える
+	GameRandom::GetInstance()->Seed(seed);
+	ParticleEmitter::GetInstance()->SetSeed(seed);
+
+	// Initializeで戻らない状態
+	isClear = false;
+	isOver = false;
+	isPaused_ = false;
+	pauseCount_ = 1;
+	stopSteck = false;
+	longPress = RestartTimer;
+
+	Initialize();
+	replayHash_ = StateHash::kInitialHash;
 }
 
 void GameScene::UpdateImGui() {
 #ifdef _DEBUG
-	// 経過時間を更新(ハイライト表示用)
-	if (objectRotations_.lastModifiedTime > 0) {
-		objectRotations_.lastModifiedTime -= 1.0f / 60.0f; // 1秒間ハイライト表示
-	}
-
 	// ImGuiウィンドウを作成
 	ImGui::Begin("Object Rotations");
 
@@ -757,117 +800,102 @@ void GameScene::UpdateImGui() {
 		}
 	}
 
-	// TODO: 他のオブジェクトにもSetRotateX/Y/Zメソッドを追加する必要があります
-	// 下記のクラスにはこれらのメソッドが実装されていません
-	// Block, Key, GhostBlock, Enemy/GhostEnemy, CannonEnemy, SpringEnemy, Player, Goal
-
-	ImGui::End();
-
-	// MapLoaderのImGui更新を呼び出す
-	if (mapLoader_) {
-		mapLoader_->UpdateImGui();
+	// ステージ障害物のブロードフェーズ
+	if (ImGui::CollapsingHeader("Stage Collision")) {
+		ImGui::Text("Obstacles: %d  Cells: %d", static_cast<int>(collisionWorld_.GetBoxCount()), static_cast<int>(collisionWorld_.GetGrid().GetCellCount()));
 	}
-	
-	// EnemyLoaderのImGui更新を呼び出す
-	if (enemyLoader_) {
-		enemyLoader_->UpdateImGui();
-	}
-#endif
-}
 
-void GameScene::UpdateStageAABB() {
-	std::string line;
-	uint32_t cornerNumber = 0;
-
-	Vector3 max;
-	Vector3 min;
+	// モデル描画中のヒープ確保
+	if (ImGui::CollapsingHeader("Model Loading")) {
+		ImGui::Text("Heap allocations in model draw: %d", static_cast<int>(drawAllocationCount_));
+	}
 
-	// AABB stageAABB;
-	bool start = false;
-	bool reverse = false;
+	// パーティクルの描画数
+	if (ImGui::CollapsingHeader("Particles")) {
+		ParticleManager* particleManager = ParticleManager::GetInstance();
+		ImGui::Text("Textures: %d  Drawn: %d  Dropped: %d", static_cast<int>(particleManager->GetGroupCount()),
+			static_cast<int>(particleManager->GetDrawnInstanceCount()), static_cast<int>(particleManager->GetDroppedInstanceCount()));
+	}
 
-	while (getline(Command, line)) {
-		std::istringstream line_stream(line);
+	// 共有している波形の状況
+	if (ImGui::CollapsingHeader("Sound")) {
+		const SoundBank& soundBank = audio_->GetSoundBank();
+		ImGui::Text("Buffers: %d  %.1f KB", static_cast<int>(soundBank.GetBufferCount()), soundBank.GetLoadedBytes() / 1024.0);
+		ImGui::Text("File loads: %d  Shared: %d  Load time: %.2f ms", static_cast<int>(soundBank.GetFileLoadCount()),
+			static_cast<int>(soundBank.GetCacheHitCount()), soundBank.GetLoadMilliseconds());
+		ImGui::Text("Music: %s  Stream buffer: %d KB", audio_->IsMusicPlaying() ? "streaming" : "stopped",
+			static_cast<int>(MusicStream::GetBufferBytes() / 1024));
+		const SoundMixer& mixer = audio_->GetMixer();
+		ImGui::Text("SE voices: %d/%d  Stolen: %d  Capped: %d  Rejected: %d", static_cast<int>(mixer.GetActiveVoiceCount()),
+			static_cast<int>(SoundMixer::kVoiceCount), static_cast<int>(mixer.GetStolenCount()),
+			static_cast<int>(mixer.GetCappedCount()), static_cast<int>(mixer.GetRejectedCount()));
+	}
 
-		std::string word;
+	// フレーム時間の分布(引っかかりはp99/maxに出る)
+	if (ImGui::CollapsingHeader("Performance")) {
+		PerformanceMonitor::GetInstance()->DrawDebugInfo();
 
-		getline(line_stream, word, ' ');
+		// 固定間隔の更新(描画1回で何tick進んだか)
+		GameTimer* gameTimer = GameTimer::GetInstance();
+		ImGui::Text("Tick %.0f Hz  ticks/frame %u  alpha %.2f  dropped %.2fs", GameTimer::kTickRate,
+			gameTimer->GetFrameTickCount(), gameTimer->GetAlpha(), gameTimer->GetDroppedTime());
 
-		if (word.find("vn") == 0) {
-			break; //vを読み取ったら終了
+		// フレームレートの固定(描画の間隔の揺れ)
+		FramePacer* framePacer = DirectXCommon::GetInstance()->GetFramePacer();
+		float targetRate = framePacer->GetTargetRate();
+		if (ImGui::SliderFloat("Target FPS", &targetRate, 30.0f, 240.0f, "%.0f")) {
+			framePacer->SetTargetRate(targetRate);
+			PerformanceMonitor::GetInstance()->SetTargetFPS(targetRate);
 		}
-
-		if (word.find("v") == 0) {
-			cornerNumber++;
+		FramePacer::PacingStats pacing = framePacer->GetStats();
+		ImGui::Text("Interval mean %.3f  sd %.3f  min %.2f  max %.2f ms", pacing.mean, pacing.standardDeviation, pacing.min, pacing.max);
+		ImGui::Text("Spin %.3f ms/frame  missed %u  late wake %u", pacing.spin, pacing.missedCount, pacing.lateWakeCount);
+
+		// 区間の記録(chrome://tracing / ui.perfetto.devで開く)
+		bool isTraceEnabled = TraceRecorder::IsEnabled();
+		if (ImGui::Checkbox("Record trace", &isTraceEnabled)) {
+			TraceRecorder::SetEnabled(isTraceEnabled);
 		}
-		else {
-			continue;
+		if (ImGui::Button("Dump Chrome trace (trace.json)")) {
+			TraceRecorder::GetInstance()->WriteChromeTrace("trace.json");
 		}
 
-		if (cornerNumber > 0) {
-
-			getline(line_stream, word, ' ');
-			float x = (float)std::atof(word.c_str());
-
-			getline(line_stream, word, ' ');
-			float y = (float)std::atof(word.c_str());
-
-			getline(line_stream, word, ' ');
-			float z = (float)std::atof(word.c_str());
-
-			if (!start) {
-				max = { x, y, z };
-				min = { x, y, z };
-				start = true;
+		// 入力の記録と再生(乱数のシードも記録し、再生して同じ状態になるかをハッシュで比べる)
+		Input* input = Input::GetInstance();
+		if (input->IsRecording()) {
+			if (ImGui::Button("Stop recording")) {
+				replayRequest_ = ReplayRequest::StopRecording;
 			}
-			else {
-
-				// 前よりも大きいとき
-				if (max.x <= x) {
-					max.x = x;
-				}
-				// 前よりも小さいとき
-				if (min.x > x) {
-					min.x = x;
-				}
-
-				if (max.y <= y) {
-					max.y = y;
-				}
-
-				if (min.y > y) {
-					min.y = y;
-				}
-
-				if (max.z <= z) {
-					max.z = z;
-				}
-
-				if (min.z > z) {
-					min.z = z;
-				}
+		} else if (!input->IsReplaying()) {
+			if (ImGui::Button("Record input (input.rec)")) {
+				replayRequest_ = ReplayRequest::Record;
+			}
+			ImGui::SameLine();
+			if (ImGui::Button("Replay input")) {
+				replayRequest_ = ReplayRequest::Replay;
 			}
 		}
+		ImGui::Text("%s  seed %016llx", replayStatus_.c_str(), static_cast<unsigned long long>(GameRandom::GetInstance()->GetSeed()));
+	}
 
-		if (cornerNumber == 8) {
-			if (!reverse) {
-				AddObstacle(allObstacles_, min, max); // 結合した基盤となるobj
-			}
-			else {
+	// TODO: 他のオブジェクトにもSetRotateX/Y/Zメソッドを追加する必要があります
+	// 下記のクラスにはこれらのメソッドが実装されていません
+	// Block, Key, GhostBlock, Enemy/GhostEnemy, CannonEnemy, SpringEnemy, Player, Goal
 
-				float minX;
-				float maxX;
-				maxX = -(max.x);
-				minX = -(min.x);
+	ImGui::End();
 
-				min.x = maxX;
-				max.x = minX;
-				AddObstacle(allObstacles_, { min.x, min.y, min.z }, { max.x, max.y, max.z }); // それ以外のすべてobj
-			}
+	// MapLoaderのImGui更新を呼び出す
+	if (mapLoader_) {
+		mapLoader_->UpdateImGui();
+	}
+	
+	// EnemyLoaderのImGui更新を呼び出す
+	if (enemyLoader_) {
+		enemyLoader_->UpdateImGui();
+	}
 
-			cornerNumber = 0;
-			start = false;
-			reverse = true;
-		}
+	if (player_) {
+		player_->UpdateImGui();
 	}
-}
\ No newline at end of file
+#endif
+}
@@ -8,7 +8,7 @@
 // 2D/3D描画
 #include "Sprite.h"
 #include "Object3d.h"
-#include "particle.h"
+#include "Particle.h"
 #include "Camera.h"
 
 // オーディオ
@@ -22,8 +22,9 @@
 #include "GhostBlock.h"
 #include "Door.h"
 #include "Goal.h"
-#include "Key.h"
-#include "Skydome.h"
+#include "key.h"
+#include "SkyDome.h"
+#include "CollisionWorld.h"
 
 // ローダー/マネージャー
 #include "MapLoader.h"
@@ -43,6 +44,7 @@ public:
 
 	void Initialize() override;
 	void Update() override;
+	void UpdateImGui() override;
 	void Draw() override;
 	void Finalize() override;
 
@@ -53,15 +55,19 @@ public:
 
 private:
 	// プライベートメンバ関数
-	void AddObstacle(std::vector<std::vector<AABB>>& allObstacles, const Vector3& min, const Vector3& max);
 	void LoadStage(std::string objFile);
-	void UpdateStageAABB();
-	void UpdateImGui();
+	void UpdateScene();
+
+	// 入力の記録と再生(tickの最後に状態のハッシュを混ぜ、ボタンの要求を処理する)
+	void UpdateReplay();
+	// シードを揃えてステージを最初からやり直す
+	void RestartForReplay(uint64_t seed);
 
 	// ステージ管理
 	int currentStage_ = 0;
 	Object3d* stage = nullptr;
-	std::vector<std::vector<AABB>> allObstacles_;
+	// ステージの当たり判定(読み込み時に構築し、各エンティティで共有)
+	CollisionWorld collisionWorld_;
 
 	// カメラ関連
 	Camera* camera_ = nullptr;
@@ -79,7 +85,6 @@ private:
 
 	// オーディオ関連
 	Audio* audio_ = nullptr;
-	SoundData BGMSound;
 	int stageBGMHandle_ = 0;
 	int stageBGMID_ = -1;
 
@@ -100,7 +105,21 @@ private:
 	// その他
 	WorldTransform worldTransform_;
 	uint32_t textureHandle = 0;
-	std::stringstream Command;
+
+	// 入力の記録と再生
+	enum class ReplayRequest {
+		None,
+		Record,
+		StopRecording,
+		Replay,
+	};
+	ReplayRequest replayRequest_ = ReplayRequest::None;
+	// 記録・再生を始めてからの状態のハッシュ
+	uint64_t replayHash_ = 0;
+	std::string replayStatus_;
+
+	// 3D描画中に起きたヒープ確保の回数(Debugのみ、0であるべき)
+	uint64_t drawAllocationCount_ = 0;
 
 	// ImGui用デバッグ変数
 	struct ObjectRotations {
@@ -18,6 +18,8 @@ protected:
 public:
 	virtual void Initialize() = 0;
 	virtual void Update() = 0;
+	// デバッグ表示(tickの数によらず描画1回につき1回呼ばれる)
+	virtual void UpdateImGui() {}
 	virtual void Draw() = 0;
 	virtual void Finalize() = 0;
 
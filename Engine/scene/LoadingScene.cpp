@@ -1,14 +1,19 @@
 #include "LoadingScene.h"
 #include "ResourceManager.h"
 #include "PerformanceMonitor.h"
+#include "GameTimer.h"
 #include "math/Vector4.h"
 #include <algorithm>
 
 void LoadingScene::Initialize() {
     OutputDebugStringA("LoadingScene::Initialize() 開始\n");
     
-    // パフォーマンスモニター初期化
-    PerformanceMonitor::GetInstance()->BeginSection("LoadingSceneInit");
+    // パフォーマンスモニター初期化(セクションは番号で計測する)
+    PerformanceMonitor* performanceMonitor = PerformanceMonitor::GetInstance();
+    initSection_ = performanceMonitor->RegisterSection("LoadingSceneInit");
+    updateSection_ = performanceMonitor->RegisterSection("LoadingSceneUpdate");
+    drawSection_ = performanceMonitor->RegisterSection("LoadingSceneDraw");
+    performanceMonitor->BeginSection(initSection_);
     
     // ResourceManager初期化
     ResourceManager::GetInstance()->Initialize();
@@ -39,7 +44,7 @@ void LoadingScene::Initialize() {
     // バッチローディング開始
     ResourceManager::GetInstance()->StartBatchLoading();
     
-    PerformanceMonitor::GetInstance()->EndSection("LoadingSceneInit");
+    PerformanceMonitor::GetInstance()->EndSection(initSection_);
     OutputDebugStringA("LoadingScene::Initialize() 完了\n");
 }
 
@@ -174,7 +179,7 @@ void LoadingScene::PrepareResourceQueue() {
 }
 
 void LoadingScene::Update() {
-    PerformanceMonitor::GetInstance()->BeginSection("LoadingSceneUpdate");
+    PerformanceMonitor::GetInstance()->BeginSection(updateSection_);
     
     // UIアニメーション更新
     UpdateAnimations();
@@ -194,7 +199,7 @@ void LoadingScene::Update() {
         ResourceManager::GetInstance()->PrintDebugInfo();
     }
     
-    PerformanceMonitor::GetInstance()->EndSection("LoadingSceneUpdate");
+    PerformanceMonitor::GetInstance()->EndSection(updateSection_);
 }
 
 void LoadingScene::UpdateAnimations() {
@@ -203,10 +208,10 @@ void LoadingScene::UpdateAnimations() {
     progressBarBg->Update();
     
     // アイコン回転（2秒で1回転）
-    // 2秒で2πラジアン = 1秒でπラジアン = 60FPSでπ/60ラジアン/フレーム
+    // 2秒で2πラジアン = 1秒でπラジアン
     const float PI = 3.14159265359f;
-    const float rotationSpeed = PI / 60.0f;  // 2秒で1回転
-    rotationAngle += rotationSpeed;
+    const float rotationSpeed = PI;  // 2秒で1回転(ラジアン/秒)
+    rotationAngle += rotationSpeed * GameTimer::GetInstance()->GetDeltaTime();
     float wobble = sin(rotationAngle * 0.02f) * 5.0f;
     loadingIcon->SetPosition({ posX, posY + wobble });
     loadingIcon->SetRotate(rotationAngle);
@@ -327,7 +332,7 @@ void LoadingScene::HandleLoadingComplete() {
 }
 
 void LoadingScene::Draw() {
-    PerformanceMonitor::GetInstance()->BeginSection("LoadingSceneDraw");
+    PerformanceMonitor::GetInstance()->BeginSection(drawSection_);
     
     SpriteCommon::GetInstance()->Command();
     
@@ -347,7 +352,7 @@ void LoadingScene::Draw() {
     loadingText->Draw();
     loadingIcon->Draw();
     
-    PerformanceMonitor::GetInstance()->EndSection("LoadingSceneDraw");
+    PerformanceMonitor::GetInstance()->EndSection(drawSection_);
 }
 
 void LoadingScene::Finalize() {
@@ -357,6 +362,7 @@ void LoadingScene::Finalize() {
     if (!isSoundStopped) {
         Audio::GetInstance()->StopWave(loadingSound);
     }
+    Audio::GetInstance()->UnloadWave(loadingSound);
     
     // スプライト削除
     delete background;
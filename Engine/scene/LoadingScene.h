@@ -77,4 +77,9 @@ private:
     // 音声関連
     SoundData loadingSound; // ローディング中のBGM
     bool isSoundStopped = false; // 音声停止フラグ
+
+    // 計測セクション
+    uint32_t initSection_ = 0;
+    uint32_t updateSection_ = 0;
+    uint32_t drawSection_ = 0;
 };
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "StageSelect.h"
+#include "GameTimer.h"
 #include "FadeManager.h"
 #include <iostream>
 #include  <string>
@@ -104,7 +105,7 @@ void StageSelect::Update() {
 		bool isPlus = false;  //数字が増える 
 		bool isMinus = false; //数字が減る
 
-		const float deltaTimer = 1.0f / 60.0f;
+		const float deltaTimer = GameTimer::GetInstance()->GetDeltaTime();
 
 		if (Input::GetInstance()->GetJoystickState(0, state)) {
 			// 左スティック
@@ -176,7 +177,10 @@ void StageSelect::Update() {
 
 	camera_->Update();
 
-#pragma region デバッグ表示
+	worldTransform_.UpdateMatrix();
+}
+
+void StageSelect::UpdateImGui() {
 #ifdef _DEBUG
 	ImGui::Begin("camera");
 
@@ -185,10 +189,6 @@ void StageSelect::Update() {
 
 	ImGui::End();
 #endif
-#pragma endregion
-
-
-	worldTransform_.UpdateMatrix();
 }
 
 void StageSelect::Draw() {
@@ -214,4 +214,6 @@ void StageSelect::Finalize() {
 	delete selectBar;
 	delete buttonSprite;
 	delete stageObject_;
+	audio_->UnloadWave(selectSound_);
+	audio_->UnloadWave(decisionSound_);
 }
\ No newline at end of file
@@ -13,6 +13,7 @@ class StageSelect : public IScene {
 public:
 	void Initialize();
 	void Update();
+	void UpdateImGui();
 	void Draw();
 	void Finalize();
 
@@ -1,4 +1,5 @@
 #include "TitleScene.h"
+#include "GameTimer.h"
 #include "FadeManager.h"
 #include "Audio.h"
 #include <cmath>
@@ -28,11 +29,10 @@ void TitleScene::Initialize() {
 
 	// オーディオ初期化
 	audio_ = Audio::GetInstance();
-	titleBGM_ = audio_->LoadWave("sound/title.wav");
 	decisionSound_ = audio_->LoadWave("sound/decision.wav");
 
 	// BGM再生
-	audio_->SoundPlayWave(titleBGM_, 0.3f, true);
+	audio_->PlayMusic("sound/title.wav", 0.3f, true);
 
 	//切り替え時長押しにならないように
 	state = Input::GetInstance()->GetState();
@@ -40,7 +40,7 @@ void TitleScene::Initialize() {
 }
 
 void TitleScene::Update() {
-	const float deltaTime = 1.0f / 60.0f;
+	const float deltaTime = GameTimer::GetInstance()->GetDeltaTime();
 
 	// タイトルロゴのアニメーション
 	animationTime_ += deltaTime;
@@ -78,7 +78,7 @@ void TitleScene::Update() {
 
 	if (FadeManager::GetInstance()->IsFadeComplete() && isDecision) {
 		// BGMを停止
-		audio_->StopWave(titleBGM_);
+		audio_->StopMusic();
 		// 既にロード済みなので、直接Selectシーンに遷移
 		sceneNo = Select;
 	}
@@ -96,4 +96,6 @@ void TitleScene::Finalize() {
 	delete sprite;
 	delete backGround;
 	delete bottonSprite;
+	audio_->StopMusic();
+	audio_->UnloadWave(decisionSound_);
 }
\ No newline at end of file
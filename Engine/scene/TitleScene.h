@@ -25,7 +25,6 @@ private:
 
 	// オーディオ
 	Audio* audio_ = nullptr;
-	SoundData titleBGM_;
 	SoundData decisionSound_;
 
 	// アニメーション用
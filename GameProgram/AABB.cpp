@@ -1,4 +1,11 @@
 #include "AABB.h"
+#include <algorithm>
+
+// x86/x64ではSSE(/arch:AVXならAVX)で4個(8個)ずつ判定する
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define AABB_USE_SSE
+#include <immintrin.h>
+#endif
 
 // AABBの衝突判定
 bool IsCollisionAABB(const AABB& a, const AABB& b) {
@@ -9,3 +16,132 @@ bool IsCollisionAABB(const AABB& a, const AABB& b) {
 	}
 	return false;
 }
+
+void AABBSoA::Clear() {
+	minX.clear();
+	minY.clear();
+	minZ.clear();
+	maxX.clear();
+	maxY.clear();
+	maxZ.clear();
+}
+
+void AABBSoA::Reserve(size_t count) {
+	minX.reserve(count);
+	minY.reserve(count);
+	minZ.reserve(count);
+	maxX.reserve(count);
+	maxY.reserve(count);
+	maxZ.reserve(count);
+}
+
+void AABBSoA::Push(const AABB& box) {
+	minX.push_back(box.min.x);
+	minY.push_back(box.min.y);
+	minZ.push_back(box.min.z);
+	maxX.push_back(box.max.x);
+	maxY.push_back(box.max.y);
+	maxZ.push_back(box.max.z);
+}
+
+AABB AABBSoA::Get(size_t index) const {
+	AABB box;
+	box.min = { minX[index], minY[index], minZ[index] };
+	box.max = { maxX[index], maxY[index], maxZ[index] };
+	return box;
+}
+
+uint32_t IsCollisionAABBMaskScalar(const AABB& a, const AABBSoA& boxes, size_t begin, size_t count) {
+	count = (std::min)(count, kAABBBatchWidth);
+	uint32_t mask = 0;
+	for (size_t k = 0; k < count; ++k) {
+		size_t i = begin + k;
+		// 分岐を減らすため各軸の結果をまとめてから判定
+		bool hit = (a.min.x <= boxes.maxX[i]) & (a.max.x >= boxes.minX[i]) &
+		           (a.min.y <= boxes.maxY[i]) & (a.max.y >= boxes.minY[i]) &
+		           (a.min.z <= boxes.maxZ[i]) & (a.max.z >= boxes.minZ[i]);
+		mask |= static_cast<uint32_t>(hit) << k;
+	}
+	return mask;
+}
+
+uint32_t IsCollisionAABBMask(const AABB& a, const AABBSoA& boxes, size_t begin, size_t count) {
+#ifdef AABB_USE_SSE
+	count = (std::min)(count, kAABBBatchWidth);
+	uint32_t mask = 0;
+	size_t k = 0;
+
+#ifdef __AVX__
+	const __m256 aMinX8 = _mm256_set1_ps(a.min.x), aMaxX8 = _mm256_set1_ps(a.max.x);
+	const __m256 aMinY8 = _mm256_set1_ps(a.min.y), aMaxY8 = _mm256_set1_ps(a.max.y);
+	const __m256 aMinZ8 = _mm256_set1_ps(a.min.z), aMaxZ8 = _mm256_set1_ps(a.max.z);
+	for (; k + 8 <= count; k += 8) {
+		size_t i = begin + k;
+		__m256 hit = _mm256_and_ps(_mm256_cmp_ps(aMinX8, _mm256_loadu_ps(&boxes.maxX[i]), _CMP_LE_OQ),
+		                           _mm256_cmp_ps(aMaxX8, _mm256_loadu_ps(&boxes.minX[i]), _CMP_GE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(aMinY8, _mm256_loadu_ps(&boxes.maxY[i]), _CMP_LE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(aMaxY8, _mm256_loadu_ps(&boxes.minY[i]), _CMP_GE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(aMinZ8, _mm256_loadu_ps(&boxes.maxZ[i]), _CMP_LE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(aMaxZ8, _mm256_loadu_ps(&boxes.minZ[i]), _CMP_GE_OQ));
+		mask |= static_cast<uint32_t>(_mm256_movemask_ps(hit)) << k;
+	}
+#endif
+
+	const __m128 aMinX = _mm_set1_ps(a.min.x), aMaxX = _mm_set1_ps(a.max.x);
+	const __m128 aMinY = _mm_set1_ps(a.min.y), aMaxY = _mm_set1_ps(a.max.y);
+	const __m128 aMinZ = _mm_set1_ps(a.min.z), aMaxZ = _mm_set1_ps(a.max.z);
+	for (; k + 4 <= count; k += 4) {
+		size_t i = begin + k;
+		__m128 hit = _mm_and_ps(_mm_cmple_ps(aMinX, _mm_loadu_ps(&boxes.maxX[i])),
+		                        _mm_cmpge_ps(aMaxX, _mm_loadu_ps(&boxes.minX[i])));
+		hit = _mm_and_ps(hit, _mm_cmple_ps(aMinY, _mm_loadu_ps(&boxes.maxY[i])));
+		hit = _mm_and_ps(hit, _mm_cmpge_ps(aMaxY, _mm_loadu_ps(&boxes.minY[i])));
+		hit = _mm_and_ps(hit, _mm_cmple_ps(aMinZ, _mm_loadu_ps(&boxes.maxZ[i])));
+		hit = _mm_and_ps(hit, _mm_cmpge_ps(aMaxZ, _mm_loadu_ps(&boxes.minZ[i])));
+		mask |= static_cast<uint32_t>(_mm_movemask_ps(hit)) << k;
+	}
+
+	// 端数はスカラーで判定
+	if (k < count) {
+		mask |= IsCollisionAABBMaskScalar(a, boxes, begin + k, count - k) << k;
+	}
+	return mask;
+#else
+	return IsCollisionAABBMaskScalar(a, boxes, begin, count);
+#endif
+}
+
+namespace {
+	// ビットマスクからインデックスを書き出す
+	size_t AppendHits(uint32_t mask, size_t begin, std::vector<uint32_t>& hits) {
+		size_t added = 0;
+		while (mask) {
+			uint32_t bit = 0;
+			while (!(mask & (1u << bit))) {
+				bit++;
+			}
+			hits.push_back(static_cast<uint32_t>(begin + bit));
+			mask &= mask - 1;
+			added++;
+		}
+		return added;
+	}
+}
+
+size_t IsCollisionAABBBatch(const AABB& a, const AABBSoA& boxes, std::vector<uint32_t>& hits) {
+	size_t added = 0;
+	for (size_t begin = 0; begin < boxes.Size(); begin += kAABBBatchWidth) {
+		uint32_t mask = IsCollisionAABBMask(a, boxes, begin, boxes.Size() - begin);
+		added += AppendHits(mask, begin, hits);
+	}
+	return added;
+}
+
+size_t IsCollisionAABBBatchScalar(const AABB& a, const AABBSoA& boxes, std::vector<uint32_t>& hits) {
+	size_t added = 0;
+	for (size_t begin = 0; begin < boxes.Size(); begin += kAABBBatchWidth) {
+		uint32_t mask = IsCollisionAABBMaskScalar(a, boxes, begin, boxes.Size() - begin);
+		added += AppendHits(mask, begin, hits);
+	}
+	return added;
+}
@@ -1,4 +1,31 @@
 #pragma once
 #include "MyMath.h"
+#include <cstdint>
+#include <vector>
 
-bool IsCollisionAABB(const AABB& a, const AABB& b);
\ No newline at end of file
+bool IsCollisionAABB(const AABB& a, const AABB& b);
+
+// 複数のAABBを軸ごとの配列に並べたもの(一括判定用)
+struct AABBSoA {
+	std::vector<float> minX, minY, minZ;
+	std::vector<float> maxX, maxY, maxZ;
+
+	void Clear();
+	void Reserve(size_t count);
+	void Push(const AABB& box);
+	AABB Get(size_t index) const;
+	size_t Size() const { return minX.size(); }
+};
+
+// 一括判定でまとめて調べられる最大数(ビットマスクの幅)
+const size_t kAABBBatchWidth = 32;
+
+// aとboxes[begin]から最大kAABBBatchWidth個を判定し、重なった箱をビットで返す
+uint32_t IsCollisionAABBMask(const AABB& a, const AABBSoA& boxes, size_t begin, size_t count);
+
+// aと全てのboxesを判定し、重なった箱のインデックスをhitsに追加する(戻り値は追加した数)
+size_t IsCollisionAABBBatch(const AABB& a, const AABBSoA& boxes, std::vector<uint32_t>& hits);
+
+// SIMDを使わない版(比較・フォールバック用)
+uint32_t IsCollisionAABBMaskScalar(const AABB& a, const AABBSoA& boxes, size_t begin, size_t count);
+size_t IsCollisionAABBBatchScalar(const AABB& a, const AABBSoA& boxes, std::vector<uint32_t>& hits);
@@ -1,7 +1,8 @@
 #include "CameraController.h"
+#include "GameTimer.h"
+#include "GameRandom.h"
 #include "ImGuiManager.h"
 #include "Player.h"
-#include <random>
 
 CameraController::CameraController() : offset_{0.0f, 5.0f, -20.0f}, pitchDeg_(10.0f) {}
 
@@ -62,14 +63,6 @@ void CameraController::Update(Camera* camera, const Vector3& playerPosition) {
 	cameraTransofrm_.y += shakeOffset_.y;
 	cameraTransofrm_.z += shakeOffset_.z;
 
-#ifdef _DEBUG
-	ImGui::Begin("camera");
-	ImGui::DragFloat3("cameraTranslate",  &cameraTransofrm_.x);
-	ImGui::DragFloat3("cameraRotate", &cameraRotate_.x);
-	ImGui::DragFloat3("offset", &offset_.x);
-	ImGui::End();
-#endif
-
 	// カメラ行列の更新と転送
 
 	camera->SetRotate(cameraRotate_);
@@ -79,6 +72,16 @@ void CameraController::Update(Camera* camera, const Vector3& playerPosition) {
 	//camera->TransferMatrix();
 }
 
+void CameraController::UpdateImGui() {
+#ifdef USE_IMGUI
+	ImGui::Begin("camera");
+	ImGui::DragFloat3("cameraTranslate",  &cameraTransofrm_.x);
+	ImGui::DragFloat3("cameraRotate", &cameraRotate_.x);
+	ImGui::DragFloat3("offset", &offset_.x);
+	ImGui::End();
+#endif
+}
+
 void CameraController::StartShake(float intensity, float duration) {
 	shakeIntensity_ = intensity;
 	shakeDuration_ = duration;
@@ -87,18 +90,16 @@ void CameraController::StartShake(float intensity, float duration) {
 void CameraController::UpdateShake() {
 	if (shakeDuration_ > 0) {
 		// ランダムなシェイクを生成
-		static std::random_device rd;
-		static std::mt19937 gen(rd());
-		std::uniform_real_distribution<> dis(-1.0, 1.0);
+		GameRandom* random = GameRandom::GetInstance();
 
 		// 時間経過で弱まるシェイク
 		float currentIntensity = shakeIntensity_ * (shakeDuration_ / 0.5f); // 0.5秒で完全に減衰
 
-		shakeOffset_.x = static_cast<float>(dis(gen)) * currentIntensity;
-		shakeOffset_.y = static_cast<float>(dis(gen)) * currentIntensity;
-		shakeOffset_.z = static_cast<float>(dis(gen)) * currentIntensity * 0.5f; // Z軸は控えめに
+		shakeOffset_.x = random->NextFloat(-1.0f, 1.0f) * currentIntensity;
+		shakeOffset_.y = random->NextFloat(-1.0f, 1.0f) * currentIntensity;
+		shakeOffset_.z = random->NextFloat(-1.0f, 1.0f) * currentIntensity * 0.5f; // Z軸は控えめに
 
-		shakeDuration_ -= 1.0f / 60.0f; // deltaTime
+		shakeDuration_ -= GameTimer::GetInstance()->GetDeltaTime();
 	}
 	else {
 		shakeOffset_ = {0.0f, 0.0f, 0.0f};
@@ -11,6 +11,9 @@ public:
 	// プレイヤーの位置に基づいてカメラを更新します
 	void Update(Camera* camera, const Vector3& playerPosition);
 
+	// デバッグ表示(描画1回につき1回)
+	void UpdateImGui();
+
 	// カメラのオフセット（プレイヤーからの相対位置）を設定します
 	void SetOffset(const Vector3& offset);
 
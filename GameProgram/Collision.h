@@ -2,6 +2,7 @@
 #include "AABB.h"
 #include "math/Vector3.h"
 #include <cmath>
+#include <utility>
 
 // 各軸の重なり量を計算する関数
 inline Vector3 GetOverlapAmount(const AABB& a, const AABB& b) {
@@ -51,3 +52,106 @@ inline void ResolveAABBCollision(AABB& playerAABB, const AABB& obstacleAABB, flo
 		playerAABB.max.z += push;
 	}
 }
+
+// 動くAABBの衝突時刻を求める(スイープ)
+// movingをdeltaだけ動かしたとき、0～1のどこでobstacleに触れるかをtimeに、触れた面の法線をnormalに入れる
+// 始めから重なっている場合はfalseを返すので、ResolveAABBCollisionで押し戻す
+inline bool SweepAABB(const AABB& moving, const Vector3& delta, const AABB& obstacle, float& time, Vector3& normal) {
+	float tEnter = -1.0f;
+	float tExit = 2.0f;
+	Vector3 enterNormal = { 0.0f, 0.0f, 0.0f };
+
+	// 1軸分の進入・離脱時刻
+	auto axis = [&](float d, float movingMin, float movingMax, float obstacleMin, float obstacleMax, const Vector3& axisNormal) {
+		if (d == 0.0f) {
+			// 動かない軸は接しているだけなら当たらない
+			return movingMin < obstacleMax && movingMax > obstacleMin;
+		}
+		float enter, exit;
+		float sign;
+		if (d > 0.0f) {
+			enter = (obstacleMin - movingMax) / d;
+			exit = (obstacleMax - movingMin) / d;
+			sign = -1.0f;
+		} else {
+			enter = (obstacleMax - movingMin) / d;
+			exit = (obstacleMin - movingMax) / d;
+			sign = 1.0f;
+		}
+		if (enter > tEnter) {
+			tEnter = enter;
+			enterNormal = { axisNormal.x * sign, axisNormal.y * sign, axisNormal.z * sign };
+		}
+		if (exit < tExit) {
+			tExit = exit;
+		}
+		return true;
+	};
+
+	if (!axis(delta.x, moving.min.x, moving.max.x, obstacle.min.x, obstacle.max.x, { 1.0f, 0.0f, 0.0f }) ||
+	    !axis(delta.y, moving.min.y, moving.max.y, obstacle.min.y, obstacle.max.y, { 0.0f, 1.0f, 0.0f }) ||
+	    !axis(delta.z, moving.min.z, moving.max.z, obstacle.min.z, obstacle.max.z, { 0.0f, 0.0f, 1.0f })) {
+		return false;
+	}
+
+	// 始めから重なっている、離れていく、今回の移動では届かない
+	if (tEnter < 0.0f || tEnter >= tExit || tEnter > 1.0f) {
+		return false;
+	}
+
+	time = tEnter;
+	normal = enterNormal;
+	return true;
+}
+
+// 動くAABBの位置を移動量のtime分だけ進める
+inline void TranslateAABB(AABB& box, const Vector3& delta, float time) {
+	box.min.x += delta.x * time;
+	box.min.y += delta.y * time;
+	box.min.z += delta.z * time;
+	box.max.x += delta.x * time;
+	box.max.y += delta.y * time;
+	box.max.z += delta.z * time;
+}
+
+// 線分(origin → origin + delta)とAABBの交差判定(スラブ法)
+// 当たった場合はtimeに0～1の割合、normalに入った面の法線を入れる(始点が内側なら法線は0)
+inline bool IntersectSegmentAABB(const Vector3& origin, const Vector3& delta, const AABB& box, float& time, Vector3& normal) {
+	float tEnter = 0.0f;
+	float tExit = 1.0f;
+	Vector3 enterNormal = { 0.0f, 0.0f, 0.0f };
+
+	// 1軸分のスラブを調べる
+	auto slab = [&](float o, float d, float boxMin, float boxMax, const Vector3& axis) {
+		if (std::fabs(d) < 1e-8f) {
+			// 軸に平行なら内側にいるかだけ
+			return o >= boxMin && o <= boxMax;
+		}
+		float inv = 1.0f / d;
+		float t0 = (boxMin - o) * inv;
+		float t1 = (boxMax - o) * inv;
+		float sign = -1.0f;
+		if (t0 > t1) {
+			std::swap(t0, t1);
+			sign = 1.0f;
+		}
+		if (t0 > tEnter) {
+			tEnter = t0;
+			enterNormal = { axis.x * sign, axis.y * sign, axis.z * sign };
+		}
+		if (t1 < tExit) {
+			tExit = t1;
+		}
+		return tEnter <= tExit;
+	};
+
+	if (!slab(origin.x, delta.x, box.min.x, box.max.x, { 1.0f, 0.0f, 0.0f }) ||
+	    !slab(origin.y, delta.y, box.min.y, box.max.y, { 0.0f, 1.0f, 0.0f }) ||
+	    !slab(origin.z, delta.z, box.min.z, box.max.z, { 0.0f, 0.0f, 1.0f })) {
+		return false;
+	}
+
+	time = tEnter;
+	normal = enterNormal;
+	return true;
+}
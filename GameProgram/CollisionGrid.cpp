@@ -0,0 +1,140 @@
+#include "CollisionGrid.h"
+#include <algorithm>
+#include <cmath>
+
+void CollisionGrid::Build(std::vector<AABB> boxes, float cellSize) {
+	Clear();
+	boxes_ = std::move(boxes);
+	if (boxes_.empty()) {
+		return;
+	}
+
+	// 全体の範囲を求める
+	float minX = boxes_[0].min.x, maxX = boxes_[0].max.x;
+	float minZ = boxes_[0].min.z, maxZ = boxes_[0].max.z;
+	for (const AABB& box : boxes_) {
+		minX = (std::min)(minX, box.min.x);
+		maxX = (std::max)(maxX, box.max.x);
+		minZ = (std::min)(minZ, box.min.z);
+		maxZ = (std::max)(maxZ, box.max.z);
+	}
+
+	// セル数が多くなりすぎないようにセルサイズを広げる
+	float width = (std::max)(maxX - minX, maxZ - minZ);
+	if (width / cellSize > static_cast<float>(kMaxCellsPerAxis)) {
+		cellSize = width / static_cast<float>(kMaxCellsPerAxis);
+	}
+
+	originX_ = minX;
+	originZ_ = minZ;
+	invCellSize_ = 1.0f / cellSize;
+	sizeX_ = (std::clamp)(static_cast<int>(std::ceil((maxX - minX) * invCellSize_)), 1, kMaxCellsPerAxis);
+	sizeZ_ = (std::clamp)(static_cast<int>(std::ceil((maxZ - minZ) * invCellSize_)), 1, kMaxCellsPerAxis);
+
+	// 1パス目：セルごとの個数を数える
+	cellStart_.assign(GetCellCount() + 1, 0);
+	for (uint32_t i = 0; i < boxes_.size(); ++i) {
+		int x0, z0, x1, z1;
+		GetCellRange(boxes_[i], x0, z0, x1, z1);
+		if ((x1 - x0 + 1) * (z1 - z0 + 1) > kLargeBoxCells) {
+			largeItems_.push_back(i);
+			continue;
+		}
+		for (int z = z0; z <= z1; ++z) {
+			for (int x = x0; x <= x1; ++x) {
+				cellStart_[z * sizeX_ + x + 1]++;
+			}
+		}
+	}
+	for (size_t c = 1; c < cellStart_.size(); ++c) {
+		cellStart_[c] += cellStart_[c - 1];
+	}
+
+	// 2パス目：インデックスを詰める
+	cellItems_.resize(cellStart_.back());
+	std::vector<uint32_t> cursor(cellStart_.begin(), cellStart_.end() - 1);
+	size_t large = 0;
+	for (uint32_t i = 0; i < boxes_.size(); ++i) {
+		if (large < largeItems_.size() && largeItems_[large] == i) {
+			large++;
+			continue;
+		}
+		int x0, z0, x1, z1;
+		GetCellRange(boxes_[i], x0, z0, x1, z1);
+		for (int z = z0; z <= z1; ++z) {
+			for (int x = x0; x <= x1; ++x) {
+				cellItems_[cursor[z * sizeX_ + x]++] = i;
+			}
+		}
+	}
+
+	// 一括判定用に箱を並べ直す
+	cellBoxes_.Reserve(cellItems_.size());
+	for (uint32_t index : cellItems_) {
+		cellBoxes_.Push(boxes_[index]);
+	}
+	largeBoxes_.Reserve(largeItems_.size());
+	for (uint32_t index : largeItems_) {
+		largeBoxes_.Push(boxes_[index]);
+	}
+}
+
+void CollisionGrid::Clear() {
+	boxes_.clear();
+	cellStart_.clear();
+	cellItems_.clear();
+	largeItems_.clear();
+	cellBoxes_.Clear();
+	largeBoxes_.Clear();
+	sizeX_ = 0;
+	sizeZ_ = 0;
+}
+
+void CollisionGrid::Query(const AABB& area, std::vector<uint32_t>& out) const {
+	out.clear();
+
+	int x0, z0, x1, z1;
+	if (GetCellRange(area, x0, z0, x1, z1)) {
+		for (int z = z0; z <= z1; ++z) {
+			for (int x = x0; x <= x1; ++x) {
+				int cell = z * sizeX_ + x;
+				out.insert(out.end(), cellItems_.begin() + cellStart_[cell], cellItems_.begin() + cellStart_[cell + 1]);
+			}
+		}
+	}
+	out.insert(out.end(), largeItems_.begin(), largeItems_.end());
+
+	// 複数セルにまたがる箱の重複を除く(元のリスト順を保つため昇順)
+	std::sort(out.begin(), out.end());
+	out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+void CollisionGrid::Query(const AABB& area, std::vector<uint32_t>& indices, std::vector<AABB>& outBoxes) const {
+	Query(area, indices);
+	outBoxes.clear();
+	for (uint32_t i : indices) {
+		outBoxes.push_back(boxes_[i]);
+	}
+}
+
+bool CollisionGrid::GetCellRange(const AABB& area, int& x0, int& z0, int& x1, int& z1) const {
+	if (sizeX_ == 0 || sizeZ_ == 0) {
+		return false;
+	}
+
+	float fx0 = (area.min.x - originX_) * invCellSize_;
+	float fx1 = (area.max.x - originX_) * invCellSize_;
+	float fz0 = (area.min.z - originZ_) * invCellSize_;
+	float fz1 = (area.max.z - originZ_) * invCellSize_;
+
+	// グリッドの外側
+	if (fx1 < 0.0f || fz1 < 0.0f || fx0 > static_cast<float>(sizeX_) || fz0 > static_cast<float>(sizeZ_)) {
+		return false;
+	}
+
+	x0 = (std::clamp)(static_cast<int>(std::floor(fx0)), 0, sizeX_ - 1);
+	x1 = (std::clamp)(static_cast<int>(std::floor(fx1)), 0, sizeX_ - 1);
+	z0 = (std::clamp)(static_cast<int>(std::floor(fz0)), 0, sizeZ_ - 1);
+	z1 = (std::clamp)(static_cast<int>(std::floor(fz1)), 0, sizeZ_ - 1);
+	return true;
+}
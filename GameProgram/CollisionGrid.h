@@ -0,0 +1,108 @@
+#pragma once
+#include "MyMath.h"
+#include "AABB.h"
+#include <cstdint>
+#include <vector>
+
+// ステージ障害物用のブロードフェーズ(XZ平面の一様グリッド)
+// ステージ読み込み時に一度だけ構築し、以降は近くの箱だけを調べる
+class CollisionGrid {
+public:
+	// 障害物リストからグリッドを構築
+	void Build(std::vector<AABB> boxes, float cellSize = 8.0f);
+
+	void Clear();
+
+	// areaと重なる可能性のある障害物のインデックスを昇順でoutに書き出す
+	void Query(const AABB& area, std::vector<uint32_t>& out) const;
+	// インデックスと一緒に箱そのものも書き出す(反復解決のループ用)
+	void Query(const AABB& area, std::vector<uint32_t>& indices, std::vector<AABB>& outBoxes) const;
+
+	// areaが掛かるセルの箱を順に渡す(重複あり、確保なし)
+	template<typename Func>
+	void ForEachCandidate(const AABB& area, Func&& func) const;
+
+	// areaと実際に重なる箱だけを順に渡す(セル単位で一括判定、重複あり)
+	template<typename Func>
+	void ForEachOverlap(const AABB& area, Func&& func) const;
+
+	const AABB& GetBox(uint32_t index) const { return boxes_[index]; }
+	const std::vector<AABB>& GetBoxes() const { return boxes_; }
+	size_t GetBoxCount() const { return boxes_.size(); }
+	size_t GetCellCount() const { return static_cast<size_t>(sizeX_) * sizeZ_; }
+	bool IsEmpty() const { return boxes_.empty(); }
+
+private:
+	// areaが掛かるセル範囲を求める(範囲外ならfalse)
+	bool GetCellRange(const AABB& area, int& x0, int& z0, int& x1, int& z1) const;
+
+	// 1辺あたりのセル数の上限
+	static constexpr int kMaxCellsPerAxis = 256;
+	// これ以上のセルにまたがる箱は常に候補に入れる
+	static const int kLargeBoxCells = 64;
+
+	std::vector<AABB> boxes_;
+
+	// セルごとの箱インデックス(cellStart_[i]からcellStart_[i + 1]まで)
+	std::vector<uint32_t> cellStart_;
+	std::vector<uint32_t> cellItems_;
+	// cellItems_と同じ並びの箱(一括判定用)
+	AABBSoA cellBoxes_;
+
+	// 地面など大きな箱
+	std::vector<uint32_t> largeItems_;
+	AABBSoA largeBoxes_;
+
+	float originX_ = 0.0f;
+	float originZ_ = 0.0f;
+	float invCellSize_ = 1.0f;
+	int sizeX_ = 0;
+	int sizeZ_ = 0;
+};
+
+template<typename Func>
+void CollisionGrid::ForEachCandidate(const AABB& area, Func&& func) const {
+	int x0, z0, x1, z1;
+	if (GetCellRange(area, x0, z0, x1, z1)) {
+		for (int z = z0; z <= z1; ++z) {
+			for (int x = x0; x <= x1; ++x) {
+				int cell = z * sizeX_ + x;
+				for (uint32_t i = cellStart_[cell]; i < cellStart_[cell + 1]; ++i) {
+					func(cellItems_[i]);
+				}
+			}
+		}
+	}
+	for (uint32_t index : largeItems_) {
+		func(index);
+	}
+}
+
+template<typename Func>
+void CollisionGrid::ForEachOverlap(const AABB& area, Func&& func) const {
+	// 範囲内の箱をkAABBBatchWidth個ずつ判定して、当たったものだけ渡す
+	auto visit = [&](const AABBSoA& soa, const std::vector<uint32_t>& items, uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; i += static_cast<uint32_t>(kAABBBatchWidth)) {
+			uint32_t mask = IsCollisionAABBMask(area, soa, i, end - i);
+			while (mask) {
+				uint32_t bit = 0;
+				while (!(mask & (1u << bit))) {
+					bit++;
+				}
+				func(items[i + bit]);
+				mask &= mask - 1;
+			}
+		}
+	};
+
+	int x0, z0, x1, z1;
+	if (GetCellRange(area, x0, z0, x1, z1)) {
+		for (int z = z0; z <= z1; ++z) {
+			for (int x = x0; x <= x1; ++x) {
+				int cell = z * sizeX_ + x;
+				visit(cellBoxes_, cellItems_, cellStart_[cell], cellStart_[cell + 1]);
+			}
+		}
+	}
+	visit(largeBoxes_, largeItems_, 0, static_cast<uint32_t>(largeItems_.size()));
+}
@@ -0,0 +1,90 @@
+#include "CollisionWorld.h"
+#include "Collision.h"
+#include <algorithm>
+
+namespace {
+	// 線分が通る範囲のAABB
+	AABB MakeSegmentBounds(const AABB& box, const Vector3& delta) {
+		AABB bounds = box;
+		bounds.min.x += (std::min)(delta.x, 0.0f);
+		bounds.min.y += (std::min)(delta.y, 0.0f);
+		bounds.min.z += (std::min)(delta.z, 0.0f);
+		bounds.max.x += (std::max)(delta.x, 0.0f);
+		bounds.max.y += (std::max)(delta.y, 0.0f);
+		bounds.max.z += (std::max)(delta.z, 0.0f);
+		return bounds;
+	}
+}
+
+void CollisionWorld::Build(std::vector<AABB> boxes) {
+	grid_.Build(std::move(boxes));
+}
+
+void CollisionWorld::Clear() {
+	grid_.Clear();
+}
+
+bool CollisionWorld::Overlaps(const AABB& area) const {
+	bool hit = false;
+	grid_.ForEachOverlap(area, [&](uint32_t) {
+		hit = true;
+	});
+	return hit;
+}
+
+void CollisionWorld::QueryOverlap(const AABB& area, std::vector<uint32_t>& out) const {
+	out.clear();
+	grid_.ForEachOverlap(area, [&](uint32_t index) {
+		out.push_back(index);
+	});
+
+	// 複数セルにまたがる箱の重複を除く
+	std::sort(out.begin(), out.end());
+	out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+void CollisionWorld::QueryOverlap(const AABB& area, std::vector<uint32_t>& indices, std::vector<AABB>& outBoxes) const {
+	QueryOverlap(area, indices);
+	outBoxes.clear();
+	for (uint32_t index : indices) {
+		outBoxes.push_back(grid_.GetBox(index));
+	}
+}
+
+bool CollisionWorld::RayCast(const Vector3& origin, const Vector3& delta, CollisionHit& hit) const {
+	AABB bounds = MakeSegmentBounds({ origin, origin }, delta);
+
+	bool found = false;
+	grid_.ForEachCandidate(bounds, [&](uint32_t index) {
+		float time;
+		Vector3 normal;
+		if (IntersectSegmentAABB(origin, delta, grid_.GetBox(index), time, normal)) {
+			if (!found || time < hit.time) {
+				hit.time = time;
+				hit.normal = normal;
+				hit.index = index;
+				found = true;
+			}
+		}
+	});
+	return found;
+}
+
+bool CollisionWorld::Sweep(const AABB& box, const Vector3& delta, CollisionHit& hit) const {
+	AABB bounds = MakeSegmentBounds(box, delta);
+
+	bool found = false;
+	grid_.ForEachCandidate(bounds, [&](uint32_t index) {
+		float time;
+		Vector3 normal;
+		if (SweepAABB(box, delta, grid_.GetBox(index), time, normal)) {
+			if (!found || time < hit.time) {
+				hit.time = time;
+				hit.normal = normal;
+				hit.index = index;
+				found = true;
+			}
+		}
+	});
+	return found;
+}
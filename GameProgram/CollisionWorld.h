@@ -0,0 +1,44 @@
+#pragma once
+#include "MyMath.h"
+#include "CollisionGrid.h"
+#include <cstdint>
+#include <vector>
+
+// レイキャスト・スイープの結果
+struct CollisionHit {
+	float time = 1.0f;                    // 移動量に対する割合(0～1)
+	Vector3 normal = { 0.0f, 0.0f, 0.0f }; // 当たった面の法線
+	uint32_t index = 0;                   // 当たった障害物のインデックス
+};
+
+// ステージの当たり判定をまとめたもの
+// シーンが1つだけ持ち、構築後は変更しない。各エンティティはポインタだけを持つ
+class CollisionWorld {
+public:
+	// ステージの障害物から構築
+	void Build(std::vector<AABB> boxes);
+	void Clear();
+
+	// areaと重なる障害物があるか
+	bool Overlaps(const AABB& area) const;
+
+	// areaと重なる障害物のインデックスを昇順でoutに書き出す
+	void QueryOverlap(const AABB& area, std::vector<uint32_t>& out) const;
+	// インデックスと一緒に箱そのものも書き出す(反復解決のループ用)
+	void QueryOverlap(const AABB& area, std::vector<uint32_t>& indices, std::vector<AABB>& outBoxes) const;
+
+	// 線分(origin → origin + delta)で最初に当たる障害物
+	bool RayCast(const Vector3& origin, const Vector3& delta, CollisionHit& hit) const;
+
+	// boxをdeltaだけ動かしたときに最初に当たる障害物(始めから重なっている箱は無視)
+	bool Sweep(const AABB& box, const Vector3& delta, CollisionHit& hit) const;
+
+	const AABB& GetBox(uint32_t index) const { return grid_.GetBox(index); }
+	const std::vector<AABB>& GetBoxes() const { return grid_.GetBoxes(); }
+	size_t GetBoxCount() const { return grid_.GetBoxCount(); }
+	const CollisionGrid& GetGrid() const { return grid_; }
+	bool IsEmpty() const { return grid_.IsEmpty(); }
+
+private:
+	CollisionGrid grid_;
+};
@@ -1,4 +1,5 @@
 #include "Bom.h"
+#include "GameTimer.h"
 #include "ParticleManager.h"
 
 Bom::Bom() {
@@ -11,6 +12,12 @@ Bom::Bom() {
 	particleExplosion_->Initialize("resource/Sprite/circle.png");
 	particleExplosion_->ChangeMode(BornParticle::Stop);
 	particleExplosion_->ChangeType(ParticleType::Plane);
+
+	worldTransform_.Initialize();
+	// "cube" モデルを読み込み
+	model_ = new Object3d();
+	model_->Initialize();
+	model_->SetModelFile("EnemyBullet");
 }
 
 Bom::~Bom() { 
@@ -24,18 +31,24 @@ Bom::~Bom() {
 }
 
 void Bom::Init(Vector3 position, Vector3 velocity) {
-	worldTransform_.Initialize();
-	// "cube" モデルを読み込み
-	model_ = new Object3d();
-	model_->Initialize();
-	model_->SetModelFile("EnemyBullet");
 	position_ = position;
 	worldTransform_.translation_ = position_;
+	worldTransform_.UpdateMatrix();
 
 	velocity_ = velocity;
+	deadTimer = 3.0f;
+	onGround_ = true;
+	isDead = false;
+	isVisible = true;
 }
 
 void Bom::Update() { 
+	// 弾が消えた後は爆発だけ進める
+	if (isDead) {
+		particleExplosion_->Update();
+		return;
+	}
+
 	//プレイヤーが真上の時出さなくする
 	if (velocity_.x == 0.0f && velocity_.z == 0.0f) {
 		isDead = true;
@@ -47,8 +60,27 @@ void Bom::Update() {
 		isVisible = false;
 		return;
 	}
-	position_.x += velocity_.x;
-	position_.z += velocity_.z;	
+	// 移動量をスイープして、壁に当たったらその位置で爆発させる
+	Vector3 move = { velocity_.x, 0.0f, velocity_.z };
+	CollisionHit hit;
+	if (!collisionWorld_) {
+		position_.x += move.x;
+		position_.z += move.z;
+	}
+	else if (collisionWorld_->Overlaps(GetAABB())) {
+		// 既に埋まっている
+		OnCollision();
+	}
+	else if (collisionWorld_->Sweep(GetAABB(), move, hit)) {
+		position_.x += move.x * hit.time;
+		position_.z += move.z * hit.time;
+		worldTransform_.translation_ = position_;
+		OnCollision();
+	}
+	else {
+		position_.x += move.x;
+		position_.z += move.z;
+	}
 	
 	worldTransform_.translation_ = position_;
 
@@ -57,7 +89,7 @@ void Bom::Update() {
 	// パーティクル更新
 	particleExplosion_->Update();
 
-	deadTimer -= 1.0f / 60.0f;
+	deadTimer -= GameTimer::GetInstance()->GetDeltaTime();
 
 	if (deadTimer < 0) {
 		isDead = true;
@@ -107,6 +139,15 @@ void Bom::OnCollision() {
 	particleExplosion_->ChangeMode(BornParticle::MomentMode);
 }
 
+void Bom::Deactivate() {
+	isDead = true;
+	// 音を止める
+	if (soundData_ != nullptr) {
+		audio_->StopWave(*soundData_);
+	}
+	isVisible = false;
+}
+
 void Bom::SetSoundData(SoundData* soundData) {
 	soundData_ = soundData;
 }
\ No newline at end of file
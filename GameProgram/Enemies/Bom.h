@@ -2,24 +2,35 @@
 #include "WorldTransform.h"
 #include "Object3d.h"
 #include "AABB.h"
-#include "collision.h"
+#include "Collision.h"
+#include "CollisionWorld.h"
 #include "Particle.h"
-#include "Mymath.h"
+#include "MyMath.h"
 #include "Audio.h"
 
+// 大砲の弾。CannonEnemyがステージ読み込み時にまとめて作り、発射のたびにInitで使い回す
 class Bom {
 public:
+	// モデルと爆発パーティクルはここで作る
 	Bom();
 	~Bom();
+	// 発射(状態だけを初期化する)
 	void Init(Vector3 position, Vector3 velocity);
 	void Update();
 	void Draw();
 	void DrawP(); // パーティクル描画
 	bool IsDaed() { return isDead; }
+	// 弾も爆発も終わっていて使い回せる
+	bool IsFinished() const { return isDead && !particleExplosion_->IsPlaying(); }
+	// 爆発させずに消す
+	void Deactivate();
 
 	AABB GetAABB();
 	void OnCollision();
 
+	// ステージとの当たり判定(移動をスイープして壁抜けを防ぐ)
+	void SetCollisionWorld(const CollisionWorld* world) { collisionWorld_ = world; }
+
 	// サウンド関連の追加メソッド
 	void SetSoundData(SoundData* soundData);
 	Audio* GetAudio() const { return audio_; }
@@ -37,10 +48,12 @@ private:
 	SoundData* soundData_ = nullptr; // 再生中のサウンドデータへのポインタ
 
 	Vector3 velocity_;
+	const CollisionWorld* collisionWorld_ = nullptr;
 	float deadTimer = 3.0f;
-	bool isDead = false;
+	// 発射されるまでは使われていない扱い
+	bool isDead = true;
 	// 表示フラグを追加
-	bool isVisible = true;
+	bool isVisible = false;
 
 	// パーティクル
 	Particle* particleExplosion_ = nullptr;
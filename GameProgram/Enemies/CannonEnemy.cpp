@@ -1,4 +1,5 @@
 #include "CannonEnemy.h"
+#include "GameTimer.h"
 #include "Bom.h"
 #include "Player.h"
 #include "ImGuiManager.h"
@@ -11,10 +12,11 @@ CannonEnemy::CannonEnemy() {}
 
 CannonEnemy::~CannonEnemy() {
 	delete model_;
-	for (Bom* bom : bullets_) {
+	for (Bom* bom : bulletPool_) {
 		delete bom;
 	}
 	delete particleMove_;
+	Audio::GetInstance()->UnloadSE(bomSound_);
 }
 
 void CannonEnemy::Init() {
@@ -27,26 +29,25 @@ void CannonEnemy::Init() {
 	particleMove_->Initialize("resource/Sprite/circle.png");
 	particleMove_->ChangeMode(BornParticle::Stop);
 
+	// 弾を先に作っておく(発射中はモデルやパーティクルを作らない)
+	bulletPool_.reserve(kMaxBullets);
+	bullets_.reserve(kMaxBullets);
+	for (int i = 0; i < kMaxBullets; i++) {
+		bulletPool_.push_back(new Bom());
+	}
+
 	worldTransform_.translation_ = position;
 
 	// オーディオシングルトン取得
 	audio_ = Audio::GetInstance();
 
-	// 爆発音の複数バッファを初期化（同時再生用）
-	for (int i = 0; i < MAX_BOM_SOUNDS; i++) {
-		bomSounds_[i] = audio_->LoadWave("sound/bom.wav");
-	}
-	currentBomSoundIndex_ = 0;
+	bomSound_ = audio_->LoadSE("sound/bom.wav");
 }
 
-void CannonEnemy::SetObstacleList(const std::vector<AABB>& obstacles) { obstacleList_.insert(obstacleList_.end(), obstacles.begin(), obstacles.end()); }
-
-void CannonEnemy::AddObstacle(const AABB& obstacle) { obstacleList_.push_back(obstacle); }
-
 void CannonEnemy::Update() {
 
 	// 入力による移動
-	const float deltaTime = 1.0f / 60.0f;
+	const float deltaTime = GameTimer::GetInstance()->GetDeltaTime();
 
 	// スタン状態の処理
 	if (isStan) {
@@ -57,17 +58,6 @@ void CannonEnemy::Update() {
 		}
 	}
 
-	// 弾とステージの衝突チェック
-	for (auto& obstacleAABB : obstacleList_) {
-		for (Bom* bullet : bullets_) {
-			AABB bulletAABB = bullet->GetAABB();
-			if (IsCollisionAABB(bulletAABB, obstacleAABB)) {
-				bullet->OnCollision();
-			}
-		}
-	}
-
-
 	if (!isPlayer) {
 		// 重力処理
 		float gravity = 0.01f;
@@ -80,13 +70,20 @@ void CannonEnemy::Update() {
 		enemyAABB.min = { position.x - halfW, position.y - halfH, position.z - halfD };
 		enemyAABB.max = { position.x + halfW, position.y + halfH, position.z + halfD };
 
+		// 近くの障害物だけを調べる
+		nearObstacles_.clear();
+		if (collisionWorld_) {
+			const float margin = 2.0f;
+			collisionWorld_->QueryOverlap({ enemyAABB.min - margin, enemyAABB.max + margin }, nearIndices_, nearObstacles_);
+		}
+
 		// 衝突解決
 		const int maxIterations = 10;
 		int iterations = 0;
 		bool collisionOccurred = false;
 		do {
 			collisionOccurred = false;
-			for (auto& obstacleAABB : obstacleList_) {
+			for (auto& obstacleAABB : nearObstacles_) {
 				if (IsCollisionAABB(enemyAABB, obstacleAABB)) {
 					ResolveAABBCollision(enemyAABB, obstacleAABB, velocityY_, onGround_);
 					collisionOccurred = true;
@@ -165,7 +162,23 @@ void CannonEnemy::Update() {
 		worldTransform_.translation_ = position;
 	}
 
-#ifdef _DEBUG
+	// 弾の更新(消えた弾も爆発が終わるまで動かす)
+	for (Bom* bom : bulletPool_) {
+		if (!bom->IsFinished()) {
+			bom->Update();
+		}
+	}
+
+	// 消えた弾を飛んでいる弾から外す
+	std::erase_if(bullets_, [](Bom* bom) {
+		return bom->IsDaed();
+		});
+	particleMove_->Update();
+	worldTransform_.UpdateMatrix();
+}
+
+void CannonEnemy::UpdateImGui() {
+#ifdef USE_IMGUI
 	ImGui::Begin("Cannon Enemy");
 	ImGui::DragFloat3("Position", &position.x);
 	ImGui::DragFloat("Attack Radius", &attackRadius, 1.0f, 0.0f, 100.0f);
@@ -173,22 +186,6 @@ void CannonEnemy::Update() {
 	ImGui::Text("Fire Timer: %.1f", fireTimer);
 	ImGui::End();
 #endif
-
-	// 弾の更新
-	for (Bom* bom : bullets_) {
-		bom->Update();
-	}
-
-	// 使用済み弾の削除
-	bullets_.remove_if([](Bom* bom) {
-		if (bom->IsDaed()) {
-			delete bom;
-			return true;
-		}
-		return false;
-		});
-	particleMove_->Update();
-	worldTransform_.UpdateMatrix();
 }
 
 void CannonEnemy::Draw() {
@@ -203,13 +200,15 @@ void CannonEnemy::DrawP() {
 	particleMove_->Draw();
 
 	// 弾のパーティクルも描画
-	for (Bom* bom : bullets_) {
-		bom->DrawP();
+	for (Bom* bom : bulletPool_) {
+		if (!bom->IsFinished()) {
+			bom->DrawP();
+		}
 	}
 }
 
 void CannonEnemy::Fire() {
-	const float deltaTimer = 1.0f / 60.0f;
+	const float deltaTimer = GameTimer::GetInstance()->GetDeltaTime();
 	fireTimer -= deltaTimer;
 	animertion += deltaTimer;
 
@@ -238,18 +237,15 @@ void CannonEnemy::Fire() {
 		// 速度ベクトルをプレイヤーの方向に設定
 		Vector3 velocity = normalizedDirection * kSpeed;
 
-		// 新しい弾を生成
-		Bom* newBullet = new Bom();
+		// 空いている弾を使う
+		Bom* newBullet = AcquireBullet();
 		newBullet->Init(enemyPosition, velocity);
+		newBullet->SetCollisionWorld(collisionWorld_);
 
 		bullets_.push_back(newBullet);
 
-		// 発射音を再生（複数バッファを順番に使用）（音量を小さく調整）
-		audio_->SoundPlayWave(bomSounds_[currentBomSoundIndex_], 0.4f, false);
-
-
-		// 次のサウンドバッファに進む
-		currentBomSoundIndex_ = (currentBomSoundIndex_ + 1) % MAX_BOM_SOUNDS;
+		// 発射音を再生（音量を小さく調整）。遠くの大砲ほど他の音に譲る
+		audio_->PlaySE3D(bomSound_, 0.4f, 0, enemyPosition);
 
 		// 次の発射までのクールダウンを設定（3秒に延長）
 		fireTimer = fireInterval;
@@ -271,18 +267,28 @@ void CannonEnemy::PlayerFire() {
 	Vector3 playerPosition = player_->GetWorldPosition();
 	playerPosition += TransformNormal({ 0,0,2 }, worldTransform_.matWorld_);
 
-	Bom* newBullet = new Bom();
+	Bom* newBullet = AcquireBullet();
 	newBullet->Init(playerPosition, velocity);
+	newBullet->SetCollisionWorld(collisionWorld_);
 
 	bullets_.push_back(newBullet);
 
-	// 発射音を再生
-	audio_->StopWave(bomSounds_[currentBomSoundIndex_]);
-	audio_->SoundPlayWave(bomSounds_[currentBomSoundIndex_], 0.4f, false);
+	// 発射音を再生(プレイヤーが撃った音は敵の音より優先)
+	audio_->PlaySE(bomSound_, 0.4f, 1);
+}
 
+Bom* CannonEnemy::AcquireBullet() {
+	for (Bom* bom : bulletPool_) {
+		if (bom->IsFinished()) {
+			return bom;
+		}
+	}
 
-	// 次のサウンドバッファに進む
-	currentBomSoundIndex_ = (currentBomSoundIndex_ + 1) % MAX_BOM_SOUNDS;
+	// 全部使用中なら一番古い弾を消して使う
+	Bom* oldest = bullets_.empty() ? bulletPool_.front() : bullets_.front();
+	oldest->Deactivate();
+	std::erase(bullets_, oldest);
+	return oldest;
 }
 
 // AABBを取得するメソッドを定義
@@ -306,10 +312,10 @@ void CannonEnemy::ContralPlayer() {
 	isPlayer = true;
 
 	// のりうつった時の弾の削除
-	bullets_.remove_if([](Bom* bom) {
-		delete bom;
-		return true;
-		});
+	for (Bom* bom : bullets_) {
+		bom->Deactivate();
+	}
+	bullets_.clear();
 
 	//発射モーションリセット
 	worldTransform_.scale_ = { 1,1,1 };
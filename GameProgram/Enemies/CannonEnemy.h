@@ -2,7 +2,8 @@
 #include "WorldTransform.h"
 #include "Object3d.h"
 #include "AABB.h"
-#include "collision.h"
+#include "Collision.h"
+#include "CollisionWorld.h"
 
 #include "MyMath.h"
 
@@ -22,15 +23,15 @@ public:
 
 	void Init();
 	void Update();
+	void UpdateImGui(); // デバッグ表示(描画1回につき1回)
 	void Draw();
 	void DrawP();
 	
 	void Fire();
 	void PlayerFire();
 
-	void SetObstacleList(const std::vector<AABB>& obstacles);
-
-	void AddObstacle(const AABB& obstacle);
+	// ステージの当たり判定(シーンが所有)
+	void SetCollisionWorld(const CollisionWorld* world) { collisionWorld_ = world; }
 
 	void SetPlayer(Player* player) { player_ = player; }
 	AABB GetAABB();
@@ -40,7 +41,8 @@ public:
 	void ReMove(const Vector3& position_);
 	bool GetPlayerCtrl() const { return isPlayer; }
 
-	std::list<Bom*> GetBom() { return bullets_; }
+	// 飛んでいる弾
+	const std::vector<Bom*>& GetBom() const { return bullets_; }
 
 	// 位置を設定するメソッドを追加
 	void SetPosition(const Vector3& pos) {
@@ -63,15 +65,15 @@ private:
 	Vector3 RespownPosition; //リスポーン地点
 	// サウンド関連
 	Audio* audio_ = nullptr;
-	// 複数の爆発音サウンドデータ（連射用）
-	static const int MAX_BOM_SOUNDS = 5;
-	SoundData bomSounds_[MAX_BOM_SOUNDS];
-	int currentBomSoundIndex_ = 0;
+	// 発射音(同時に鳴らす数はAudioのミキサーが決める)
+	const SoundBuffer* bomSound_ = nullptr;
 	bool onGround_ = true;
 	float velocityY_ = 0.0f;
 
-	// 障害物リスト
-	std::vector<AABB> obstacleList_;
+	// ステージの当たり判定
+	const CollisionWorld* collisionWorld_ = nullptr;
+	std::vector<uint32_t> nearIndices_;
+	std::vector<AABB> nearObstacles_;
 	
 	// 破壊可能なブロックのリスト
 	std::vector<Block*> blocks_;
@@ -98,7 +100,14 @@ private:
 
 	float animertion = 0.0f;
 
-	std::list<Bom*> bullets_;
+	// 弾はステージ読み込み時にkMaxBullets個作っておき、発射ではInitし直すだけにする
+	static const int kMaxBullets = 8;
+	std::vector<Bom*> bulletPool_;
+	// 飛んでいる弾(bulletPool_の一部、古い順)
+	std::vector<Bom*> bullets_;
+	// 空いている弾を取る(空きが無ければ一番古い弾を消して使う)
+	Bom* AcquireBullet();
+
 	Player* player_ = nullptr;
 
 	Particle* particleMove_ = nullptr;
@@ -1,23 +1,17 @@
 #include "GhostEnemy.h"
+#include "GameTimer.h"
+#include "GameRandom.h"
 #include "AABB.h"
 #include "Collision.h"
 #include "ImGuiManager.h"
+#include "TextureManager.h"
 #include <algorithm>
 #include <iostream>
 #include <cmath>
-#include <cstdlib>
-#include <ctime>
 
 using namespace MyMath;
 
 GhostEnemy::GhostEnemy() {
-	// 乱数初期化（最初の実行時だけ）
-	static bool randomInitialized = false;
-	if (!randomInitialized) {
-		std::srand(static_cast<unsigned int>(std::time(nullptr)));
-		randomInitialized = true;
-	}
-
 	// 最初の目的地を設定
 	SetNewRandomDestination();
 }
@@ -38,32 +32,29 @@ void GhostEnemy::Init() {
 	modelRespown_->Initialize();
 	modelRespown_->SetModelFile("GhostRespown");
 
+	// 描画時に文字列で引かないよう先に取っておく
+	textureHandles_[static_cast<int>(ColorType::Blue)] = TextureManager::GetInstance()->LoadTextureHandle("resource/Sprite/BlueGhost.png");
+	textureHandles_[static_cast<int>(ColorType::Green)] = TextureManager::GetInstance()->LoadTextureHandle("resource/Sprite/GreenGhost.png");
+	textureHandles_[static_cast<int>(ColorType::Red)] = TextureManager::GetInstance()->LoadTextureHandle("resource/Sprite/RedGhost.png");
+
 	worldTransform_.translation_ = position;
 
 	worldTransformRespown_.Initialize();
 	worldTransformModel_.Initialize();
 }
 
-void GhostEnemy::SetObstacleList(const std::vector<AABB>& obstacles) { obstacleList_.insert(obstacleList_.end(), obstacles.begin(), obstacles.end()); }
-
-void GhostEnemy::AddObstacle(const AABB& obstacle) { obstacleList_.push_back(obstacle); }
-
 void GhostEnemy::SetPosition(const Vector3& pos) {
 	position = pos;
 	worldTransform_.translation_ = position;
 	worldTransformRespown_.translation_ = position;
 }
 
-void GhostEnemy::ClearObstacleList() {
-	obstacleList_.clear();
-}
-
 void GhostEnemy::SetTarget(Player* target) {
 	player_ = target;
 }
 
 void GhostEnemy::Update() {
-	const float deltaTime = 1.0f / 60.0f;
+	const float deltaTime = GameTimer::GetInstance()->GetDeltaTime();
 
 	// スタン状態の処理
 	if (isStan) {
@@ -86,13 +77,20 @@ void GhostEnemy::Update() {
 		enemyAABB.min = { position.x - halfW, position.y - halfH, position.z - halfD };
 		enemyAABB.max = { position.x + halfW, position.y + halfH, position.z + halfD };
 
+		// 近くの障害物だけを調べる
+		nearObstacles_.clear();
+		if (collisionWorld_) {
+			const float margin = 2.0f;
+			collisionWorld_->QueryOverlap({ enemyAABB.min - margin, enemyAABB.max + margin }, nearIndices_, nearObstacles_);
+		}
+
 		// 反復的衝突解決
 		const int maxIterations = 10;
 		int iterations = 0;
 		bool collisionOccurred = false;
 		do {
 			collisionOccurred = false;
-			for (auto& obstacleAABB : obstacleList_) {
+			for (auto& obstacleAABB : nearObstacles_) {
 				if (IsCollisionAABB(enemyAABB, obstacleAABB)) {
 					ResolveAABBCollision(enemyAABB, obstacleAABB, velocityY_, onGround_);
 					collisionOccurred = true;
@@ -240,7 +238,13 @@ void GhostEnemy::Update() {
 		worldTransformModel_.translation_.y = position.y + hoverOffset;
 	}
 
-#ifdef _DEBUG
+	worldTransform_.UpdateMatrix();
+	worldTransformModel_.UpdateMatrix();
+	worldTransformRespown_.UpdateMatrix();
+}
+
+void GhostEnemy::UpdateImGui() {
+#ifdef USE_IMGUI
 	ImGui::Begin("GhostEnemy");
 	ImGui::DragFloat3("translate", &position.x);
 	ImGui::DragFloat("Chase Radius", &chaseRadius_, 1.0f, 5.0f, 100.0f);
@@ -263,10 +267,6 @@ void GhostEnemy::Update() {
 
 	ImGui::End();
 #endif
-
-	worldTransform_.UpdateMatrix();
-	worldTransformModel_.UpdateMatrix();
-	worldTransformRespown_.UpdateMatrix();
 }
 
 void GhostEnemy::UpdateRandomMovement(float deltaTime) {
@@ -305,10 +305,10 @@ void GhostEnemy::SetNewRandomDestination() {
 	Vector3 currentPos = GetWorldPosition();
 
 	// ランダムな角度を生成（0～2π）
-	float randomAngle = static_cast<float>(std::rand()) / RAND_MAX * 2.0f * 3.14159265f;
+	float randomAngle = GameRandom::GetInstance()->NextFloat() * 2.0f * 3.14159265f;
 
 	// ランダムな距離を生成（0～randomMoveRadius_）
-	float randomDistance = static_cast<float>(std::rand()) / RAND_MAX * randomMoveRadius_;
+	float randomDistance = GameRandom::GetInstance()->NextFloat() * randomMoveRadius_;
 
 	// 極座標から直交座標へ変換
 	float offsetX = std::cos(randomAngle) * randomDistance;
@@ -327,7 +327,7 @@ void GhostEnemy::SetNewRandomDestination() {
 	randomMoveTimer_ = 0.0f;
 
 	// ランダムな移動時間を設定（5～10秒）
-	randomMoveDuration_ = 5.0f + static_cast<float>(std::rand()) / RAND_MAX * 5.0f;
+	randomMoveDuration_ = GameRandom::GetInstance()->NextFloat(5.0f, 10.0f);
 }
 
 void GhostEnemy::EnforceFieldBoundaries() {
@@ -389,8 +389,8 @@ void GhostEnemy::EnforceFieldBoundaries() {
 
 			// 中央方向に目的地を設定（少しランダム性を加える）
 			float randomOffset = 20.0f;
-			randomDestination_.x = fieldCenter.x + (static_cast<float>(std::rand()) / RAND_MAX * randomOffset - randomOffset * 0.5f);
-			randomDestination_.z = fieldCenter.z + (static_cast<float>(std::rand()) / RAND_MAX * randomOffset - randomOffset * 0.5f);
+			randomDestination_.x = fieldCenter.x + GameRandom::GetInstance()->NextFloat(-randomOffset * 0.5f, randomOffset * 0.5f);
+			randomDestination_.z = fieldCenter.z + GameRandom::GetInstance()->NextFloat(-randomOffset * 0.5f, randomOffset * 0.5f);
 
 			// 目的地をフィールド内に制限
 			randomDestination_.x = std::clamp(randomDestination_.x, fieldMin_.x + 5.0f, fieldMax_.x - 5.0f);
@@ -405,8 +405,12 @@ void GhostEnemy::CheckCollisionWithObstacles() {
 	// ゴーストのAABB
 	AABB ghostAABB = GetAABB();
 
-	// すべての障害物と衝突判定
-	for (const auto& obstacleAABB : obstacleList_) {
+	// 重なっている障害物と衝突判定
+	nearObstacles_.clear();
+	if (collisionWorld_) {
+		collisionWorld_->QueryOverlap(ghostAABB, nearIndices_, nearObstacles_);
+	}
+	for (const auto& obstacleAABB : nearObstacles_) {
 		if (IsCollisionAABB(ghostAABB, obstacleAABB)) {
 			// 衝突したら押し出し処理
 			Vector3 overlap = GetOverlapAmount(ghostAABB, obstacleAABB);
@@ -470,15 +474,15 @@ void GhostEnemy::Draw() {
 	{
 	case ColorType::Blue:
 		model_->Draw(worldTransformModel_);	
-		modelRespown_->Draw(worldTransformRespown_, "resource/Sprite/BlueGhost.png");
+		modelRespown_->Draw(worldTransformRespown_, textureHandles_[static_cast<int>(ColorType::Blue)]);
 		break;
 	case ColorType::Green:
-		model_->Draw(worldTransformModel_, "resource/Sprite/GreenGhost.png");
-		modelRespown_->Draw(worldTransformRespown_, "resource/Sprite/GreenGhost.png");
+		model_->Draw(worldTransformModel_, textureHandles_[static_cast<int>(ColorType::Green)]);
+		modelRespown_->Draw(worldTransformRespown_, textureHandles_[static_cast<int>(ColorType::Green)]);
 		break;
 	case ColorType::Red:
-		model_->Draw(worldTransformModel_, "resource/Sprite/RedGhost.png");
-		modelRespown_->Draw(worldTransformRespown_, "resource/Sprite/RedGhost.png");
+		model_->Draw(worldTransformModel_, textureHandles_[static_cast<int>(ColorType::Red)]);
+		modelRespown_->Draw(worldTransformRespown_, textureHandles_[static_cast<int>(ColorType::Red)]);
 		break;
 	default:
 		break;
@@ -596,8 +600,8 @@ void GhostEnemy::CheckAndResolveGhostCollisions() {
 
 			if (Length(pushDir) < 0.0001f) {
 				// 完全に重なっている場合はランダムな方向に少しずらす
-				pushDir.x = static_cast<float>(std::rand()) / RAND_MAX * 2.0f - 1.0f;
-				pushDir.z = static_cast<float>(std::rand()) / RAND_MAX * 2.0f - 1.0f;
+				pushDir.x = GameRandom::GetInstance()->NextFloat(-1.0f, 1.0f);
+				pushDir.z = GameRandom::GetInstance()->NextFloat(-1.0f, 1.0f);
 			}
 
 			pushDir = Normalize(pushDir);
@@ -623,7 +627,7 @@ void GhostEnemy::CheckAndResolveGhostCollisions() {
 			velocity.z *= 0.9f;
 
 			// 衝突後の新しい目的地を設定する確率を上げる
-			if (randomMoveTimer_ > 1.0f && std::rand() % 100 < 30) {
+			if (randomMoveTimer_ > 1.0f && GameRandom::GetInstance()->NextFloat() < 0.3f) {
 				SetNewRandomDestination();
 			}
 		}
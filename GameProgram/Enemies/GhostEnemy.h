@@ -6,10 +6,11 @@
 #include "AABB.h"
 #include "CameraController.h"
 #include "Collision.h"
+#include "CollisionWorld.h"
 #include "math/Vector3.h"
 #include <vector>
-#include "input/input.h"
-#include "Mymath.h"
+#include "Input.h"
+#include "MyMath.h"
 #include "GhostColor.h"
 
 class Player;
@@ -20,11 +21,11 @@ public:
 
     void Init();
     void Update();
+    void UpdateImGui(); // デバッグ表示(描画1回につき1回)
     void Draw();
 
-    // 障害物リスト（AABB）の設定／追加
-    void SetObstacleList(const std::vector<AABB>& obstacles);
-    void AddObstacle(const AABB& obstacle);
+    // ステージの当たり判定(シーンが所有)
+    void SetCollisionWorld(const CollisionWorld* world) { collisionWorld_ = world; }
 
     // AABBを取得するメソッドを追加
     AABB GetAABB() const;
@@ -52,8 +53,6 @@ public:
 
     void SetChaseRadius(float radius); // 追尾範囲を設定するメソッド
 
-    void ClearObstacleList();
-
     ColorType GetColor() { return colorType; }
     void SetColor(ColorType color) { colorType = color; }
     
@@ -90,8 +89,10 @@ private:
     float kChaseSpeed = 0.1f;  // 追跡速度
     float kSeparationSpeed = 0.15f;  // 分離速度（他のゴーストから離れる速度）
 
-    // 障害物リスト
-    std::vector<AABB> obstacleList_;
+    // ステージの当たり判定
+    const CollisionWorld* collisionWorld_ = nullptr;
+    std::vector<uint32_t> nearIndices_;
+    std::vector<AABB> nearObstacles_;
 
     Vector3 velocity;
     //bool IsJump = false;
@@ -142,6 +143,9 @@ private:
     WorldTransform worldTransformRespown_;
     Object3d* modelRespown_ = nullptr; // 目印用のオブジェクト
 
+    // 色ごとのテクスチャ(ColorTypeの順)
+    D3D12_GPU_DESCRIPTOR_HANDLE textureHandles_[3] = {};
+
     float hoverTimer_ = 0.0f;
     float hoverAmplitude_ = 0.2f; // 上下振れ幅（調整可能）
     float hoverFrequency_ = 2.0f; // 振動の速さ（Hz単位）
@@ -1,10 +1,14 @@
 #include "SpringEnemy.h"
+#include "GameTimer.h"
 #include "Player.h"
-#include "ImguiManager.h"
+#include "ImGuiManager.h"
 
 SpringEnemy::SpringEnemy() {}
 
-SpringEnemy::~SpringEnemy() { delete model_; }
+SpringEnemy::~SpringEnemy() {
+	delete model_;
+	Audio::GetInstance()->UnloadWave(BaneSound);
+}
 
 void SpringEnemy::Init() {
 	model_ = new Object3d();
@@ -26,10 +30,6 @@ void SpringEnemy::Init() {
 	BaneSound = audio_->LoadWave("./sound/bane.wav");
 }
 
-void SpringEnemy::SetObstacleList(const std::vector<AABB>& obstacles) { obstacleList_.insert(obstacleList_.end(), obstacles.begin(), obstacles.end()); }
-
-void SpringEnemy::AddObstacle(const AABB& obstacle) { obstacleList_.push_back(obstacle); }
-
 void SpringEnemy::SetPosition(const Vector3& pos) {
 	position = pos;
 	worldTransform_.translation_ = position;
@@ -40,7 +40,7 @@ void SpringEnemy::SetPosition(const Vector3& pos) {
 }
 
 void SpringEnemy::Update() {
-	const float deltaTime = 1.0f / 60.0f;
+	const float deltaTime = GameTimer::GetInstance()->GetDeltaTime();
 
 
 	// スタン状態管理
@@ -55,7 +55,7 @@ void SpringEnemy::Update() {
 	if (!isPlayer) {
 		// --- 攻撃のロジック ---
 		if (cooldownTimer_ > 0.0f) {
-			cooldownTimer_ -= 1.0f / 60.0f; // 毎フレーム減少（60FPS）
+			cooldownTimer_ -= deltaTime;
 		}
 		else if (attackTimer_ <= 0.0f && player_) {
 			Vector3 playerPos = player_->GetWorldPosition();
@@ -77,7 +77,7 @@ void SpringEnemy::Update() {
 
 		// --- 回転アニメーション ---
 		if (attackTimer_ > 0.0f) {
-			attackTimer_ -= 1.0f / 60.0f;
+			attackTimer_ -= deltaTime;
 			worldTransform_.rotation_.y += rotationSpeed_;
 		}
 		else {
@@ -95,8 +95,14 @@ void SpringEnemy::Update() {
 		enemyAABB.min = { position.x - halfW, position.y - halfH, position.z - halfD };
 		enemyAABB.max = { position.x + halfW, position.y + halfH, position.z + halfD };
 
+		// 重なっている障害物だけを調べる
+		nearObstacles_.clear();
+		if (collisionWorld_) {
+			collisionWorld_->QueryOverlap(enemyAABB, nearIndices_, nearObstacles_);
+		}
+
 		// 地面との衝突のみチェック（横方向の衝突は無視）
-		for (auto& obstacleAABB : obstacleList_) {
+		for (auto& obstacleAABB : nearObstacles_) {
 			if (IsCollisionAABB(enemyAABB, obstacleAABB)) {
 				// Y座標のみ調整
 				if (enemyAABB.min.y < obstacleAABB.max.y && enemyAABB.max.y > obstacleAABB.max.y) {
@@ -163,7 +169,11 @@ void SpringEnemy::Update() {
 		}
 	}
 
-#ifdef _DEBUG
+	worldTransform_.UpdateMatrix();
+}
+
+void SpringEnemy::UpdateImGui() {
+#ifdef USE_IMGUI
 	// デバッグUI
 	ImGui::Begin("SpringEnemy");
 	ImGui::DragFloat3("Position", &position.x);
@@ -171,8 +181,6 @@ void SpringEnemy::Update() {
 	ImGui::Text("Compressed: %s", isCompressed ? "Yes" : "No");
 	ImGui::End();
 #endif
-
-	worldTransform_.UpdateMatrix();
 }
 
 void SpringEnemy::Draw() { model_->Draw(worldTransform_); }
@@ -222,8 +230,4 @@ void SpringEnemy::ReMove(const Vector3& position_) {
 		// バネの音を再生
 		//audio_->SoundPlayWave(BaneSound, 0.5f);
 	}
-}
-
-void SpringEnemy::ClearObstacleList() {
-	obstacleList_.clear(); // ✅ クリア
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include "AABB.h"
 #include "Collision.h"
+#include "CollisionWorld.h"
 #include "WorldTransform.h"
 #include "Object3d.h"
 #include "Input.h"
@@ -18,12 +19,11 @@ public:
 
 	void Init();
 	void Update();
+	void UpdateImGui(); // デバッグ表示(描画1回につき1回)
 	void Draw();
 
-	// 障害物処理
-	void SetObstacleList(const std::vector<AABB>& obstacles);
-	void AddObstacle(const AABB& obstacle);
-	void ClearObstacleList();
+	// ステージの当たり判定(シーンが所有)
+	void SetCollisionWorld(const CollisionWorld* world) { collisionWorld_ = world; }
 
 	// 位置設定
 	void SetPosition(const Vector3& pos);
@@ -60,8 +60,10 @@ private:
 	bool onGround_ = true;
 	float velocityY_ = 0.0f;
 
-	// 障害物リスト
-	std::vector<AABB> obstacleList_;
+	// ステージの当たり判定
+	const CollisionWorld* collisionWorld_ = nullptr;
+	std::vector<uint32_t> nearIndices_;
+	std::vector<AABB> nearObstacles_;
 
 	// 破壊可能なブロックのリスト
 	std::vector<Block*> blocks_;
@@ -1,7 +1,8 @@
 #include "Block.h"
+#include "GameTimer.h"
+#include "GameRandom.h"
 #include "MyMath.h"
 #include <cmath>
-#include <random>
 #include "Audio.h"
 
 using namespace MyMath;
@@ -25,6 +26,10 @@ Block::~Block() {
 			fragment.model = nullptr;
 		}
 	}
+
+	// 波形はSoundBankで共有しているので、ボイスと参照だけ返す
+	Audio::GetInstance()->UnloadWave(hitSound_);
+	Audio::GetInstance()->UnloadWave(breakSound_);
 }
 
 void Block::Init() {
@@ -94,7 +99,7 @@ void Block::Update() {
 		return;
 	}
 
-	const float deltaTime = 1.0f / 60.0f;
+	const float deltaTime = GameTimer::GetInstance()->GetDeltaTime();
 
 	// ダメージエフェクトの更新
 	if (isDamaged_) {
@@ -104,14 +109,11 @@ void Block::Update() {
 
 		// 揺れエフェクト
 		if (shakeTimer_ > 0.0f) {
-			static std::random_device rd;
-			static std::mt19937 gen(rd());
-			static std::uniform_real_distribution<float> dis(-1.0f, 1.0f);
-
+			GameRandom* random = GameRandom::GetInstance();
 			Vector3 shakeOffset = {
-				dis(gen) * SHAKE_INTENSITY,
-				dis(gen) * SHAKE_INTENSITY,
-				dis(gen) * SHAKE_INTENSITY
+				random->NextFloat(-1.0f, 1.0f) * SHAKE_INTENSITY,
+				random->NextFloat(-1.0f, 1.0f) * SHAKE_INTENSITY,
+				random->NextFloat(-1.0f, 1.0f) * SHAKE_INTENSITY
 			};
 			worldTransform.translation_ = originalPosition_ + shakeOffset;
 		}
@@ -182,6 +184,14 @@ AABB Block::GetAABB() const {
 	return aabb;
 }
 
+AABB Block::GetBroadAABB() const {
+	float shake = MAX_SHAKE_RATIO * (size_.x + size_.y + size_.z) / 3.0f;
+	AABB aabb;
+	aabb.min = originalPosition_ - size_ - shake;
+	aabb.max = originalPosition_ + size_ + shake;
+	return aabb;
+}
+
 void Block::SetPosition(const Vector3& pos) {
 	worldTransform.translation_ = pos;
 	originalPosition_ = pos; // 元の位置も更新
@@ -221,7 +231,7 @@ void Block::OnCollision() {
 	if (hp <= 1) {
 		// HPが低い時は少し大きめのエフェクト
 		SCALE_INTENSITY = 1.15f + (sizeEffect * 0.02f);
-		SHAKE_INTENSITY = 0.08f * sizeEffect;
+		SHAKE_INTENSITY = MAX_SHAKE_RATIO * sizeEffect;
 	}
 	else if (hp <= 2) {
 		// HPが中程度の時は中程度のエフェクト
@@ -337,11 +347,10 @@ void Block::OnCollision() {
 
 void Block::CreateFragments() {
 	// ランダム生成用
-	std::random_device rd;
-	std::mt19937 gen(rd());
-	std::uniform_real_distribution<float> velocityDist(-10.0f, 10.0f);
-	std::uniform_real_distribution<float> rotationDist(-5.0f, 5.0f);
-	std::uniform_real_distribution<float> scaleDist(0.1f, 0.3f);
+	GameRandom* random = GameRandom::GetInstance();
+	auto velocityDist = [random]() { return random->NextFloat(-10.0f, 10.0f); };
+	auto rotationDist = [random]() { return random->NextFloat(-5.0f, 5.0f); };
+	auto scaleDist = [random]() { return random->NextFloat(0.1f, 0.3f); };
 	
 	// ブロックサイズに基づいて破片数を決定
 	float volumeMultiplier = size_.x * size_.y * size_.z;
@@ -359,30 +368,30 @@ void Block::CreateFragments() {
 		
 		// 初期位置をブロックの位置に設定（少しランダムにずらす）
 		fragment.transform.translation_ = worldTransform.translation_;
-		fragment.transform.translation_.x += velocityDist(gen) * 0.1f;
-		fragment.transform.translation_.y += velocityDist(gen) * 0.1f;
-		fragment.transform.translation_.z += velocityDist(gen) * 0.1f;
+		fragment.transform.translation_.x += velocityDist() * 0.1f;
+		fragment.transform.translation_.y += velocityDist() * 0.1f;
+		fragment.transform.translation_.z += velocityDist() * 0.1f;
 		
 		// 破片のサイズを設定（ブロックサイズに基づく）
-		float fragmentScale = scaleDist(gen) * ((size_.x + size_.y + size_.z) / 3.0f);
+		float fragmentScale = scaleDist() * ((size_.x + size_.y + size_.z) / 3.0f);
 		fragment.transform.scale_ = {fragmentScale, fragmentScale, fragmentScale};
 		
 		// 初期回転をランダムに
-		fragment.transform.rotation_.x = rotationDist(gen);
-		fragment.transform.rotation_.y = rotationDist(gen);
-		fragment.transform.rotation_.z = rotationDist(gen);
+		fragment.transform.rotation_.x = rotationDist();
+		fragment.transform.rotation_.y = rotationDist();
+		fragment.transform.rotation_.z = rotationDist();
 		
 		// 速度と回転速度を設定
 		fragment.velocity = {
-			velocityDist(gen),
-			velocityDist(gen) + 5.0f, // 上方向に飛ばす
-			velocityDist(gen)
+			velocityDist(),
+			velocityDist() + 5.0f, // 上方向に飛ばす
+			velocityDist()
 		};
 		
 		fragment.rotationSpeed = {
-			rotationDist(gen),
-			rotationDist(gen),
-			rotationDist(gen)
+			rotationDist(),
+			rotationDist(),
+			rotationDist()
 		};
 		
 		fragment.transform.UpdateMatrix();
@@ -390,7 +399,7 @@ void Block::CreateFragments() {
 }
 
 void Block::UpdateFragments() {
-	const float deltaTime = 1.0f / 60.0f;
+	const float deltaTime = GameTimer::GetInstance()->GetDeltaTime();
 	const float gravity = -20.0f;
 	
 	for (auto& fragment : fragments_) {
@@ -20,6 +20,8 @@ public:
 	void SetActive(bool active) { isActive_ = active; } // アクティブ状態を設定
 
 	AABB GetAABB() const; // AABBの取得
+	// 揺れても出ない範囲(ステージ読み込み時に当たり判定の候補探し用に並べる)
+	AABB GetBroadAABB() const;
 
 	// 位置を設定するメソッドを追加
 	void SetPosition(const Vector3& pos);
@@ -78,6 +80,7 @@ private:
 	const float SCALE_EFFECT_TIME = 0.2f;
 	const float SHAKE_EFFECT_TIME = 0.15f;
 	float SHAKE_INTENSITY = 0.05f; // より控えめに
+	const float MAX_SHAKE_RATIO = 0.08f; // 揺れの強さの最大(平均サイズに対する割合)
 	float SCALE_INTENSITY = 1.1f; // より控えめに
 
 	// オーディオ
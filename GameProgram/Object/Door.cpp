@@ -1,5 +1,5 @@
 #include "Door.h"
-#ifdef _DEBUG
+#ifdef USE_IMGUI
 #include "ImGuiManager.h"
 #endif
 
@@ -24,7 +24,8 @@ Door::Door() {}
 
 Door::~Door() {
 	delete model_;
-	// サウンドリソースの解放は不要（Audioクラスが管理）
+	// 波形はAudioのSoundBankが持っているので、ボイスと参照だけ返す
+	Audio::GetInstance()->UnloadWave(doorOpenSound_);
 }
 
 void Door::Init() {
@@ -261,7 +262,10 @@ void Door::Update() {
 
 	// 行列更新
 	worldTransform_.UpdateMatrix();
-#ifdef _DEBUG
+}
+
+void Door::UpdateImGui() {
+#ifdef USE_IMGUI
 	// ImGuiによるデバッグ表示
 	ImGui::Begin("Door Status");
 	ImGui::Checkbox("Door Touch", &isDoorTouched_);
@@ -294,6 +298,15 @@ void Door::Update() {
 		// アニメーション情報
 		ImGui::Text("Is Animating: %s", isAnimating_ ? "Yes" : "No");
 	}
+
+	// 当たり判定のAABBサイズを計算
+	AABB doorAABB = GetAABB();
+	Vector3 aabbSize = {
+		doorAABB.max.x - doorAABB.min.x,
+		doorAABB.max.y - doorAABB.min.y,
+		doorAABB.max.z - doorAABB.min.z
+	};
+	ImGui::Text("AABB Size: %.2f, %.2f, %.2f", aabbSize.x, aabbSize.y, aabbSize.z);
 	ImGui::End();
 #endif
 }
@@ -350,16 +363,5 @@ AABB Door::GetAABB() {
 		doorAABB.max.z += expansion.z;
 	}
 	
-	// デバッグ用に当たり判定の領域を表示
-#ifdef _DEBUG
-	// 当たり判定のAABBサイズを計算
-	Vector3 aabbSize = {
-		doorAABB.max.x - doorAABB.min.x,
-		doorAABB.max.y - doorAABB.min.y,
-		doorAABB.max.z - doorAABB.min.z
-	};
-	ImGui::Text("AABB Size: %.2f, %.2f, %.2f", aabbSize.x, aabbSize.y, aabbSize.z);
-#endif
-
 	return doorAABB;
 }
\ No newline at end of file
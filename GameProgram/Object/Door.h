@@ -1,6 +1,6 @@
 #pragma once
 #include "AABB.h"
-#include "Key.h"
+#include "key.h"
 #include "Player.h"
 #include "../../Engine/audio/Audio.h"
 #include <vector>
@@ -19,6 +19,9 @@ public:
 	// 更新
 	void Update();
 
+	// デバッグ表示(描画1回につき1回)
+	void UpdateImGui();
+
 	// 描画
 	void Draw();
 
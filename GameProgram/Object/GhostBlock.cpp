@@ -1,5 +1,6 @@
 #include "GhostBlock.h"
 #include "MyMath.h"
+#include "TextureManager.h"
 
 using namespace MyMath;
 
@@ -11,6 +12,11 @@ void GhostBlock::Init() {
     model_->Initialize();
 	model_->SetModelFile("cube");
 
+    // 描画時に文字列で引かないよう先に取っておく
+    textureHandles_[static_cast<int>(ColorType::Blue)] = TextureManager::GetInstance()->LoadTextureHandle("resource/Sprite/Blue.png");
+    textureHandles_[static_cast<int>(ColorType::Green)] = TextureManager::GetInstance()->LoadTextureHandle("resource/Sprite/Green.png");
+    textureHandles_[static_cast<int>(ColorType::Red)] = TextureManager::GetInstance()->LoadTextureHandle("resource/Sprite/Red.png");
+
     worldTransform_.Initialize();
 	worldTransform_.UpdateMatrix();
 }
@@ -22,20 +28,7 @@ void GhostBlock::Update() {
 void GhostBlock::Draw() {
     if (!isActive_) return; // 非アクティブなら描画しない
 
-    switch (colorType)
-    {
-    case ColorType::Blue:
-        model_->Draw(worldTransform_, "resource/Sprite/Blue.png");
-        break;
-    case ColorType::Green:
-        model_->Draw(worldTransform_, "resource/Sprite/Green.png");
-        break;
-    case ColorType::Red:
-        model_->Draw(worldTransform_, "resource/Sprite/Red.png");
-        break;
-    default:
-        break;
-    }
+    model_->Draw(worldTransform_, textureHandles_[static_cast<int>(colorType)]);
 }
 
 AABB GhostBlock::GetAABB() const {
@@ -32,7 +32,8 @@ private:
 
     Object3d* model_ = nullptr;
     bool isActive_ = true; // ブロックが有効かどうか
-    uint32_t texturehandle_ = 0;
+    // 色ごとのテクスチャ(ColorTypeの順)
+    D3D12_GPU_DESCRIPTOR_HANDLE textureHandles_[3] = {};
     Vector3 size_;
     ColorType colorType = ColorType::Blue;
 };
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Goal.h"
+#include "GameTimer.h"
 #include "MyMath.h"
 #include <TextureManager.h>
 #include "Input.h"
@@ -12,6 +13,7 @@ Goal::~Goal() {
 	delete sprite;
 	delete model_;
 	delete particleCelebration_;
+	audio_->UnloadWave(clearSound_);
 }
 
 void Goal::Init() {
@@ -46,7 +48,7 @@ void Goal::Init() {
 
 
 void Goal::Update() {
-	const float deltaTime = 1.0f / 60.0f;
+	const float deltaTime = GameTimer::GetInstance()->GetDeltaTime();
 
 	// フローティングアニメーション
 	floatingTime_ += deltaTime;
@@ -79,14 +81,19 @@ void Goal::Update() {
 			celebrationTimer_ = 0.0f;
 			particleSpawnTimer_ = 0.0f;
 		}
-#ifdef _DEBUG
+	}
+	sprite->Update();
+	worldTransform_.UpdateMatrix();
+}
+
+void Goal::UpdateImGui() {
+#ifdef USE_IMGUI
+	if (isClear) {
 		ImGui::Begin("Restart");
 		ImGui::Text("keyBorad 'R' Restart");
 		ImGui::End();
-#endif // _DEBUG
 	}
-	sprite->Update();
-	worldTransform_.UpdateMatrix();
+#endif // USE_IMGUI
 }
 
 void Goal::Draw() { model_->Draw(worldTransform_); }
@@ -15,6 +15,7 @@ public:
 
 	void Init();
 	void Update();
+	void UpdateImGui(); // デバッグ表示(描画1回につき1回)
 	void Draw();
 	void DrawP(); // パーティクル描画
 	void Text();
@@ -1,5 +1,6 @@
 #include "MoveTile.h"
-#ifdef _DEBUG
+#include "GameTimer.h"
+#ifdef USE_IMGUI
 #include "ImGuiManager.h"
 #endif
 
@@ -19,8 +20,9 @@ void MoveTile::Init() {
 }
 
 void MoveTile::Update() {
-	// 現在の時間を取得（秒換算）
-	float time = static_cast<float>(clock()) / CLOCKS_PER_SEC;
+	// 生成してからの時間（秒換算）。リプレイで同じ位置になるように実時間ではなくtickで進める
+	elapsedTime_ += GameTimer::GetInstance()->GetDeltaTime();
+	float time = static_cast<float>(elapsedTime_);
 
 	// sin波を利用して上下移動
 	worldTransform_.translation_.y = initialY_ + std::sin(time * moveSpeed_) * moveRange_;
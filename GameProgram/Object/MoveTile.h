@@ -1,6 +1,6 @@
 #pragma once
 #include "AABB.h"
-#include "Key.h"
+#include "key.h"
 #include "Player.h"
 #include <vector>
 
@@ -69,5 +69,6 @@ private:
 	float initialY_ = 92;
 	bool movingUp_ = true; // 上昇中か下降中かを示すフラグ
 	int frameCount_ = 0; // フレームカウント（初期値0）
+	double elapsedTime_ = 0.0; // 生成してからの時間（tickで進める）
 	bool isCustom_ = false; // カスタム設定かどうか
 };
\ No newline at end of file
@@ -1,4 +1,4 @@
-#include "Skydome.h"
+#include "SkyDome.h"
 
 Skydome::Skydome(){}
 Skydome::~Skydome() { delete model_; }
@@ -1,6 +1,6 @@
-#include "Key.h"
+#include "key.h"
 
-#ifdef _DEBUG
+#ifdef USE_IMGUI
 #include "ImGuiManager.h"
 #endif
 
@@ -9,6 +9,7 @@ Key::Key() {}
 Key::~Key() { 
 	delete model_; 
 	delete particle;
+	Audio::GetInstance()->UnloadWave(keyGetSound_);
 }
 
 void Key::Init() {
@@ -79,9 +80,10 @@ void Key::Update() {
 
 	// 行列を更新
 	worldTransform_.UpdateMatrix();
+}
 
-	// ImGuiデバッグ表示
-#ifdef _DEBUG
+void Key::UpdateImGui() {
+#ifdef USE_IMGUI
 	ImGui::Begin("Key Status");
 	ImGui::Text("Key ID: %d", keyID_);
 	ImGui::Checkbox("KeyFlg", &isObtained_);
@@ -14,6 +14,9 @@ public:
 	// 更新
 	void Update();
 
+	// デバッグ表示(描画1回につき1回)
+	void UpdateImGui();
+
 	// 描画
 	void Draw();
 	void DrawP();
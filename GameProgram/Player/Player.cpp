@@ -1,7 +1,9 @@
 #include "Player.h"
-#ifdef _DEBUG
+#include "GameTimer.h"
+#ifdef USE_IMGUI
 #include "ImGuiManager.h"
 #endif
+#include "TraceRecorder.h"
 #include "GhostEnemy.h"
 #include "Door.h"
 
@@ -37,6 +39,11 @@ Player::~Player() {
 	delete particleRainbowGreen_;
 	delete headModel_;
 	delete footModel_;
+
+	Audio::GetInstance()->UnloadWave(JumpSound_);
+	Audio::GetInstance()->UnloadWave(SnapSound_);
+	Audio::GetInstance()->UnloadWave(DamageSound_);
+	Audio::GetInstance()->UnloadWave(FallSound_);
 }
 
 void Player::Init(Camera* camera) {
@@ -111,11 +118,12 @@ void Player::Init(Camera* camera) {
 	preState = Input::GetInstance()->GetPreState();
 }
 
-void Player::SetObstacleList(const std::vector<AABB>& obstacles) { obstacleList_.insert(obstacleList_.end(), obstacles.begin(), obstacles.end()); }
+void Player::Update() {
+	TRACE_SCOPE("Player::Update");
 
-void Player::AddObstacle(const AABB& obstacle) { obstacleList_.push_back(obstacle); }
+	// スイープ判定用に移動前の位置を保存
+	const Vector3 previousPosition = position;
 
-void Player::Update() {
 	if (!deadPlayer) {
 #pragma region 入力処理
 		Input::GetInstance()->GetJoystickState(0, state);
@@ -419,19 +427,47 @@ void Player::Update() {
 #ifdef _DEBUG
 	if (!isCreativeMode_) {
 #endif
-		const int maxIterations = 10;
-		int iterations = 0;
-		bool collisionOccurred = false;
-		do {
-			collisionOccurred = false;
-			for (auto& obstacleAABB : obstacleList_) {
+		if (collisionWorld_) {
+			// 移動前の位置から今回の移動量をスイープし、当たった面で止めて残りを滑らせる
+			Vector3 half = { halfW, halfH, halfD };
+			Vector3 move = position - previousPosition;
+			AABB movingAABB = { previousPosition - half, previousPosition + half };
+
+			const int maxContacts = 3; // 床・壁・天井でそれぞれ1回まで
+			for (int contact = 0; contact < maxContacts; ++contact) {
+				CollisionHit hit;
+				if (!collisionWorld_->Sweep(movingAABB, move, hit)) {
+					TranslateAABB(movingAABB, move, 1.0f);
+					break;
+				}
+				TranslateAABB(movingAABB, move, hit.time);
+
+				// 当たった面の法線方向を除いた残りの移動量
+				float rest = 1.0f - hit.time;
+				move = { hit.normal.x != 0.0f ? 0.0f : move.x * rest,
+				         hit.normal.y != 0.0f ? 0.0f : move.y * rest,
+				         hit.normal.z != 0.0f ? 0.0f : move.z * rest };
+
+				if (hit.normal.y > 0.0f) {
+					// 着地
+					velocityY_ = 0.0f;
+					onGround_ = true;
+				}
+				else if (hit.normal.y < 0.0f && velocityY_ > 0.0f) {
+					// 天井
+					velocityY_ = 0.0f;
+				}
+			}
+			playerAABB = movingAABB;
+
+			// 移動前から重なっていた障害物(ワープ直後など)は押し戻す
+			collisionWorld_->QueryOverlap(playerAABB, nearIndices_, nearObstacles_);
+			for (const AABB& obstacleAABB : nearObstacles_) {
 				if (IsCollisionAABB(playerAABB, obstacleAABB)) {
 					ResolveAABBCollision(playerAABB, obstacleAABB, velocityY_, onGround_);
-					collisionOccurred = true;
 				}
 			}
-			iterations++;
-		} while (collisionOccurred && iterations < maxIterations);
+		}
 #ifdef _DEBUG
 	}
 #endif
@@ -575,7 +611,7 @@ void Player::Update() {
 	
 	// タイマー更新と地面判定
 	if (springEffectTimer_ > 0.0f) {
-		springEffectTimer_ -= 1.0f / 60.0f;
+		springEffectTimer_ -= GameTimer::GetInstance()->GetDeltaTime();
 		if (springEffectTimer_ <= 0.0f || onGround_) {
 			wasOnSpring_ = false;
 			springEffectTimer_ = 0.0f;
@@ -711,7 +747,7 @@ void Player::Update() {
 	
 	//hpがゼロの時にデスパーティクル発動
 	if (hp <= 0) {
-		const float deltaTimer = 1.0f / 60.0f;
+		const float deltaTimer = GameTimer::GetInstance()->GetDeltaTime();
 
 		deathTimer -= deltaTimer;
 		if (deathTimer > 0) {
@@ -732,8 +768,32 @@ void Player::Update() {
 
 #pragma endregion
 
-#pragma region デバッグ表示
-#ifdef _DEBUG
+	//速すぎてものが貫通しないようにする
+	velocityY_ = std::clamp(velocityY_, -20.0f, 20.0f);
+
+	// 振動タイマーの更新
+	if (vibrationTimer > 0.0f) {
+		const float deltaTime = GameTimer::GetInstance()->GetDeltaTime();
+		vibrationTimer -= deltaTime;
+		
+		// タイマーが0以下になったら振動を停止
+		if (vibrationTimer <= 0.0f) {
+			Input::GetInstance()->StopVibration(0);
+			vibrationTimer = 0.0f;
+		}
+	}
+
+	UpdateFloatingGimmick();
+
+	worldTransform_.UpdateMatrix();
+	worldTransformH_.UpdateMatrix();
+	worldTransformF_.UpdateMatrix();
+
+	cameraController_.Update(camera_, position);
+}
+
+void Player::UpdateImGui() {
+#ifdef USE_IMGUI
 	ImGui::Begin("player");
 	ImGui::DragFloat3("translate", &worldTransform_.translation_.x);
 	ImGui::DragFloat3("aabbMax", &playerAABB.max.x);
@@ -786,30 +846,8 @@ void Player::Update() {
 	}
 	ImGui::End();
 #endif
-#pragma endregion
 
-	//速すぎてものが貫通しないようにする
-	velocityY_ = std::clamp(velocityY_, -20.0f, 20.0f);
-
-	// 振動タイマーの更新
-	if (vibrationTimer > 0.0f) {
-		const float deltaTime = 1.0f / 60.0f;
-		vibrationTimer -= deltaTime;
-		
-		// タイマーが0以下になったら振動を停止
-		if (vibrationTimer <= 0.0f) {
-			Input::GetInstance()->StopVibration(0);
-			vibrationTimer = 0.0f;
-		}
-	}
-
-	UpdateFloatingGimmick();
-
-	worldTransform_.UpdateMatrix();
-	worldTransformH_.UpdateMatrix();
-	worldTransformF_.UpdateMatrix();
-
-	cameraController_.Update(camera_, position);
+	cameraController_.UpdateImGui();
 }
 
 // 落下チェック関数
@@ -857,51 +895,88 @@ void Player::ResetToInitialPosition() {
 	onGround_ = true;
 }
 
-void Player::CheckCollision() {
-	//if (!block_->IsActive() && !ghostBlock_->IsActive()) {
-	//	return;
-	//}
+void Player::SetBlocks(const std::vector<Block*> blocks) {
+	blocks_ = blocks;
+	blockBoxes_.Clear();
+	blockBoxes_.Reserve(blocks_.size());
+	for (Block* block_ : blocks_) {
+		blockBoxes_.Push(block_->GetBroadAABB());
+	}
+}
 
-	for (auto* block_ : blocks_) {
-		AABB blockAABB = block_->GetAABB();
-		switch (currentState) {
-		case State::Bomb:
-			// 全てのキャノン敵の弾でブロック破壊チェック
-			for (CannonEnemy* cannon : cannonEnemies_) {
-				for (Bom* bom : cannon->GetBom()) {
-					AABB bomAABB = bom->GetAABB();
-					if (block_->IsActive() && IsCollisionAABB(bomAABB, blockAABB) && cannon->GetPlayerCtrl()) {
+void Player::SetGhostBlocks(const std::vector<GhostBlock*> blocks) {
+	ghostBlocks_ = blocks;
+	ghostBlockBoxes_.Clear();
+	ghostBlockBoxes_.Reserve(ghostBlocks_.size());
+	for (GhostBlock* ghostBlock_ : ghostBlocks_) {
+		ghostBlockBoxes_.Push(ghostBlock_->GetAABB());
+	}
+}
+
+void Player::FindBlockHits(const AABB& area, const AABBSoA& boxes, uint32_t begin) {
+	blockHits_.clear();
+	IsCollisionAABBBatch(area, boxes, blockHits_);
+	// インデックス順に並んでいるので、調べ終わった分を前から落とす
+	blockHits_.erase(blockHits_.begin(), std::lower_bound(blockHits_.begin(), blockHits_.end(), begin));
+}
+
+void Player::CheckCollision() {
+	// 候補は並べておいた箱からSIMDでまとめて探し、今の箱で確かめる
+	switch (currentState) {
+	case State::Bomb:
+		// 操作中のキャノン敵の弾でブロック破壊チェック
+		for (CannonEnemy* cannon : cannonEnemies_) {
+			if (!cannon->GetPlayerCtrl()) {
+				continue;
+			}
+			for (Bom* bom : cannon->GetBom()) {
+				AABB bomAABB = bom->GetAABB();
+				FindBlockHits(bomAABB, blockBoxes_, 0);
+				for (uint32_t index : blockHits_) {
+					Block* block_ = blocks_[index];
+					if (block_->IsActive() && IsCollisionAABB(bomAABB, block_->GetAABB())) {
 						block_->SetParticlePosition(bom->GetWorldPosition());
 						block_->OnCollision();
 						bom->OnCollision();
-						// ブロックが破壊された場合、他の弾との判定をスキップ
-						if (!block_->IsActive()) {
-							break;
-						}
 					}
 				}
 			}
-			break;
 		}
+		break;
+	}
+
+	// 押し戻したら、その位置でまだ調べていないブロックを探し直す(全部を順に調べるのと同じ結果になる)
+	FindBlockHits(playerAABB, blockBoxes_, 0);
+	for (size_t i = 0; i < blockHits_.size();) {
+		uint32_t index = blockHits_[i++];
+		Block* block_ = blocks_[index];
+		AABB blockAABB = block_->GetAABB();
 		if (block_->IsActive() && IsCollisionAABB(playerAABB, blockAABB)) {
 			ResolveAABBCollision(playerAABB, blockAABB, velocityY_, onGround_);
+			FindBlockHits(playerAABB, blockBoxes_, index + 1);
+			i = 0;
 		}
 	}
 
-	for (auto* ghostBlock_ : ghostBlocks_) {
-		AABB ghostBlockAABB = ghostBlock_->GetAABB();
-
+	FindBlockHits(playerAABB, ghostBlockBoxes_, 0);
+	for (size_t i = 0; i < blockHits_.size();) {
+		uint32_t index = blockHits_[i++];
+		GhostBlock* ghostBlock_ = ghostBlocks_[index];
+		AABB ghostBlockAABB = ghostBlockBoxes_.Get(index);
+		bool isResolved = false;
 
 		switch (currentState) {
 		case State::Normal:
 			if (ghostBlock_->IsActive() && IsCollisionAABB(playerAABB, ghostBlockAABB)) {
 				ResolveAABBCollision(playerAABB, ghostBlockAABB, velocityY_, onGround_);
+				isResolved = true;
 			}
 			break;
 
 		case State::Bomb:
 			if (ghostBlock_->IsActive() && IsCollisionAABB(playerAABB, ghostBlockAABB)) {
 				ResolveAABBCollision(playerAABB, ghostBlockAABB, velocityY_, onGround_);
+				isResolved = true;
 			}
 
 			break;
@@ -912,18 +987,24 @@ void Player::CheckCollision() {
 					//ゴーストが違う色の場合通れない / 同じは通れる
 					if (ghostBlock_->GetColor() != it->GetColor()) {
 						ResolveAABBCollision(playerAABB, ghostBlockAABB, velocityY_, onGround_);
+						isResolved = true;
 					}
 				}
 			}
 			break;
 		}
+
+		if (isResolved) {
+			FindBlockHits(playerAABB, ghostBlockBoxes_, index + 1);
+			i = 0;
+		}
 	}
 
 }
 
 void Player::DrawUI() {
 
-#ifdef _DEBUG
+#ifdef USE_IMGUI
 
 	ImGui::Begin("Player State");
 
@@ -934,7 +1015,7 @@ void Player::DrawUI() {
 
 	ImGui::End();
 
-#endif // _DEBUG
+#endif // USE_IMGUI
 }
 
 void Player::OnCollisions() {
@@ -1056,10 +1137,6 @@ void Player::CheckCollisionWithSprings() {
 
 void Player::SetState(State newState) { currentState = newState; }
 
-void Player::ClearObstacleList() {
-	obstacleList_.clear(); // 当たり判定用の障害物リストをクリア
-}
-
 void Player::SetPosition(const Vector3& newPosition) {
 	position = newPosition;
 	worldTransform_.translation_ = position;
@@ -1082,7 +1159,7 @@ void Player::CheckCollisionWithGoal() {
 }
 
 void Player::CheckDamage() {
-	const float deltaTime = 1.0f / 60.0f;
+	const float deltaTime = GameTimer::GetInstance()->GetDeltaTime();
 
 	// 点滅処理の更新
 	if (isFlashing) {
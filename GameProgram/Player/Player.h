@@ -4,6 +4,7 @@
 #include "CameraController.h"
 #include "CannonEnemy.h"
 #include "Collision.h"
+#include "CollisionWorld.h"
 #include "GhostBlock.h"
 #include "Goal.h"
 #include "MyMath.h"
@@ -25,6 +26,8 @@ public:
 
 	void Init(Camera* camera);
 	void Update();
+	// デバッグ表示(描画1回につき1回。カメラの分も出す)
+	void UpdateImGui();
 	void Draw();
 
 	AABB GetAABB() { return playerAABB; }
@@ -43,8 +46,8 @@ public:
 		EnemyContral = anser;
 	}
 
-	void SetObstacleList(const std::vector<AABB>& obstacles);
-	void AddObstacle(const AABB& obstacle);
+	// ステージの当たり判定(シーンが所有)
+	void SetCollisionWorld(const CollisionWorld* world) { collisionWorld_ = world; }
 
 	void SetGhostEnemies(const std::vector<GhostEnemy*>& enemies);
 
@@ -71,9 +74,10 @@ public:
 	void SetSpringEnemies(const std::vector<SpringEnemy*>& springEnemies);
 	// ここに重複していた宣言を削除
 	void CheckCollisionWithSprings();
-	void SetBlocks(const std::vector<Block*> blocks) { blocks_ = blocks; }
+	// ブロックは動かないので、渡されたときに判定用の箱を並べておく
+	void SetBlocks(const std::vector<Block*> blocks);
 
-	void SetGhostBlocks(const std::vector<GhostBlock*> blocks) { ghostBlocks_ = blocks; }
+	void SetGhostBlocks(const std::vector<GhostBlock*> blocks);
 
 	void SetGoal(Goal* goal) { goal_ = goal; }
 	void CheckCollisionWithGoal();
@@ -88,7 +92,6 @@ public:
 
 	void CheckCollision();
 	void SetState(State newState);
-	void ClearObstacleList();
 	void CheckDamage();
 
 	void TakeDamage();
@@ -164,10 +167,18 @@ private:
 
 	Goal* goal_ = nullptr;
 
-	std::vector<AABB> obstacleList_;
+	const CollisionWorld* collisionWorld_ = nullptr;
+	std::vector<uint32_t> nearIndices_;
+	std::vector<AABB> nearObstacles_;
 	std::vector<SpringEnemy*> springEnemies_;
 	std::vector<Block*> blocks_;
 	std::vector<GhostBlock*> ghostBlocks_;
+	// ブロック判定の一括処理用(SetBlocks/SetGhostBlocksで作る)
+	AABBSoA blockBoxes_;
+	AABBSoA ghostBlockBoxes_;
+	std::vector<uint32_t> blockHits_;
+	// areaと重なるboxesのうち、インデックスがbegin以降のものをblockHits_に入れる
+	void FindBlockHits(const AABB& area, const AABBSoA& boxes, uint32_t begin);
 	std::vector<Door*> doors_;
 
 	// 点滅関連の追加変数
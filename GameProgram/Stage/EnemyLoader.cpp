@@ -1,8 +1,9 @@
 #include "EnemyLoader.h"
 #include <algorithm>
 #include "ImGuiManager.h"
+#include "TraceRecorder.h"
 #ifdef _DEBUG
-#include <windows.h>
+#include <Windows.h>
 #endif
 
 EnemyLoader::EnemyLoader() {}
@@ -111,10 +112,10 @@ bool EnemyLoader::ParseCSVLine(const std::string& line, EnemyData& data) {
 	return true;
 }
 
-void EnemyLoader::CreateEnemies(Player* player, const std::vector<std::vector<AABB>>& obstacles) {
-	// プレイヤーと障害物の参照を保存
+void EnemyLoader::CreateEnemies(Player* player, const CollisionWorld* collisionWorld) {
+	// プレイヤーと当たり判定の参照を保存
 	player_ = player;
-	obstacles_ = obstacles;
+	collisionWorld_ = collisionWorld;
 	
 	// 既存の敵をクリア
 	ClearResources();
@@ -129,10 +130,8 @@ void EnemyLoader::CreateEnemies(Player* player, const std::vector<std::vector<AA
 			ghost->SetTarget(player);
 			ghost->SetColor(data.colorType);
 
-			// 障害物リストを設定
-			for (const auto& obstacleList : obstacles) {
-				ghost->SetObstacleList(obstacleList);
-			}
+			// 当たり判定を設定
+			ghost->SetCollisionWorld(collisionWorld_);
 
 			ghostEnemies_.push_back(ghost);
 			break;
@@ -143,10 +142,8 @@ void EnemyLoader::CreateEnemies(Player* player, const std::vector<std::vector<AA
 			cannon->SetPosition(data.position);
 			cannon->SetPlayer(player);
 
-			// 障害物リストを設定
-			for (const auto& obstacleList : obstacles) {
-				cannon->SetObstacleList(obstacleList);
-			}
+			// 当たり判定を設定
+			cannon->SetCollisionWorld(collisionWorld_);
 
 			cannonEnemies_.push_back(cannon);
 			break;
@@ -157,10 +154,8 @@ void EnemyLoader::CreateEnemies(Player* player, const std::vector<std::vector<AA
 			spring->SetPosition(data.position);
 			spring->SetPlayer(player);
 
-			// 障害物リストを設定
-			for (const auto& obstacleList : obstacles) {
-				spring->SetObstacleList(obstacleList);
-			}
+			// 当たり判定を設定
+			spring->SetCollisionWorld(collisionWorld_);
 
 			springEnemies_.push_back(spring);
 			break;
@@ -180,6 +175,8 @@ void EnemyLoader::CreateEnemies(Player* player, const std::vector<std::vector<AA
 }
 
 void EnemyLoader::Update() {
+	TRACE_SCOPE("EnemyLoader::Update");
+
 	// 通常の敵の更新
 	for (auto* ghost : ghostEnemies_) {
 		ghost->Update();
@@ -265,7 +262,7 @@ bool EnemyLoader::SaveEnemyData(const std::string& csvPath) {
 }
 
 void EnemyLoader::UpdateImGui() {
-#ifdef _DEBUG
+#ifdef USE_IMGUI
 	bool isOpen = ImGui::Begin("Enemy Editor");
 	
 	if (isOpen) {
@@ -401,6 +398,17 @@ void EnemyLoader::UpdateImGui() {
 	
 	ImGui::End();
 #endif
+
+	// 敵ごとのデバッグ表示
+	for (auto* ghost : ghostEnemies_) {
+		ghost->UpdateImGui();
+	}
+	for (auto* cannon : cannonEnemies_) {
+		cannon->UpdateImGui();
+	}
+	for (auto* spring : springEnemies_) {
+		spring->UpdateImGui();
+	}
 }
 
 // 敵の追加メソッド
@@ -412,10 +420,8 @@ void EnemyLoader::AddGhostEnemy(const Vector3& position, ColorType color) {
 	if (player_) {
 		ghost->SetTarget(player_);
 	}
-	// 障害物リストを設定
-	for (const auto& obstacleList : obstacles_) {
-		ghost->SetObstacleList(obstacleList);
-	}
+	// 当たり判定を設定
+	ghost->SetCollisionWorld(collisionWorld_);
 	// フィールド境界を設定
 	ghost->SetFieldBoundaries({ -150.0f, -50.0f, -150.0f }, { 150.0f, 100.0f, 150.0f });
 	
@@ -434,10 +440,8 @@ void EnemyLoader::AddCannonEnemy(const Vector3& position) {
 	if (player_) {
 		cannon->SetPlayer(player_);
 	}
-	// 障害物リストを設定
-	for (const auto& obstacleList : obstacles_) {
-		cannon->SetObstacleList(obstacleList);
-	}
+	// 当たり判定を設定
+	cannon->SetCollisionWorld(collisionWorld_);
 	cannonEnemies_.push_back(cannon);
 }
 
@@ -448,10 +452,8 @@ void EnemyLoader::AddSpringEnemy(const Vector3& position) {
 	if (player_) {
 		spring->SetPlayer(player_);
 	}
-	// 障害物リストを設定
-	for (const auto& obstacleList : obstacles_) {
-		spring->SetObstacleList(obstacleList);
-	}
+	// 当たり判定を設定
+	spring->SetCollisionWorld(collisionWorld_);
 	springEnemies_.push_back(spring);
 }
 
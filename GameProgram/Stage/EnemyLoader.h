@@ -32,7 +32,7 @@ public:
 	bool LoadEnemyData(const std::string& csvPath);
 
 	// 読み込んだデータに基づいて敵オブジェクトを生成・初期化
-	void CreateEnemies(Player* player, const std::vector<std::vector<AABB>>& obstacles);
+	void CreateEnemies(Player* player, const CollisionWorld* collisionWorld);
 
 	// 敵の更新
 	void Update();
@@ -67,7 +67,7 @@ public:
 
 	// プレイヤー参照を保持
 	void SetPlayer(Player* player) { player_ = player; }
-	void SetObstacles(const std::vector<std::vector<AABB>>& obstacles) { obstacles_ = obstacles; }
+	void SetCollisionWorld(const CollisionWorld* collisionWorld) { collisionWorld_ = collisionWorld; }
 
 private:
 	// 読み込んだ敵データのリスト
@@ -90,5 +90,5 @@ private:
 
 	// プレイヤーと障害物の参照
 	Player* player_ = nullptr;
-	std::vector<std::vector<AABB>> obstacles_;
+	const CollisionWorld* collisionWorld_ = nullptr;
 };
\ No newline at end of file
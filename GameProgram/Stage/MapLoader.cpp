@@ -3,12 +3,13 @@
 #include <iostream>
 #include <cfloat>
 #include "ImGuiManager.h"
+#include "TraceRecorder.h"
 #include "math/Matrix4x4.h"
 #include "math/Vector3.h"
 #include "math/MyMath.h"
 #include "3d/Camera.h"
 #ifdef _DEBUG
-#include <windows.h>
+#include <Windows.h>
 #endif
 
 using namespace MyMath;
@@ -457,6 +458,8 @@ void MapLoader::SetupObjectReferences() {
 }
 
 void MapLoader::Update() {
+	TRACE_SCOPE("MapLoader::Update");
+
 	// すべての鍵を更新
 	for (auto* key : keys_) {
 		key->Update();
@@ -679,7 +682,7 @@ bool MapLoader::SaveMapData(const std::string& csvPath) {
 }
 
 void MapLoader::UpdateImGui() {
-#ifdef _DEBUG
+#ifdef USE_IMGUI
 	if (ImGui::Begin("Map Object Editor")) {
 		ImGui::Text("Current CSV: %s", currentCSVPath_.c_str());
 		
@@ -1173,6 +1176,17 @@ void MapLoader::UpdateImGui() {
 	ImGui::End();
 	}
 #endif
+
+	// オブジェクトごとのデバッグ表示
+	for (auto* key : keys_) {
+		key->UpdateImGui();
+	}
+	for (auto* door : doors_) {
+		door->UpdateImGui();
+	}
+	if (goal_) {
+		goal_->UpdateImGui();
+	}
 }
 
 // オブジェクトの追加メソッド
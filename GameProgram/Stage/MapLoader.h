@@ -3,7 +3,7 @@
 #include "Door.h"
 #include "Goal.h" 
 #include "MoveTile.h"
-#include "Key.h"
+#include "key.h"
 #include "Player.h"
 #include <fstream>
 #include <sstream>
@@ -0,0 +1,227 @@
+#include "StageCollisionCache.h"
+#include "MappedFile.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable_v<AABB>, "AABBはそのままファイルに書き出す");
+static_assert(sizeof(StageCollisionCache::Header) == 32, "ヘッダーのサイズが変わるとキャッシュが読めなくなる");
+
+bool StageCollisionCache::Load(const std::string& objFile, std::vector<AABB>& boxes) {
+	uint64_t objSize;
+	uint64_t objHash;
+	if (!GetSourceStamp(objFile, objSize, objHash)) {
+		return false;
+	}
+
+	MappedFile file;
+	if (!file.Open(GetCachePath(objFile))) {
+		return false;
+	}
+	if (file.GetSize() < sizeof(Header)) {
+		return false;
+	}
+
+	Header header;
+	std::memcpy(&header, file.GetData(), sizeof(Header));
+	if (header.magic != kMagic || header.version != kVersion) {
+		return false;
+	}
+	// OBJの中身が変わっていたら作り直す
+	if (header.objSize != objSize || header.objHash != objHash) {
+		return false;
+	}
+
+	size_t dataSize = static_cast<size_t>(header.boxCount) * sizeof(AABB);
+	if (file.GetSize() != sizeof(Header) + dataSize) {
+		return false;
+	}
+	const uint8_t* data = file.GetData() + sizeof(Header);
+	if (ComputeChecksum(data, dataSize) != header.checksum) {
+		return false;
+	}
+
+	boxes.resize(header.boxCount);
+	if (dataSize > 0) {
+		std::memcpy(boxes.data(), data, dataSize);
+	}
+	return true;
+}
+
+bool StageCollisionCache::Save(const std::string& objFile, const std::vector<AABB>& boxes) {
+	Header header{};
+	header.magic = kMagic;
+	header.version = kVersion;
+	if (!GetSourceStamp(objFile, header.objSize, header.objHash)) {
+		return false;
+	}
+
+	size_t dataSize = boxes.size() * sizeof(AABB);
+	header.boxCount = static_cast<uint32_t>(boxes.size());
+	header.checksum = ComputeChecksum(boxes.data(), dataSize);
+
+	std::string cachePath = GetCachePath(objFile);
+	std::ofstream file(cachePath, std::ios::binary | std::ios::trunc);
+	if (!file.is_open()) {
+		return false;
+	}
+	file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+	file.write(reinterpret_cast<const char*>(boxes.data()), dataSize);
+	file.close();
+
+	// 書き込みに失敗した半端なファイルは残さない
+	if (file.fail()) {
+		std::error_code ec;
+		std::filesystem::remove(cachePath, ec);
+		return false;
+	}
+	return true;
+}
+
+bool StageCollisionCache::LoadOrBuild(const std::string& objFile, std::vector<AABB>& boxes) {
+	if (Load(objFile, boxes)) {
+		return true;
+	}
+
+	// ステージデータの読み込み
+	std::ifstream file(objFile);
+	if (!file.is_open()) {
+		return false;
+	}
+
+	// 障害物を読み込んで次回用に保存
+	boxes.clear();
+	BuildFromObj(file, boxes);
+	Save(objFile, boxes);
+	return true;
+}
+
+void StageCollisionCache::BuildFromObj(std::istream& obj, std::vector<AABB>& boxes) {
+	std::string line;
+	uint32_t cornerNumber = 0;
+
+	Vector3 max;
+	Vector3 min;
+
+	// AABB stageAABB;
+	bool start = false;
+	bool reverse = false;
+
+	while (getline(obj, line)) {
+		std::istringstream line_stream(line);
+
+		std::string word;
+
+		getline(line_stream, word, ' ');
+
+		if (word.find("vn") == 0) {
+			break; //vを読み取ったら終了
+		}
+
+		if (word.find("v") == 0) {
+			cornerNumber++;
+		}
+		else {
+			continue;
+		}
+
+		if (cornerNumber > 0) {
+
+			getline(line_stream, word, ' ');
+			float x = (float)std::atof(word.c_str());
+
+			getline(line_stream, word, ' ');
+			float y = (float)std::atof(word.c_str());
+
+			getline(line_stream, word, ' ');
+			float z = (float)std::atof(word.c_str());
+
+			if (!start) {
+				max = { x, y, z };
+				min = { x, y, z };
+				start = true;
+			}
+			else {
+
+				// 前よりも大きいとき
+				if (max.x <= x) {
+					max.x = x;
+				}
+				// 前よりも小さいとき
+				if (min.x > x) {
+					min.x = x;
+				}
+
+				if (max.y <= y) {
+					max.y = y;
+				}
+
+				if (min.y > y) {
+					min.y = y;
+				}
+
+				if (max.z <= z) {
+					max.z = z;
+				}
+
+				if (min.z > z) {
+					min.z = z;
+				}
+			}
+		}
+
+		if (cornerNumber == 8) {
+			if (!reverse) {
+				boxes.push_back({ min, max }); // 結合した基盤となるobj
+			}
+			else {
+
+				float minX;
+				float maxX;
+				maxX = -(max.x);
+				minX = -(min.x);
+
+				min.x = maxX;
+				max.x = minX;
+				boxes.push_back({ min, max }); // それ以外のすべてobj
+			}
+
+			cornerNumber = 0;
+			start = false;
+			reverse = true;
+		}
+	}
+}
+
+std::string StageCollisionCache::GetCachePath(const std::string& objFile) {
+	return std::filesystem::path(objFile).replace_extension(".col").string();
+}
+
+bool StageCollisionCache::GetSourceStamp(const std::string& objFile, uint64_t& size, uint64_t& hash) {
+	MappedFile file;
+	if (!file.Open(objFile)) {
+		return false;
+	}
+	size = file.GetSize();
+
+	// FNV-1a 64bit
+	const uint8_t* bytes = file.GetData();
+	hash = 14695981039346656037ull;
+	for (size_t i = 0; i < file.GetSize(); ++i) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+	return true;
+}
+
+uint32_t StageCollisionCache::ComputeChecksum(const void* data, size_t size) {
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	uint32_t hash = 2166136261u;
+	for (size_t i = 0; i < size; ++i) {
+		hash ^= bytes[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
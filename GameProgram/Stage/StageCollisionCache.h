@@ -0,0 +1,47 @@
+#pragma once
+#include "AABB.h"
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+// ステージの当たり判定(AABB)をバイナリで保存・読み込みする
+// stageN.objの隣にstageN.colを置き、OBJの中身が変わったら作り直す
+// (更新時刻はチェックアウトやコピーで変わらないことがあるので、OBJのバイト列のハッシュで比べる)
+class StageCollisionCache {
+public:
+	// キャッシュファイルの先頭
+	struct Header {
+		uint32_t magic;        // 'SCOL'
+		uint32_t version;
+		uint64_t objSize;      // 元のOBJのサイズ
+		uint64_t objHash;      // 元のOBJのハッシュ(FNV-1a 64bit)
+		uint32_t boxCount;
+		uint32_t checksum;     // 箱データのハッシュ(FNV-1a)
+	};
+
+	static const uint32_t kMagic = 0x4C4F4353; // "SCOL"
+	// 形式かAABBの作り方を変えたら上げる
+	static const uint32_t kVersion = 2;
+
+	// objFileに対応するキャッシュを読み込む(無いか古ければfalse)
+	static bool Load(const std::string& objFile, std::vector<AABB>& boxes);
+
+	// objFileに対応するキャッシュを書き出す
+	static bool Save(const std::string& objFile, const std::vector<AABB>& boxes);
+
+	// キャッシュを読み込み、無いか古ければOBJから作って保存する(OBJが開けなければfalse)
+	static bool LoadOrBuild(const std::string& objFile, std::vector<AABB>& boxes);
+
+	// OBJの頂点を8個ずつAABBにする(最初の1個以外はX軸を反転する)
+	static void BuildFromObj(std::istream& obj, std::vector<AABB>& boxes);
+
+	// stageN.obj → stageN.col
+	static std::string GetCachePath(const std::string& objFile);
+
+private:
+	// OBJのサイズと中身のハッシュ(開けなければfalse)
+	static bool GetSourceStamp(const std::string& objFile, uint64_t& size, uint64_t& hash);
+
+	static uint32_t ComputeChecksum(const void* data, size_t size);
+};
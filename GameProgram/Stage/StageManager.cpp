@@ -1,4 +1,5 @@
 #include "StageManager.h"
+#include "GameTimer.h"
 #include "ImGuiManager.h"
 #include <algorithm>
 #include <fstream>
@@ -49,6 +50,8 @@ void StageManager::InitializeStage(int stageNumber) {
 	// ステージの地形をロード
 	LoadStage("Resources/stage/stage.obj");
 	UpdateStageAABB();
+	collisionWorld_.Build(std::move(allObstacles_));
+	allObstacles_.clear();
 
 	// プレイヤーの位置をリセット
 	ResetPlayerPosition(stageNumber);
@@ -65,9 +68,7 @@ void StageManager::InitializeStage(int stageNumber) {
 		for (int i = 0; i < 5; ++i) {
 			GhostEnemy* enemy = new GhostEnemy();
 			enemy->Init();
-			for (const auto& obstacles : allObstacles_) {
-				enemy->SetObstacleList(obstacles);
-			}
+			enemy->SetCollisionWorld(&collisionWorld_);
 			ghostEnemyList_.push_back(enemy);
 		}
 
@@ -87,9 +88,7 @@ void StageManager::InitializeStage(int stageNumber) {
 		for (int i = 0; i < 5; ++i) {
 			GhostEnemy* enemy = new GhostEnemy();
 			enemy->Init();
-			for (const auto& obstacles : allObstacles_) {
-				enemy->SetObstacleList(obstacles);
-			}
+			enemy->SetCollisionWorld(&collisionWorld_);
 			ghostEnemyList_.push_back(enemy);
 		}
 
@@ -112,17 +111,13 @@ void StageManager::InitializeStage(int stageNumber) {
 	}
 	cannonEnemy_ = new CannonEnemy();
 	cannonEnemy_->Init();
-	for (const auto& obstacles : allObstacles_) {
-		cannonEnemy_->SetObstacleList(obstacles);
-	}
+	cannonEnemy_->SetCollisionWorld(&collisionWorld_);
 	cannonEnemy_->SetPlayer(player_);
 
 	// プレイヤーの更新
 	if (player_) {
-		// 障害物リストを更新
-		for (const auto& obstacles : allObstacles_) {
-			player_->SetObstacleList(obstacles);
-		}
+		// 当たり判定を更新
+		player_->SetCollisionWorld(&collisionWorld_);
 		player_->SetGhostEnemies(ghostEnemyList_);
 		player_->SetCannon(cannonEnemy_);
 	}
@@ -178,7 +173,7 @@ void StageManager::TransitionToStage(int stageNumber) {
 void StageManager::Update() {
 	// ステージ遷移処理
 	if (isStageTransitioning_) {
-		transitionTimer_ += 1.0f / 60.0f; // 60FPSを想定
+		transitionTimer_ += GameTimer::GetInstance()->GetDeltaTime();
 
 		if (transitionTimer_ >= transitionDuration_) {
 			isStageTransitioning_ = false;
@@ -257,7 +252,7 @@ void StageManager::Draw() {
 	if (stageModel_) {
 		WorldTransform worldTransform;
 		worldTransform.Initialize();
-		stageModel_->Draw(worldTransform,"re");
+		stageModel_->Draw(worldTransform);
 	}
 
 	// 敵の描画
@@ -372,10 +367,7 @@ void StageManager::AddObstacle(const Vector3& min, const Vector3& max) {
 	obstacle.min = min;
 	obstacle.max = max;
 
-	if (allObstacles_.empty() || allObstacles_.back().size() >= 100) {
-		allObstacles_.emplace_back();
-	}
-	allObstacles_.back().push_back(obstacle);
+	allObstacles_.push_back(obstacle);
 }
 
 void StageManager::ResetPlayerPosition(int stageNumber) {
@@ -1,10 +1,11 @@
 #pragma once
 #include "Object3d.h"
 #include "AABB.h"
+#include "CollisionWorld.h"
 #include "CannonEnemy.h"
 #include "Door.h"
 #include "GhostEnemy.h"
-#include "Key.h"
+#include "key.h"
 #include "Player.h"
 #include "MoveTile.h"
 #include <sstream>
@@ -39,8 +40,8 @@ public:
 	// 敵リストへのアクセス
 	const std::vector<GhostEnemy*>& GetEnemyList() const { return ghostEnemyList_; }
 
-	// 障害物リストへのアクセス
-	const std::vector<std::vector<AABB>>& GetObstacleList() const { return allObstacles_; }
+	// 当たり判定へのアクセス
+	const CollisionWorld& GetCollisionWorld() const { return collisionWorld_; }
 
 	// キャノン敵へのアクセス
 	CannonEnemy* GetCannonEnemy() const { return cannonEnemy_; }
@@ -68,7 +69,8 @@ private:
 	Door* door_ = nullptr;
 
 	// ステージデータ
-	std::vector<std::vector<AABB>> allObstacles_;
+	std::vector<AABB> allObstacles_;
+	CollisionWorld collisionWorld_;
 	std::stringstream stageCommand_;
 
 	// 移動床
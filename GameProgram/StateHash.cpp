@@ -0,0 +1,74 @@
+#include "StateHash.h"
+#include "Player.h"
+#include "EnemyLoader.h"
+#include "MapLoader.h"
+#include <cstring>
+
+namespace {
+	// FNV-1a(floatはビットのまま混ぜるので、少しでもずれれば違う値になる)
+	class Hasher {
+	public:
+		void Add(const void* data, size_t size) {
+			const uint8_t* bytes = static_cast<const uint8_t*>(data);
+			for (size_t i = 0; i < size; ++i) {
+				hash_ ^= bytes[i];
+				hash_ *= 1099511628211ull;
+			}
+		}
+		void Add(const Vector3& value) { Add(&value, sizeof(Vector3)); }
+		void Add(uint32_t value) { Add(&value, sizeof(value)); }
+		void Add(bool value) { Add(static_cast<uint32_t>(value)); }
+		uint64_t Get() const { return hash_; }
+
+	private:
+		uint64_t hash_ = StateHash::kInitialHash;
+	};
+}
+
+uint64_t StateHash::Compute(Player* player, const EnemyLoader* enemyLoader, const MapLoader* mapLoader) {
+	Hasher hasher;
+
+	if (player) {
+		hasher.Add(player->GetWorldPosition());
+		hasher.Add(static_cast<uint32_t>(player->GetHp()));
+	}
+
+	if (enemyLoader) {
+		for (GhostEnemy* ghost : enemyLoader->GetGhostList()) {
+			hasher.Add(ghost->GetPosition());
+		}
+		for (CannonEnemy* cannon : enemyLoader->GetCannonEnemyList()) {
+			hasher.Add(cannon->GetPosition());
+		}
+		for (SpringEnemy* spring : enemyLoader->GetSpringEnemyList()) {
+			hasher.Add(spring->GetPosition());
+		}
+	}
+
+	if (mapLoader) {
+		for (Block* block : mapLoader->GetBlockList()) {
+			hasher.Add(block->IsActive());
+		}
+		for (GhostBlock* ghostBlock : mapLoader->GetGhostBlockList()) {
+			hasher.Add(ghostBlock->IsActive());
+		}
+		for (Key* key : mapLoader->GetKeys()) {
+			hasher.Add(key->IsKeyObtained());
+		}
+		for (Door* door : mapLoader->GetDoorList()) {
+			hasher.Add(door->IsDoorOpened());
+		}
+		if (mapLoader->GetGoal()) {
+			hasher.Add(mapLoader->GetGoal()->IsClear());
+		}
+	}
+
+	return hasher.Get();
+}
+
+uint64_t StateHash::Combine(uint64_t hash, uint64_t value) {
+	Hasher hasher;
+	hasher.Add(&hash, sizeof(hash));
+	hasher.Add(&value, sizeof(value));
+	return hasher.Get();
+}
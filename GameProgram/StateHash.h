@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+
+class Player;
+class EnemyLoader;
+class MapLoader;
+
+// ゲームの状態(プレイヤー、敵、ブロック、鍵、扉、ゴール)を64bitにまとめる
+// 記録した入力を再生したときに、記録したときと同じ値になるかを比べる
+namespace StateHash {
+	const uint64_t kInitialHash = 14695981039346656037ull; // FNV-1aの初期値
+
+	// 今のtickの状態のハッシュ
+	uint64_t Compute(Player* player, const EnemyLoader* enemyLoader, const MapLoader* mapLoader);
+
+	// これまでのtickのハッシュにvalueを混ぜる
+	uint64_t Combine(uint64_t hash, uint64_t value);
+}
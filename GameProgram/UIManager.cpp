@@ -1,4 +1,5 @@
 #include "UIManager.h"
+#include "GameTimer.h"
 #include <algorithm> // min/maxのために追加
 #include <TextureManager.h>
 #include "WinApp.h"
@@ -160,7 +161,7 @@ void UIManager::Update() {
 	DetectInputDevice();
 
 	// 入力検出タイマーの更新
-	inputDetectionTimer_ -= 1.0f / 60.0f;
+	inputDetectionTimer_ -= GameTimer::GetInstance()->GetDeltaTime();
 	if (inputDetectionTimer_ < 0.0f) {
 		inputDetectionTimer_ = 0.0f;
 	}